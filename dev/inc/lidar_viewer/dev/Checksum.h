@@ -0,0 +1,18 @@
+#ifndef LIDAR_VIEWER_CHECKSUM_H
+#define LIDAR_VIEWER_CHECKSUM_H
+
+#include <cstdint>
+#include <span>
+
+namespace lidar_viewer::dev
+{
+
+/// @brief XOR of all bytes, the checksum of lidar frames, computed 32 bytes at once if the cpu supports AVX2,
+/// 8 bytes at once otherwise
+/// @param data bytes to checksum
+/// @returns checksum, 0 for no data
+[[nodiscard]] uint8_t xorChecksum(std::span<const uint8_t> data) noexcept;
+
+} // namespace lidar_viewer::dev
+
+#endif //LIDAR_VIEWER_CHECKSUM_H
@@ -0,0 +1,122 @@
+#ifndef LIDAR_VIEWER_COMMANDCHANNEL_H
+#define LIDAR_VIEWER_COMMANDCHANNEL_H
+
+#include "lidar_viewer/dev/IoStream.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace lidar_viewer::dev
+{
+
+/// @brief sends requests to a lidar while it streams and matches the replies acknowledging them,
+/// several requests may await their replies at once. The lidar is assumed to reply with a frame whose payload starts
+/// with the type of the request, replies to requests of the same type arriving in the order the requests were sent.
+/// This layout is what the simulator sends, it was not verified against the firmware of a real lidar, so a request
+/// no reply was matched to is reported as sent but unconfirmed rather than failed. Whether replies match or not,
+/// the time from writing a request to the first frame received after it is measured as its effect latency
+class CommandChannel
+{
+public:
+    enum class Status : uint8_t
+    {
+        Acknowledged,
+        /// the request was written but no reply arrived in time, whether the lidar took it is not known
+        Unconfirmed,
+        /// the channel was destroyed before a reply arrived
+        Cancelled
+    };
+
+    struct Result
+    {
+        Status status{Status::Cancelled};
+        /// time from writing the request to receiving its reply, or to giving up on it
+        std::chrono::steady_clock::duration latency{};
+        /// time from writing the request to receiving the first frame after it, none if no frame arrived
+        std::optional<std::chrono::steady_clock::duration> effectLatency{};
+    };
+
+    struct Statistics
+    {
+        uint64_t sent{};
+        uint64_t acknowledged{};
+        uint64_t unconfirmed{};
+        /// replies no request in flight was waiting for
+        uint64_t unmatchedReplies{};
+        std::chrono::steady_clock::duration lastLatency{};
+        std::chrono::steady_clock::duration maxLatency{};
+        std::chrono::steady_clock::duration lastEffectLatency{};
+        std::chrono::steady_clock::duration maxEffectLatency{};
+    };
+
+    /// number of requests awaiting their replies at most
+    static constexpr std::size_t MAX_IN_FLIGHT = 8u;
+
+    /// @brief ctor
+    /// @param ioStream_ stream requests are written to
+    /// @param timeout_ time a request waits for its reply at most
+    CommandChannel(IoStream& ioStream_, std::chrono::milliseconds timeout_);
+
+    /// @brief dtor, cancels requests awaiting replies
+    ~CommandChannel() noexcept;
+
+    /// @brief writes a request without waiting for the replies to requests sent earlier
+    /// @param rawRequest raw request frame
+    /// @returns result of the request, ready once its reply and a frame after it arrived, or once it times out
+    /// @throws std::runtime_error if MAX_IN_FLIGHT requests await their replies
+    std::future<Result> send(std::span<const uint8_t> rawRequest);
+
+    /// @brief acknowledges the oldest request in flight of the type a reply starts with
+    /// @param rawFrame raw frame received
+    /// @returns true if the frame acknowledged a request
+    bool reply(std::span<const uint8_t> rawFrame);
+
+    /// @brief notes a measurement frame received, the effect of requests written before it, cheap while none are in
+    /// flight
+    void frameReceived();
+
+    /// @brief completes requests in flight for too long, cheap while none are in flight
+    void expire();
+
+    /// @returns number of requests awaiting their replies
+    [[nodiscard]] std::size_t inFlight() const noexcept;
+
+    [[nodiscard]] Statistics statistics() const;
+
+    CommandChannel(const CommandChannel&) = delete;
+    CommandChannel& operator = (const CommandChannel&) = delete;
+    CommandChannel(CommandChannel&&) = delete;
+    CommandChannel& operator = (CommandChannel&&) = delete;
+
+private:
+    struct Pending
+    {
+        uint8_t type;
+        std::chrono::steady_clock::time_point sentAt;
+        std::optional<std::chrono::steady_clock::time_point> acknowledgedAt;
+        std::optional<std::chrono::steady_clock::time_point> frameAt;
+        std::promise<Result> result;
+    };
+
+    /// @brief completes a request and removes it, mutex held
+    /// @param latency time from writing the request to its reply, or to giving up on it
+    void complete(std::size_t index, Status status, std::chrono::steady_clock::duration latency);
+
+    IoStream& ioStream;
+    const std::chrono::milliseconds timeout;
+    mutable std::mutex mutex;
+    /// requests in the order sent
+    std::vector<Pending> pending;
+    std::atomic<std::size_t> inFlightCount;
+    Statistics stats;
+};
+
+} // namespace lidar_viewer::dev
+
+#endif //LIDAR_VIEWER_COMMANDCHANNEL_H
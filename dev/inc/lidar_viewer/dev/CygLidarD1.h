@@ -2,17 +2,35 @@
 #define LIDAR_VIEWER_CYGLIDARD1_H
 
 #include "lidar_viewer/dev/IoStream.h"
+#include "lidar_viewer/dev/CommandChannel.h"
 #include "lidar_viewer/dev/CygLidarFrame.h"
+#include "lidar_viewer/dev/FrameParser.h"
+#include "lidar_viewer/dev/FrameBroadcast.h"
+#include "lidar_viewer/dev/FramePool.h"
+#include "lidar_viewer/dev/FrameQueue.h"
+#include "lidar_viewer/dev/DepthValidity.h"
+#include "lidar_viewer/dev/DepthUnpacking.h"
+#include "lidar_viewer/dev/CygLidarD1Fwd.h"
 
 #include <atomic>
 #include <array>
+#include <bit>
 #include <chrono>
+#include <condition_variable>
 #include <cstdint>
+#include <cstring>
+#include <functional>
 #include <future>
+#include <memory>
 #include <mutex>
+#include <span>
 #include <sstream>
 #include <string>
 #include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace lidar_viewer::dev
 {
@@ -20,7 +38,8 @@ namespace lidar_viewer::dev
 using Req2 = lidar_viewer::dev::Frame<2u>;
 using Req3 = lidar_viewer::dev::Frame<3u>;
 
-class CygLidarD1
+/// @brief commands and types of the CygLidar protocol, the same for every sensor speaking it
+class CygLidarBase
 {
 public:
 
@@ -86,14 +105,155 @@ public:
         uint8_t sensitivity;
     };
 
-    static constexpr auto FRAME_SIZE_3D = static_cast<unsigned int>( 9600.f * 1.5f ) + 1u;
-    static constexpr auto FRAME_SIZE_2D = 322u + 1u;
+    /// sequence number and capture time of a received frame, shared by the point cloud parsed from it
+    struct FrameStamp
+    {
+        /// number of frames of the same kind received so far, dropped ones included, 0 until the first one arrives
+        uint64_t sequence{0u};
+        /// time the frame was received completely
+        std::chrono::steady_clock::time_point captureTime{};
+    };
+
+    /// received frame or point cloud along with its stamp
+    template <typename T>
+    struct Stamped
+            : T
+    {
+        FrameStamp stamp{};
+    };
+
+    /// counters of the frames received in one stream, told apart by their length
+    struct DemuxStatistics
+    {
+        uint64_t frames3d{};
+        uint64_t frames2d{};
+        /// valid frames of neither kind, responses to requests
+        uint64_t framesIgnored{};
+    };
+
+    /// counters of corrupted frames dropped by readAndParse3dFrame and readAndParse2dFrame,
+    /// readAndParse and feed count them in parserStatistics
+    struct ReadStatistics
+    {
+        /// frames with a checksum mismatch
+        uint64_t checksumErrors{};
+        /// frames with a length field other than the size of frames of the mode read
+        uint64_t lengthErrors{};
+    };
+
+    /// number of buffers of every kind, the published one, the one being filled and those held by consumers,
+    /// queued ones included
+    static constexpr std::size_t FRAME_POOL_SIZE = 16u;
+
+    /// time a request sent while streaming waits for its reply at most
+    static constexpr std::chrono::milliseconds COMMAND_TIMEOUT{500};
+
+    /// number of frames or point clouds published last a subscriber of a broadcast may catch up on
+    static constexpr std::size_t BROADCAST_DEPTH = 4u;
+
+    /// largest capacity of a point cloud queue not exhausting a pool, leaving room for the broadcast point clouds,
+    /// the one being filled and two held by consumers, a power of two since queues round their capacity up to one
+    static constexpr std::size_t MAX_QUEUE_DEPTH = std::bit_floor(FRAME_POOL_SIZE - BROADCAST_DEPTH - 3u);
+
+    template <typename T>
+    using Pool = FramePool<Stamped<T>, FRAME_POOL_SIZE>;
+
+    template <typename T>
+    using Broadcast = FrameBroadcast<Stamped<T>, FRAME_POOL_SIZE, BROADCAST_DEPTH>;
+
+    /// ctor
+    /// @param ioStream i/o stream representing lidar
+    explicit CygLidarBase(IoStream& ioStream);
+
+    ///  prints device info, firmware / hardware revision
+    void printDeviceInfo();
+
+    /// @brief configures device according to definition of struct Config, replies are matched by feed and readAndParse
+    /// @param cfg configuration
+    /// @returns results of the requests in the order sent, the baud rate request first
+    std::vector<std::future<CommandChannel::Result>> configure(const Config cfg);
+
+    /// sends a measurements receival start command according to mode
+    /// @param mode take a look into Mode definition
+    void run(Mode mode = Mode::Mode2D);
+
+    /// stop measurement receival command
+    void stop();
+
+    /// @brief changes the light pulse duration while streaming, requests are not held up by replies to earlier ones,
+    /// replies are matched by feed and readAndParse
+    /// @param pulseDuration pulse mode and duration
+    /// @returns result of the request, ready once the lidar acknowledges it and a frame follows, or once COMMAND_TIMEOUT
+    /// passes leaving it acknowledged without a frame or unconfirmed
+    std::future<CommandChannel::Result> setPulseDuration(PulseDuration pulseDuration);
+
+    /// @brief changes the frequency channel while streaming
+    /// @param frequencyCh frequency channel
+    /// @returns result of the request
+    std::future<CommandChannel::Result> setFrequencyChannel(FrequencyChannel frequencyCh);
+
+    /// @brief changes the sensitivity while streaming
+    /// @param sensitivity sensitivity
+    /// @returns result of the request
+    std::future<CommandChannel::Result> setSensitivity(uint8_t sensitivity);
+
+    /// @brief changes pulse duration, frequency channel and sensitivity while streaming, the baud rate is kept
+    /// @param cfg configuration
+    /// @returns results of the requests in the order sent
+    std::vector<std::future<CommandChannel::Result>> reconfigure(const Config& cfg);
+
+    /// @returns counters and latencies of the requests sent while streaming
+    [[nodiscard]] CommandChannel::Statistics commandStatistics() const;
+
+    CygLidarBase(const CygLidarBase&) = delete;
+    CygLidarBase& operator = (const CygLidarBase&) = delete;
+    CygLidarBase(CygLidarBase&&) = delete;
+    CygLidarBase& operator = (CygLidarBase&&) = delete;
+
+    /// dtor, disables communication with lidar
+    ~CygLidarBase() noexcept;
+
+protected:
+
+    /// @returns length field of a raw frame, the size of its payload
+    static uint16_t payloadLength(std::span<const uint8_t> rawFrame) noexcept;
+
+    IoStream& ioStream;
+    /// requests sent while streaming along with their replies
+    CommandChannel commands;
+};
+
+/// @brief CygLidar protocol device, frames, point clouds and their pools sized after the sensor at compile time
+/// @tparam SensorType SensorDescriptor of the device
+template <typename SensorType>
+class BasicCygLidar
+        : public CygLidarBase
+{
+public:
+    using Sensor = SensorType;
+
+    static_assert(Sensor::BITS_PER_DEPTH_3D == 12u, "3D depths are unpacked from 12 bits");
+    static_assert(Sensor::FRAME_SIZE_3D <= UINT16_MAX && Sensor::FRAME_SIZE_2D <= UINT16_MAX,
+                  "length field of a frame is 16 bit");
+
+    static constexpr auto FRAME_SIZE_3D = static_cast<unsigned int>(Sensor::FRAME_SIZE_3D);
+    static constexpr auto FRAME_SIZE_2D = static_cast<unsigned int>(Sensor::FRAME_SIZE_2D);
 
     using Frame3D = Frame < FRAME_SIZE_3D >;
     using Frame2D = Frame < FRAME_SIZE_2D >;
 
-    using PointCloud3D = std::array<uint16_t , 160u * 60u>;
-    using PointCloud2D = std::array<uint16_t , 160u>;
+    using PointCloud3D = std::array<uint16_t , Sensor::DEPTHS_3D>;
+    using PointCloud2D = std::array<uint16_t , Sensor::DEPTHS_2D>;
+
+    /// depths of a 3D point cloud marked valid, nearer ones are noise, farther ones are too dim to be trusted
+    static constexpr std::pair<uint16_t, uint16_t> DEPTH_RANGE_3D{51u, 3000u};
+
+    /// 3D point cloud along with the validity of its depths, classified once when parsed
+    struct ClassifiedPointCloud3D
+            : PointCloud3D
+    {
+        DepthValidity<std::tuple_size_v<PointCloud3D>> validity{};
+    };
 
     /// accessor function for 3d point cloud
     using PointCloud3DAccessorFunction = std::function<void( const PointCloud3D&)>;
@@ -115,28 +275,29 @@ public:
     /// modifier function for 3d point cloud
     using PointCloud2DModifierFunction = std::function<void( PointCloud2D& )>;
 
-    /// ctor
-    /// @param ioStream i/o stream representing lidar
-    explicit CygLidarD1(IoStream& ioStream);
-
-    ///  prints device info, firmware / hardware revision
-    void printDeviceInfo();
+    /// handles sharing a received frame or point cloud, valid for as long as they are held
+    using Frame3DHandle = typename Pool<Frame3D>::ConstHandle;
+    using Frame2DHandle = typename Pool<Frame2D>::ConstHandle;
+    using PointCloud3DHandle = typename Pool<ClassifiedPointCloud3D>::ConstHandle;
+    using PointCloud2DHandle = typename Pool<PointCloud2D>::ConstHandle;
 
-    /// configures device according to definition of struct Config
-    void configure(const Config cfg);
+    /// queues of every parsed point cloud, the lidar is their single producer
+    using PointCloud3DQueue = FrameQueue<PointCloud3DHandle>;
+    using PointCloud2DQueue = FrameQueue<PointCloud2DHandle>;
 
-    /// sends a measurements receival start command according to mode
-    /// @param mode take a look into Mode definition
-    void run(Mode mode = Mode::Mode2D);
-
-    /// stop measurement receival command
-    void stop();
+    /// broadcasts of every received frame and point cloud, subscribers advance on their own
+    using Frame3DBroadcast = Broadcast<Frame3D>;
+    using Frame2DBroadcast = Broadcast<Frame2D>;
+    using PointCloud3DBroadcast = Broadcast<ClassifiedPointCloud3D>;
+    using PointCloud2DBroadcast = Broadcast<PointCloud2D>;
 
-    const std::array<uint16_t , 160u * 60u>* get3dFrame() const;
+    /// ctor
+    /// @param ioStream i/o stream representing lidar
+    explicit BasicCygLidar(IoStream& ioStream);
 
     static constexpr std::pair<unsigned int, unsigned int> get3dFrameWindow() noexcept
     {
-        return { 160u, 60u };
+        return Sensor::window3d();
     }
 
     /// uses the 3D point cloud without modifying it, atomic access
@@ -156,45 +317,135 @@ public:
     template <typename ... Args>
     void use3dPointCloudWithArgs(PointCloud3DAccessorFunctionWithArgs<Args&...> accessor3d, Args&... args) const
     {
-        std::lock_guard lGuard{rwMutex};
         if (!accessor3d)
         {
             return;
         }
-        accessor3d(pointcloud3d, args...);
+        const auto pointCloud = latest3dPointCloud();
+        accessor3d(*pointCloud, args...);
     }
 
     /// uses the 2D point cloud without modifying it, atomic access
     /// @param accessor2d function to access the 2d structure
     void use2dPointCloud(PointCloud2DAccessorFunction&& accessor2d) const;
 
+    /// @returns handle of the latest 3D frame, the frame is not modified while held
+    Frame3DHandle latest3dFrame() const;
+
+    /// @returns handle of the latest 2D frame, the frame is not modified while held
+    Frame2DHandle latest2dFrame() const;
+
+    /// @returns handle of the latest 3D point cloud, the point cloud is not modified while held
+    PointCloud3DHandle latest3dPointCloud() const;
+
+    /// @returns handle of the latest 2D point cloud, the point cloud is not modified while held
+    PointCloud2DHandle latest2dPointCloud() const;
+
+    /// @brief waits for a 3D frame newer than the one seen last
+    /// @param sequence sequence number of the frame seen last, 0 if none
+    /// @param timeout longest time to wait, zero only checks
+    /// @returns handle of the latest 3D frame if it is newer, empty handle if none arrived in time
+    Frame3DHandle waitFor3dFrame(uint64_t sequence, std::chrono::milliseconds timeout) const;
+
+    /// @brief waits for a 2D frame newer than the one seen last
+    /// @param sequence sequence number of the frame seen last, 0 if none
+    /// @param timeout longest time to wait, zero only checks
+    /// @returns handle of the latest 2D frame if it is newer, empty handle if none arrived in time
+    Frame2DHandle waitFor2dFrame(uint64_t sequence, std::chrono::milliseconds timeout) const;
+
+    /// @brief waits for a 3D point cloud newer than the one seen last
+    /// @param sequence sequence number of the point cloud seen last, 0 if none
+    /// @param timeout longest time to wait, zero only checks
+    /// @returns handle of the latest 3D point cloud if it is newer, empty handle if none arrived in time
+    PointCloud3DHandle waitFor3dPointCloud(uint64_t sequence, std::chrono::milliseconds timeout) const;
+
+    /// @brief waits for a 2D point cloud newer than the one seen last
+    /// @param sequence sequence number of the point cloud seen last, 0 if none
+    /// @param timeout longest time to wait, zero only checks
+    /// @returns handle of the latest 2D point cloud if it is newer, empty handle if none arrived in time
+    PointCloud2DHandle waitFor2dPointCloud(uint64_t sequence, std::chrono::milliseconds timeout) const;
+
+    /// @returns number of frames dropped since consumers held every buffer of a pool
+    uint64_t framesDropped() const noexcept;
+
     void readAndParse3dFrame();
     void readAndParse2dFrame();
 
+    /// @brief reads whatever the stream has available and parses all complete frames found in it,
+    /// resynchronizes on corrupted data, frames of any mode are accepted
+    void readAndParse();
+
+    /// @brief parses received bytes, partial frames are completed by following calls
+    /// @param data received bytes
+    void feed(std::span<const uint8_t> data);
+
+    /// @returns counters of the stream parser
+    FrameParser::Statistics parserStatistics() const;
+
+    /// @returns counters of frames received by readAndParse or feed, in any mode
+    DemuxStatistics demuxStatistics() const noexcept;
+
+    /// @returns counters of corrupted frames dropped by readAndParse3dFrame and readAndParse2dFrame
+    ReadStatistics readStatistics() const noexcept;
+
     bool failedToRead() const;
 
-    CygLidarD1(const CygLidarD1&) = delete;
-    CygLidarD1& operator = (const CygLidarD1&) = delete;
-    CygLidarD1(CygLidarD1&&) = delete;
-    CygLidarD1& operator = (CygLidarD1&&) = delete;
+    /// @returns broadcast of every 3D frame received, a subscriber lagging behind does not hold up reading
+    const Frame3DBroadcast& frame3dBroadcast() const noexcept;
 
-    /// dtor, disables communication with lidar
-    ~CygLidarD1() noexcept;
+    /// @returns broadcast of every 2D frame received
+    const Frame2DBroadcast& frame2dBroadcast() const noexcept;
+
+    /// @returns broadcast of every 3D point cloud parsed
+    const PointCloud3DBroadcast& pointCloud3dBroadcast() const noexcept;
+
+    /// @returns broadcast of every 2D point cloud parsed
+    const PointCloud2DBroadcast& pointCloud2dBroadcast() const noexcept;
+
+    /// @brief pushes every 3D point cloud parsed into a queue besides publishing it as the latest one,
+    /// a queue blocking on overflow blocks reading, a queue deeper than MAX_QUEUE_DEPTH makes frames be dropped
+    /// once it holds every buffer
+    /// @param queue queue to push into, nullptr stops pushing, to be set while no frames are read
+    void queue3dPointClouds(PointCloud3DQueue* queue) noexcept;
+
+    /// @brief pushes every 2D point cloud parsed into a queue besides publishing it as the latest one
+    /// @param queue queue to push into, nullptr stops pushing, to be set while no frames are read
+    void queue2dPointClouds(PointCloud2DQueue* queue) noexcept;
 
 private:
 
+    /// @brief reads a frame, parses it and publishes both, a frame arriving while consumers hold every buffer
+    /// of a pool is read into discardedFrame and dropped, its sequence number skipped the way feed skips it
     template < typename Frame, typename ParsingFunction, typename TargetPointCloud>
-    void readAndParseFrame( Frame& returnedFrame, ParsingFunction&& parsingFunction, TargetPointCloud& targetPointCloud)
+    void readAndParseFrame( Pool<Frame>& framePool, ParsingFunction&& parsingFunction, Pool<TargetPointCloud>& pointCloudPool,
+                            typename Pool<Frame>::Latest& publishedFrame,
+                            typename Pool<TargetPointCloud>::Latest& publishedPointCloud,
+                            std::atomic<uint64_t>& sequence, Frame& discardedFrame)
     {
         try
         {
-            const auto status = read(ioStream, returnedFrame);
-            if(status == Status::BAD)
+            auto returnedFrame = framePool.acquire();
+            auto targetPointCloud = pointCloudPool.acquire();
+            if(!returnedFrame || !targetPointCloud)
+            {
+                // read anyway, waiting on the stream rather than spinning, the stream stays in step with the lidar
+                const auto status = read(ioStream, discardedFrame);
+                if(status != Status::BAD && frameValid({discardedFrame.raw(), discardedFrame.rawSize()},
+                                                       discardedFrame.size()))
+                {
+                    ++sequence;
+                    ++droppedFrames;
+                }
+                return ;
+            }
+            const auto status = read(ioStream, *returnedFrame);
+            if(status == Status::BAD || !frameValid({returnedFrame->raw(), returnedFrame->rawSize()}, returnedFrame->size()))
             {
                 return ;
             }
-            const auto returnedPayload = returnedFrame.payload();
-            parsingFunction(targetPointCloud, returnedPayload);
+            const auto returnedPayload = returnedFrame->payload();
+            parsingFunction(static_cast<TargetPointCloud&>(*targetPointCloud), returnedPayload);
+            publish(std::move(returnedFrame), std::move(targetPointCloud), publishedFrame, publishedPointCloud, ++sequence);
         }
         catch (std::exception const & e)
         {
@@ -204,15 +455,451 @@ private:
         }
     }
 
-    IoStream& ioStream;
-    Frame < FRAME_SIZE_3D > frame3D;
-    Frame < FRAME_SIZE_2D > frame2D;
-    PointCloud3D pointcloud3d;
-    PointCloud2D pointcloud2d;
+    /// @brief unpacks 12 bit depths of a 3D frame, two depths in three bytes, first payload byte is the payload header,
+    /// classifies them if the point cloud keeps their validity
+    template <typename PointCloud, typename Payload>
+    static void parse3dPayload(PointCloud& pointCloud, const Payload& returnedPayload);
+
+    /// @brief unpacks depths of a 2D frame, two bytes per depth, first payload byte is the payload header,
+    /// error codes are kept whole, so they lie outside of the 12 bit depths
+    template <typename PointCloud, typename Payload>
+    static void parse2dPayload(PointCloud& pointCloud, const Payload& returnedPayload);
+
+    /// @brief checks length field and checksum of a frame read, counts corrupted ones
+    /// @returns true if the frame may be parsed
+    bool frameValid(std::span<const uint8_t> rawFrame, std::size_t payloadSize) noexcept;
+
+    /// @brief copies a validated raw frame into a pooled frame, parses it into a pooled point cloud and publishes both
+    template <typename Frame, typename TargetPointCloud, typename ParsingFunction>
+    void receiveFrame(std::span<const uint8_t> rawFrame, Pool<Frame>& framePool, Pool<TargetPointCloud>& pointCloudPool,
+                      typename Pool<Frame>::Latest& publishedFrame,
+                      typename Pool<TargetPointCloud>::Latest& publishedPointCloud,
+                      std::atomic<uint64_t>& sequence, ParsingFunction&& parsingFunction);
+
+    /// @brief stamps a frame and the point cloud parsed from it and makes them the latest ones,
+    /// waits only for consumers checking for a new frame
+    template < typename FrameHandle, typename PointCloudHandle, typename PublishedFrame, typename PublishedPointCloud>
+    void publish( FrameHandle&& frame, PointCloudHandle&& pointCloud,
+                  PublishedFrame& publishedFrame, PublishedPointCloud& publishedPointCloud, uint64_t sequence)
+    {
+        const FrameStamp stamp{sequence, std::chrono::steady_clock::now()};
+        frame->stamp = stamp;
+        pointCloud->stamp = stamp;
+        auto* queue = queueOf(publishedPointCloud);
+        auto queued = queue ? pointCloud : PointCloudHandle{};
+        broadcastOf<std::remove_cvref_t<decltype(*frame)>>().publish(std::remove_cvref_t<FrameHandle>{frame});
+        broadcastOf<std::remove_cvref_t<decltype(*pointCloud)>>().publish(
+                std::remove_cvref_t<PointCloudHandle>{pointCloud});
+        publishedFrame.publish(std::move(frame));
+        publishedPointCloud.publish(std::move(pointCloud));
+        {
+            std::lock_guard lGuard{waitMutex};
+        }
+        frameArrived.notify_all();
+        if(queue)
+        {
+            queue->push(typename std::remove_pointer_t<decltype(queue)>::value_type{std::move(queued)});
+        }
+    }
+
+    /// @returns broadcast of buffers of a type
+    template <typename StampedType>
+    FrameBroadcast<StampedType, FRAME_POOL_SIZE, BROADCAST_DEPTH>& broadcastOf() noexcept
+    {
+        return std::get<FrameBroadcast<StampedType, FRAME_POOL_SIZE, BROADCAST_DEPTH>>(broadcasts);
+    }
+
+    PointCloud3DQueue* queueOf(const typename Pool<ClassifiedPointCloud3D>::Latest&) const noexcept
+    {
+        return pointCloud3dQueue.load(std::memory_order_relaxed);
+    }
+
+    PointCloud2DQueue* queueOf(const typename Pool<PointCloud2D>::Latest&) const noexcept
+    {
+        return pointCloud2dQueue.load(std::memory_order_relaxed);
+    }
+
+    /// @returns handle of the latest buffer if it is newer than sequence, empty handle if none was published in time
+    template <typename T>
+    typename Pool<T>::ConstHandle waitForNewer(const typename Pool<T>::Latest& latest, uint64_t sequence,
+                                              std::chrono::milliseconds timeout) const
+    {
+        auto handle = latest.load();
+        if(handle->stamp.sequence > sequence)
+        {
+            return handle;
+        }
+        std::unique_lock lock{waitMutex};
+        const auto arrived = frameArrived.wait_for(lock, timeout, [&latest, &handle, sequence]()
+        {
+            handle = latest.load();
+            return handle->stamp.sequence > sequence;
+        });
+        return arrived ? handle : typename Pool<T>::ConstHandle{};
+    }
+
+    /// size of a chunk read from the stream at once
+    static constexpr std::size_t RX_CHUNK_SIZE = 16u * 1024u;
+
+    FrameParser parser;
+    std::array<uint8_t, RX_CHUNK_SIZE> rxChunk;
+    Pool<Frame3D> frame3DPool;
+    Pool<Frame2D> frame2DPool;
+    Pool<ClassifiedPointCloud3D> pointcloud3dPool;
+    Pool<PointCloud2D> pointcloud2dPool;
+    /// latest frames and point clouds, published without locking
+    typename Pool<Frame3D>::Latest frame3D;
+    typename Pool<Frame2D>::Latest frame2D;
+    typename Pool<ClassifiedPointCloud3D>::Latest pointcloud3d;
+    typename Pool<PointCloud2D>::Latest pointcloud2d;
+    /// every frame and point cloud, published along with the latest ones
+    std::tuple<Frame3DBroadcast, Frame2DBroadcast, PointCloud3DBroadcast, PointCloud2DBroadcast> broadcasts;
+    /// frames read while every buffer of a pool is held, to be dropped
+    std::unique_ptr<Frame3D> discarded3D;
+    std::unique_ptr<Frame2D> discarded2D;
+    /// sequence numbers of the frames received last
+    std::atomic<uint64_t> sequence3d;
+    std::atomic<uint64_t> sequence2d;
+    std::atomic<uint64_t> droppedFrames;
+    std::atomic<uint64_t> ignoredFrames;
+    std::atomic<uint64_t> checksumErrors;
+    std::atomic<uint64_t> lengthErrors;
     std::atomic<bool> failureInRead;
+    std::atomic<PointCloud3DQueue*> pointCloud3dQueue;
+    std::atomic<PointCloud2DQueue*> pointCloud2dQueue;
+    /// guards the stream parser
     mutable std::mutex rwMutex;
-    mutable std::mutex pcMutex;
+    /// signals consumers waiting for a new frame
+    mutable std::mutex waitMutex;
+    mutable std::condition_variable frameArrived;
 };
 
+template <typename SensorType>
+BasicCygLidar<SensorType>::BasicCygLidar(IoStream& _ioStream)
+: CygLidarBase{_ioStream}
+, parser{FRAME_SIZE_3D}
+, rxChunk{}
+, frame3DPool{}
+, frame2DPool{}
+, pointcloud3dPool{}
+, pointcloud2dPool{}
+, frame3D{frame3DPool}
+, frame2D{frame2DPool}
+, pointcloud3d{pointcloud3dPool}
+, pointcloud2d{pointcloud2dPool}
+, broadcasts{frame3DPool, frame2DPool, pointcloud3dPool, pointcloud2dPool}
+, discarded3D{std::make_unique<Frame3D>()}
+, discarded2D{std::make_unique<Frame2D>()}
+, sequence3d{0u}
+, sequence2d{0u}
+, droppedFrames{0u}
+, ignoredFrames{0u}
+, checksumErrors{0u}
+, lengthErrors{0u}
+, failureInRead{false}
+, pointCloud3dQueue{nullptr}
+, pointCloud2dQueue{nullptr}
+{
+    // zeroed frames until the first ones arrive
+    publish(frame3DPool.acquire(), pointcloud3dPool.acquire(), frame3D, pointcloud3d, 0u);
+    publish(frame2DPool.acquire(), pointcloud2dPool.acquire(), frame2D, pointcloud2d, 0u);
+}
+
+template <typename SensorType>
+template <typename PointCloud, typename Payload>
+void BasicCygLidar<SensorType>::parse3dPayload(PointCloud& pointCloud, const Payload& returnedPayload)
+{
+    auto& depths = static_cast<PointCloud3D&>(pointCloud);
+    unpack3dDepths(std::span{*returnedPayload}.subspan(1u), depths);
+    if constexpr (requires { pointCloud.validity; })
+    {
+        pointCloud.validity.counts = classify3dDepths(depths, DEPTH_RANGE_3D.first, DEPTH_RANGE_3D.second,
+                                                      pointCloud.validity.mask);
+    }
+}
+
+template <typename SensorType>
+template <typename PointCloud, typename Payload>
+void BasicCygLidar<SensorType>::parse2dPayload(PointCloud& pointCloud, const Payload& returnedPayload)
+{
+    const auto packed = std::span{*returnedPayload}.subspan(1u);
+    unpack2dDepths(packed, pointCloud);
+    restore2dErrorCodes(packed, pointCloud);
+}
+
+template <typename SensorType>
+void BasicCygLidar<SensorType>::readAndParse3dFrame()
+{
+    auto parsingFunction = [](auto& pointCloud, const auto& returnedPayload )
+    {
+        parse3dPayload(pointCloud, returnedPayload);
+    };
+    readAndParseFrame(frame3DPool, parsingFunction, pointcloud3dPool, frame3D, pointcloud3d, sequence3d,
+                      *discarded3D);
+}
+
+template <typename SensorType>
+void BasicCygLidar<SensorType>::readAndParse2dFrame()
+{
+    auto parsingFunction = [](auto& pointCloud, const auto& returnedPayload )
+    {
+        parse2dPayload(pointCloud, returnedPayload);
+    };
+    readAndParseFrame( frame2DPool , parsingFunction, pointcloud2dPool, frame2D, pointcloud2d, sequence2d,
+                       *discarded2D);
+}
+
+template <typename SensorType>
+void BasicCygLidar<SensorType>::readAndParse()
+{
+    using namespace std::chrono_literals;
+    using namespace std::string_literals;
+    try
+    {
+        const auto readBytes = ioStream.readSome(rxChunk.data(), static_cast<unsigned int>(rxChunk.size()), 130ms);
+        feed({rxChunk.data(), readBytes});
+    }
+    catch (std::exception const & e)
+    {
+        failureInRead = true;
+        throw std::runtime_error{"Exception in read and parse : \n"s + e.what()};
+    }
+}
+
+template <typename SensorType>
+template <typename Frame, typename TargetPointCloud, typename ParsingFunction>
+void BasicCygLidar<SensorType>::receiveFrame(std::span<const uint8_t> rawFrame, Pool<Frame>& framePool,
+                                             Pool<TargetPointCloud>& pointCloudPool,
+                                             typename Pool<Frame>::Latest& publishedFrame,
+                                             typename Pool<TargetPointCloud>::Latest& publishedPointCloud,
+                                             std::atomic<uint64_t>& sequence, ParsingFunction&& parsingFunction)
+{
+    const auto frameSequence = ++sequence;
+    auto frame = framePool.acquire();
+    auto pointCloud = pointCloudPool.acquire();
+    if(!frame || !pointCloud)
+    {
+        ++droppedFrames;
+        return ;
+    }
+    std::memcpy(const_cast<uint8_t*>(frame->raw()), rawFrame.data(), rawFrame.size());
+    parsingFunction(static_cast<TargetPointCloud&>(*pointCloud), frame->payload());
+    publish(std::move(frame), std::move(pointCloud), publishedFrame, publishedPointCloud, frameSequence);
+}
+
+template <typename SensorType>
+void BasicCygLidar<SensorType>::feed(std::span<const uint8_t> data)
+{
+    std::lock_guard lGuard{rwMutex};
+    parser.feed(data, [this](std::span<const uint8_t> rawFrame)
+    {
+        // frames of both modes come in one stream, the parser validated the length field they are told apart by
+        switch(payloadLength(rawFrame))
+        {
+            case FRAME_SIZE_3D:
+                receiveFrame(rawFrame, frame3DPool, pointcloud3dPool, frame3D, pointcloud3d, sequence3d,
+                             [](auto& pointCloud, const auto& payload){ parse3dPayload(pointCloud, payload); });
+                commands.frameReceived();
+                break;
+            case FRAME_SIZE_2D:
+                receiveFrame(rawFrame, frame2DPool, pointcloud2dPool, frame2D, pointcloud2d, sequence2d,
+                             [](auto& pointCloud, const auto& payload){ parse2dPayload(pointCloud, payload); });
+                commands.frameReceived();
+                break;
+            default:
+                // a reply to a request sent while streaming, otherwise a response nobody waits for
+                if(!commands.reply(rawFrame))
+                {
+                    ++ignoredFrames;
+                }
+                break;
+        }
+    });
+    commands.expire();
+}
+
+template <typename SensorType>
+bool BasicCygLidar<SensorType>::frameValid(std::span<const uint8_t> rawFrame, std::size_t payloadSize) noexcept
+{
+    if(payloadLength(rawFrame) != payloadSize)
+    {
+        ++lengthErrors;
+        return false;
+    }
+    if(!FrameParser::checksumValid(rawFrame))
+    {
+        ++checksumErrors;
+        return false;
+    }
+    return true;
+}
+
+template <typename SensorType>
+CygLidarBase::DemuxStatistics BasicCygLidar<SensorType>::demuxStatistics() const noexcept
+{
+    return {sequence3d.load(), sequence2d.load(), ignoredFrames.load()};
+}
+
+template <typename SensorType>
+CygLidarBase::ReadStatistics BasicCygLidar<SensorType>::readStatistics() const noexcept
+{
+    return {checksumErrors.load(), lengthErrors.load()};
+}
+
+template <typename SensorType>
+FrameParser::Statistics BasicCygLidar<SensorType>::parserStatistics() const
+{
+    std::lock_guard lGuard{rwMutex};
+    return parser.statistics();
+}
+
+template <typename SensorType>
+typename BasicCygLidar<SensorType>::Frame3DHandle BasicCygLidar<SensorType>::latest3dFrame() const
+{
+    return frame3D.load();
+}
+
+template <typename SensorType>
+typename BasicCygLidar<SensorType>::Frame2DHandle BasicCygLidar<SensorType>::latest2dFrame() const
+{
+    return frame2D.load();
+}
+
+template <typename SensorType>
+typename BasicCygLidar<SensorType>::PointCloud3DHandle BasicCygLidar<SensorType>::latest3dPointCloud() const
+{
+    return pointcloud3d.load();
+}
+
+template <typename SensorType>
+typename BasicCygLidar<SensorType>::PointCloud2DHandle BasicCygLidar<SensorType>::latest2dPointCloud() const
+{
+    return pointcloud2d.load();
+}
+
+template <typename SensorType>
+typename BasicCygLidar<SensorType>::Frame3DHandle
+BasicCygLidar<SensorType>::waitFor3dFrame(uint64_t sequence, std::chrono::milliseconds timeout) const
+{
+    return waitForNewer<Frame3D>(frame3D, sequence, timeout);
+}
+
+template <typename SensorType>
+typename BasicCygLidar<SensorType>::Frame2DHandle
+BasicCygLidar<SensorType>::waitFor2dFrame(uint64_t sequence, std::chrono::milliseconds timeout) const
+{
+    return waitForNewer<Frame2D>(frame2D, sequence, timeout);
+}
+
+template <typename SensorType>
+typename BasicCygLidar<SensorType>::PointCloud3DHandle
+BasicCygLidar<SensorType>::waitFor3dPointCloud(uint64_t sequence, std::chrono::milliseconds timeout) const
+{
+    return waitForNewer<ClassifiedPointCloud3D>(pointcloud3d, sequence, timeout);
+}
+
+template <typename SensorType>
+typename BasicCygLidar<SensorType>::PointCloud2DHandle
+BasicCygLidar<SensorType>::waitFor2dPointCloud(uint64_t sequence, std::chrono::milliseconds timeout) const
+{
+    return waitForNewer<PointCloud2D>(pointcloud2d, sequence, timeout);
+}
+
+template <typename SensorType>
+uint64_t BasicCygLidar<SensorType>::framesDropped() const noexcept
+{
+    return droppedFrames.load();
+}
+
+template <typename SensorType>
+void BasicCygLidar<SensorType>::use2dPointCloud(PointCloud2DAccessorFunction&& accessor2d) const
+{
+    if(!accessor2d)
+    {
+        return ;
+    }
+    const auto pointCloud = latest2dPointCloud();
+    accessor2d(*pointCloud);
+}
+
+template <typename SensorType>
+void BasicCygLidar<SensorType>::use3dPointCloud(PointCloud3DAccessorFunction&& accessor3d) const
+{
+    if (!accessor3d)
+    {
+        return;
+    }
+    const auto pointCloud = latest3dPointCloud();
+    accessor3d(*pointCloud);
+}
+
+template <typename SensorType>
+void BasicCygLidar<SensorType>::use3dFrame(Frame3DAccessorFunction &&accessor3d) const
+{
+    if (!accessor3d)
+    {
+        return;
+    }
+    const auto frame = latest3dFrame();
+    accessor3d(*frame);
+}
+
+template <typename SensorType>
+void BasicCygLidar<SensorType>::use2dFrame(Frame2DAccessorFunction &&accessor2d) const
+{
+    if(!accessor2d)
+    {
+        return ;
+    }
+    const auto frame = latest2dFrame();
+    accessor2d(*frame);
+}
+
+template <typename SensorType>
+bool BasicCygLidar<SensorType>::failedToRead() const
+{
+    return failureInRead.load();
+}
+
+template <typename SensorType>
+const typename BasicCygLidar<SensorType>::Frame3DBroadcast& BasicCygLidar<SensorType>::frame3dBroadcast() const noexcept
+{
+    return std::get<Frame3DBroadcast>(broadcasts);
+}
+
+template <typename SensorType>
+const typename BasicCygLidar<SensorType>::Frame2DBroadcast& BasicCygLidar<SensorType>::frame2dBroadcast() const noexcept
+{
+    return std::get<Frame2DBroadcast>(broadcasts);
+}
+
+template <typename SensorType>
+const typename BasicCygLidar<SensorType>::PointCloud3DBroadcast&
+BasicCygLidar<SensorType>::pointCloud3dBroadcast() const noexcept
+{
+    return std::get<PointCloud3DBroadcast>(broadcasts);
+}
+
+template <typename SensorType>
+const typename BasicCygLidar<SensorType>::PointCloud2DBroadcast&
+BasicCygLidar<SensorType>::pointCloud2dBroadcast() const noexcept
+{
+    return std::get<PointCloud2DBroadcast>(broadcasts);
+}
+
+template <typename SensorType>
+void BasicCygLidar<SensorType>::queue3dPointClouds(PointCloud3DQueue* queue) noexcept
+{
+    pointCloud3dQueue.store(queue);
+}
+
+template <typename SensorType>
+void BasicCygLidar<SensorType>::queue2dPointClouds(PointCloud2DQueue* queue) noexcept
+{
+    pointCloud2dQueue.store(queue);
+}
+
+extern template class BasicCygLidar<CygLidarD1Sensor>;
+
 } // namespace lidar_viewer::dev
 #endif // LIDAR_VIEWER_CYGLIDARD1_H
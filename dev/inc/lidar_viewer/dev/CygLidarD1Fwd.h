@@ -0,0 +1,17 @@
+#ifndef LIDAR_VIEWER_CYGLIDARD1FWD_H
+#define LIDAR_VIEWER_CYGLIDARD1FWD_H
+
+#include "lidar_viewer/dev/SensorDescriptor.h"
+
+namespace lidar_viewer::dev
+{
+
+template <typename SensorType>
+class BasicCygLidar;
+
+/// CygLidar D1, instantiated once in the device library
+using CygLidarD1 = BasicCygLidar<CygLidarD1Sensor>;
+
+} // namespace lidar_viewer::dev
+
+#endif //LIDAR_VIEWER_CYGLIDARD1FWD_H
@@ -0,0 +1,126 @@
+#ifndef LIDAR_VIEWER_CYGLIDARD1SIMULATOR_H
+#define LIDAR_VIEWER_CYGLIDARD1SIMULATOR_H
+
+#include "CygLidarD1.h"
+#include "FrameParser.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace lidar_viewer::dev
+{
+
+/// @brief stand-in for a CygLidar D1 on a pseudo terminal, answers device info requests,
+/// takes and acknowledges configuration requests, streams frames of the requested mode between Run and Stop requests.
+/// Frames are paced as if sent over a serial line, bytes the host does not read in time are dropped
+/// the way an overflowing UART drops them
+class CygLidarD1Simulator
+{
+public:
+    struct Config
+    {
+        /// frames per second, in Dual mode a 2D and a 3D frame are sent per period
+        double frameRate{30.0};
+        /// baud rate the frames are paced at, 8N1 framing, 0 sends frames as fast as possible
+        unsigned int baudRate{3000000u};
+        /// payload of the device info response
+        std::array<uint8_t, 7u> deviceInfo{0x10u, 0x01u, 0x02u, 0x03u, 0x00u, 0x01u, 0x00u};
+    };
+
+    /// configuration received from the host
+    struct Settings
+    {
+        std::optional<CygLidarD1::Mode> mode{};
+        uint8_t baudRate{};
+        uint16_t pulseDuration{};
+        uint8_t frequencyChannel{};
+        uint8_t sensitivity{};
+    };
+
+    struct Statistics
+    {
+        /// valid requests received
+        uint64_t requests{};
+        uint64_t frames2d{};
+        uint64_t frames3d{};
+        uint64_t bytesWritten{};
+        /// bytes dropped since the host did not keep up
+        uint64_t bytesDropped{};
+        /// frame periods missed since sending took longer than the period
+        uint64_t periodsMissed{};
+    };
+
+    /// size of a chunk written at once when pacing
+    static constexpr std::size_t TX_CHUNK_SIZE = 1024u;
+
+    /// @brief ctor, opens the pseudo terminal, default configuration
+    CygLidarD1Simulator();
+
+    /// @brief ctor, opens the pseudo terminal
+    /// @param cfg simulator configuration
+    explicit CygLidarD1Simulator(Config cfg);
+
+    /// @brief dtor, stops simulator thread, closes the pseudo terminal
+    ~CygLidarD1Simulator() noexcept;
+
+    /// @returns name of the device to open the simulated lidar with
+    [[nodiscard]] std::string deviceName() const;
+
+    /// start simulator thread
+    void start();
+
+    /// stop simulator thread
+    void stop();
+
+    /// @returns configuration received from the host
+    [[nodiscard]] Settings settings() const;
+
+    /// @returns counters of the simulator
+    [[nodiscard]] Statistics statistics() const;
+
+    CygLidarD1Simulator(const CygLidarD1Simulator&) = delete;
+    CygLidarD1Simulator& operator = (const CygLidarD1Simulator&) = delete;
+    CygLidarD1Simulator(CygLidarD1Simulator&&) = delete;
+    CygLidarD1Simulator& operator = (CygLidarD1Simulator&&) = delete;
+
+private:
+    void run();
+
+    void receive();
+
+    void handleRequest(std::span<const uint8_t> rawRequest);
+
+    void sendFrames();
+
+    /// @brief writes data paced at the baud rate
+    /// @returns number of bytes written
+    std::size_t send(std::span<const uint8_t> data);
+
+    Config config;
+    int master;
+    FrameParser requestParser;
+    std::array<uint8_t, 256u> rxChunk;
+    /// raw 3D frames of a changing scene sent in turn
+    std::vector<std::vector<uint8_t>> frames3d;
+    std::vector<uint8_t> frame2d;
+    std::size_t nextFrame3d;
+    std::chrono::steady_clock::time_point nextPeriod;
+    std::chrono::steady_clock::time_point wireFree;
+    std::atomic<bool> stopThread;
+    std::future<void> simulatorFuture;
+    mutable std::mutex stateMutex;
+    Settings state;
+    Statistics stats;
+};
+
+} // namespace lidar_viewer::dev
+
+#endif //LIDAR_VIEWER_CYGLIDARD1SIMULATOR_H
@@ -15,6 +15,9 @@
 namespace lidar_viewer::dev
 {
 
+/// header starting every frame sent to/received from lidar
+constexpr std::array<uint8_t, 3> frameHeader{0x5au, 0x77u, 0xffu};
+
 /// frame represents messages sent to/received from lidar,
 /// s template parameter is size of payload together with payload header
 /// by default frames are of BAD Status
@@ -73,7 +76,7 @@ public:
     {
         auto checkSum = 0u;
         const auto sizeOfHeader = data.repr.header_.size();
-        std::for_each(data.raw.cbegin() + sizeOfHeader, data.raw.cend() - (sizeof(data.repr.checksum_)+1u),
+        std::for_each(data.raw.cbegin() + sizeOfHeader, data.raw.cend() - sizeof(data.repr.checksum_),
                       [&checkSum](const auto& rawElement) { checkSum ^= rawElement; });
         return checkSum;
     }
@@ -89,7 +92,7 @@ private:
     {
         struct Repr
         {
-            const Header header_ {0x5au, 0x77u, 0xffu};
+            const Header header_ {frameHeader};
             decltype(s) length_{s};
             Payload payload_{};
             uint8_t checksum_{};
@@ -177,12 +180,13 @@ Status read(IoStream& ioStream, RespFrame& respFrame)
                       << " != " << sizeof(returnedSize) <<"\n";
             return Status::BAD;
         }
+        // length read is kept in the frame, a frame of another size is told by it
+        std::copy_n(reinterpret_cast<const uint8_t*>(&returnedSize), sizeof(returnedSize), rawResponse);
         if(returnedSize != respFrame.size())
         {
             std::cerr << __func__ << ": " << returnedSize <<" != " << respFrame.size() <<"\n";
+            // as many bytes as expected are read, a binary file stays in step with frames of the expected size
             returnedSize = respFrame.size();
-            // TODO bad sized frames allowed since it breaks the binary file reader,
-            // return StatusOr::Status::BAD;
         }
 
         rawResponse += readBytesInc;
@@ -0,0 +1,109 @@
+#ifndef LIDAR_VIEWER_DEPTHCODEC_H
+#define LIDAR_VIEWER_DEPTHCODEC_H
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace lidar_viewer::dev::codec
+{
+
+enum class CodecId : uint8_t
+{
+    /// 12 bit depths packed the way the lidar sends them
+    Raw         = 0u,
+    /// run length / variable length coding of spatial deltas, every frame independent
+    Rvl         = 1u,
+    /// run length / variable length coding of temporal deltas, with periodic keyframes
+    TemporalRvl = 2u
+};
+
+/// @brief lossless codec of 12 bit depth images
+class DepthCodec
+{
+public:
+    virtual ~DepthCodec() = default;
+
+    /// @returns identifier of the codec
+    [[nodiscard]] virtual CodecId id() const noexcept = 0;
+
+    /// @brief encodes depths
+    /// @param depths depths to encode, 12 bit each
+    /// @param encoded encoded depths are appended to it
+    virtual void encode(std::span<const uint16_t> depths, std::vector<uint8_t>& encoded) = 0;
+
+    /// @brief decodes depths, frames of stateful codecs must be decoded in the order they were encoded
+    /// @param encoded encoded depths
+    /// @param depths decoded depths, as many as were encoded
+    /// @returns number of bytes consumed
+    virtual std::size_t decode(std::span<const uint8_t> encoded, std::span<uint16_t> depths) noexcept(false) = 0;
+
+    /// @param encoded encoded depths
+    /// @returns true if encoded depths can be decoded without any preceding frame
+    [[nodiscard]] virtual bool keyframe(std::span<const uint8_t> encoded) const noexcept = 0;
+
+    /// @brief drops state, next encoded frame is a keyframe, next decoded frame has to be a keyframe
+    virtual void reset() noexcept = 0;
+};
+
+/// @brief packs depths to 12 bits, no compression
+class RawCodec
+        : public DepthCodec
+{
+public:
+    [[nodiscard]] CodecId id() const noexcept override;
+    void encode(std::span<const uint16_t> depths, std::vector<uint8_t>& encoded) override;
+    std::size_t decode(std::span<const uint8_t> encoded, std::span<uint16_t> depths) noexcept(false) override;
+    [[nodiscard]] bool keyframe(std::span<const uint8_t> encoded) const noexcept override;
+    void reset() noexcept override;
+};
+
+/// @brief RVL coding (A. Wilson, "Fast Lossless Depth Image Compression"), zero runs are counted,
+/// non zero deltas between neighbouring depths are zigzag encoded in variable length nibbles
+class RvlCodec
+        : public DepthCodec
+{
+public:
+    [[nodiscard]] CodecId id() const noexcept override;
+    void encode(std::span<const uint16_t> depths, std::vector<uint8_t>& encoded) override;
+    std::size_t decode(std::span<const uint8_t> encoded, std::span<uint16_t> depths) noexcept(false) override;
+    [[nodiscard]] bool keyframe(std::span<const uint8_t> encoded) const noexcept override;
+    void reset() noexcept override;
+};
+
+/// @brief RVL coding of differences to the previous frame, static parts of the scene end up as zero runs,
+/// every keyframeInterval-th frame is coded on its own
+class TemporalRvlCodec
+        : public DepthCodec
+{
+public:
+    /// @brief ctor
+    /// @param keyframeInterval distance between keyframes, bounds the cost of random access
+    explicit TemporalRvlCodec(unsigned int keyframeInterval = 30u);
+
+    [[nodiscard]] CodecId id() const noexcept override;
+    void encode(std::span<const uint16_t> depths, std::vector<uint8_t>& encoded) override;
+    std::size_t decode(std::span<const uint8_t> encoded, std::span<uint16_t> depths) noexcept(false) override;
+    [[nodiscard]] bool keyframe(std::span<const uint8_t> encoded) const noexcept override;
+    void reset() noexcept override;
+
+private:
+    unsigned int keyframeInterval;
+    unsigned int framesSinceKeyframe;
+    bool hasPrevious;
+    std::vector<uint16_t> previous;
+};
+
+/// @param id identifier of a codec
+/// @returns new instance of the codec
+std::unique_ptr<DepthCodec> makeDepthCodec(CodecId id);
+
+/// @param name name of a codec, "raw", "rvl" or "delta"
+/// @returns identifier of the codec
+CodecId codecIdFromName(const std::string& name) noexcept(false);
+
+} // namespace lidar_viewer::dev::codec
+
+#endif //LIDAR_VIEWER_DEPTHCODEC_H
@@ -0,0 +1,42 @@
+#ifndef LIDAR_VIEWER_DEPTHPACKING_H
+#define LIDAR_VIEWER_DEPTHPACKING_H
+
+#include <cstdint>
+#include <span>
+
+namespace lidar_viewer::dev
+{
+
+/// @brief unpacks 12 bit depths as sent by the lidar, two depths in three bytes:
+/// low byte of the first, high nibble of the first / low nibble of the second, high byte of the second
+/// @param packed packed depths
+/// @param depths unpacked depths, unpacks as many as both spans allow
+inline void unpack12(std::span<const uint8_t> packed, std::span<uint16_t> depths) noexcept
+{
+    auto depthIt = depths.begin();
+    for(std::size_t i = 0u; i + 2u < packed.size() && depthIt + 1 < depths.end(); i += 3u)
+    {
+        *depthIt++ = static_cast<uint16_t>(packed[i] | ((packed[i + 1u] & 0xfu) << 8u));
+        *depthIt++ = static_cast<uint16_t>(((packed[i + 1u] & 0xf0u) >> 4u) | (packed[i + 2u] << 4u));
+    }
+}
+
+/// @brief packs 12 bit depths the way the lidar sends them, inverse of unpack12
+/// @param depths depths to pack, upper 4 bits are dropped
+/// @param packed packed depths, packs as many as both spans allow
+inline void pack12(std::span<const uint16_t> depths, std::span<uint8_t> packed) noexcept
+{
+    auto depthIt = depths.begin();
+    for(std::size_t i = 0u; i + 2u < packed.size() && depthIt + 1 < depths.end(); i += 3u, depthIt += 2)
+    {
+        const auto first = depthIt[0];
+        const auto second = depthIt[1];
+        packed[i] = static_cast<uint8_t>(first & 0xffu);
+        packed[i + 1u] = static_cast<uint8_t>(((first >> 8u) & 0xfu) | ((second & 0xfu) << 4u));
+        packed[i + 2u] = static_cast<uint8_t>((second >> 4u) & 0xffu);
+    }
+}
+
+} // namespace lidar_viewer::dev
+
+#endif //LIDAR_VIEWER_DEPTHPACKING_H
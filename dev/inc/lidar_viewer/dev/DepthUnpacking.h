@@ -0,0 +1,40 @@
+#ifndef LIDAR_VIEWER_DEPTHUNPACKING_H
+#define LIDAR_VIEWER_DEPTHUNPACKING_H
+
+#include <cstdint>
+#include <span>
+
+namespace lidar_viewer::dev
+{
+
+/// instruction set depths are unpacked with
+enum class UnpackKernel : uint8_t
+{
+    Scalar,
+    Ssse3,
+    Avx2
+};
+
+/// @returns true if the cpu supports the kernel
+[[nodiscard]] bool unpackKernelSupported(UnpackKernel kernel) noexcept;
+
+/// @returns fastest kernel the cpu supports
+[[nodiscard]] UnpackKernel bestUnpackKernel() noexcept;
+
+/// @brief unpacks 12 bit depths of a 3D frame, two depths in three bytes, same result as unpack12
+/// @param packed packed depths, without the payload header
+/// @param depths unpacked depths, unpacks as many pairs as both spans allow
+/// @param kernel kernel to use, falls back to scalar if the cpu does not support it
+void unpack3dDepths(std::span<const uint8_t> packed, std::span<uint16_t> depths,
+                    UnpackKernel kernel = bestUnpackKernel()) noexcept;
+
+/// @brief unpacks depths of a 2D frame, two bytes per depth, low byte first, upper nibble of the high byte is dropped
+/// @param packed packed depths, without the payload header
+/// @param depths unpacked depths, unpacks as many as both spans allow
+/// @param kernel kernel to use, falls back to scalar if the cpu does not support it
+void unpack2dDepths(std::span<const uint8_t> packed, std::span<uint16_t> depths,
+                    UnpackKernel kernel = bestUnpackKernel()) noexcept;
+
+} // namespace lidar_viewer::dev
+
+#endif //LIDAR_VIEWER_DEPTHUNPACKING_H
@@ -0,0 +1,60 @@
+#ifndef LIDAR_VIEWER_DEPTHVALIDITY_H
+#define LIDAR_VIEWER_DEPTHVALIDITY_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace lidar_viewer::dev
+{
+
+/// numbers of depths of each kind in a 3D frame
+struct Depth3DCounts
+{
+    /// depths within the valid range
+    uint32_t valid{};
+    /// depths outside of the valid range which are no error codes
+    uint32_t outOfRange{};
+    /// sensor error codes
+    uint32_t lowAmplitude{};
+    uint32_t adcOverflow{};
+    uint32_t saturation{};
+};
+
+/// validity of the depths of a frame, one bit per depth set for depths within the valid range
+/// @tparam N number of depths
+template <std::size_t N>
+struct DepthValidity
+{
+    static constexpr std::size_t WORDS = (N + 63u) / 64u;
+
+    std::array<uint64_t, WORDS> mask{};
+    Depth3DCounts counts{};
+
+    /// @returns true if the depth at index is valid
+    [[nodiscard]] bool valid(std::size_t index) const noexcept
+    {
+        return (mask[index / 64u] >> (index % 64u)) & 1u;
+    }
+};
+
+/// @brief classifies depths of a 3D frame in a single pass, 32 depths at once if the cpu supports AVX2
+/// @param depths depths of a frame
+/// @param minDepth smallest valid depth
+/// @param maxDepth largest valid depth, error codes are never valid
+/// @param mask one bit per depth, set for valid depths, as many depths as it has bits are classified
+/// @returns numbers of depths of each kind
+Depth3DCounts classify3dDepths(std::span<const uint16_t> depths, uint16_t minDepth, uint16_t maxDepth,
+                               std::span<uint64_t> mask) noexcept;
+
+/// @brief restores the sensor error codes of a 2D frame, which unpacking masks to 12 bits like any depth,
+/// so they are not taken for depths, 2D depths are not classified otherwise
+/// @param packed packed depths, without the payload header
+/// @param depths depths unpacked from them, as many as both spans allow are checked
+/// @returns number of error codes restored
+uint32_t restore2dErrorCodes(std::span<const uint8_t> packed, std::span<uint16_t> depths) noexcept;
+
+} // namespace lidar_viewer::dev
+
+#endif //LIDAR_VIEWER_DEPTHVALIDITY_H
@@ -0,0 +1,293 @@
+#ifndef LIDAR_VIEWER_FRAMEBROADCAST_H
+#define LIDAR_VIEWER_FRAMEBROADCAST_H
+
+#include "lidar_viewer/dev/FramePool.h"
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace lidar_viewer::dev
+{
+
+/// @brief broadcasts buffers of a pool published by a single producer to any number of subscribers,
+/// each of them advancing its own cursor over the Depth buffers published last.
+/// The producer never waits for subscribers, a subscriber falling more than Depth buffers behind skips
+/// the overwritten ones and counts them as missed, the others are not affected.
+/// Every slot keeps the buffer published into it, so Depth buffers of the pool stay in use
+/// @tparam T type of a buffer
+/// @tparam N number of buffers of the pool
+/// @tparam Depth number of buffers published last a subscriber may catch up on, power of two
+template <typename T, std::size_t N, std::size_t Depth>
+class FrameBroadcast
+{
+    static_assert(Depth > 1u && std::has_single_bit(Depth), "FrameBroadcast depth is a power of two above 1");
+    static_assert(Depth < N, "FrameBroadcast leaves buffers of the pool to be filled");
+
+public:
+    using Pool = FramePool<T, N>;
+    using ConstHandle = typename Pool::ConstHandle;
+
+    static constexpr std::size_t MAX_SUBSCRIBERS = 8u;
+
+    /// counters of a subscriber
+    struct SubscriberStatistics
+    {
+        std::size_t id{};
+        /// buffers published the subscriber did not take yet
+        uint64_t lag{};
+        uint64_t received{};
+        /// buffers overwritten before the subscriber took them
+        uint64_t missed{};
+    };
+
+    /// cursor of a subscriber, unsubscribes when destroyed, the broadcast has to outlive it
+    class Subscriber
+    {
+    public:
+        Subscriber(Subscriber&& other) noexcept
+        : broadcast{std::exchange(other.broadcast, nullptr)}
+        , index{other.index}
+        { }
+
+        Subscriber& operator = (Subscriber other) noexcept
+        {
+            std::swap(broadcast, other.broadcast);
+            std::swap(index, other.index);
+            return *this;
+        }
+
+        ~Subscriber() noexcept
+        {
+            if(broadcast)
+            {
+                broadcast->unsubscribe(index);
+            }
+        }
+
+        /// @returns handle of the oldest buffer not taken yet, empty handle if there is none
+        [[nodiscard]] ConstHandle next() noexcept
+        {
+            return broadcast->next(index);
+        }
+
+        /// @brief waits for a buffer not taken yet
+        /// @param timeout longest time to wait
+        /// @returns handle of the oldest buffer not taken yet, empty handle if none was published in time
+        [[nodiscard]] ConstHandle waitNext(std::chrono::milliseconds timeout)
+        {
+            return broadcast->waitNext(index, timeout);
+        }
+
+        [[nodiscard]] SubscriberStatistics statistics() const noexcept
+        {
+            return broadcast->statistics(index);
+        }
+
+        Subscriber(const Subscriber&) = delete;
+
+    private:
+        friend class FrameBroadcast;
+
+        Subscriber(const FrameBroadcast* broadcast_, std::size_t index_) noexcept
+        : broadcast{broadcast_}
+        , index{index_}
+        { }
+
+        const FrameBroadcast* broadcast;
+        std::size_t index;
+    };
+
+    /// @brief ctor
+    /// @param pool pool buffers published are taken from
+    explicit FrameBroadcast(Pool& pool)
+    : slots{makeSlots(pool, std::make_index_sequence<Depth>{})}
+    , head{0u}
+    , cursors{}
+    , waiters{0u}
+    { }
+
+    /// @brief publishes a buffer to every subscriber, producer only, never waits for subscribers
+    /// @param handle handle of the buffer, taken over, the buffer must not be modified afterwards
+    void publish(ConstHandle&& handle) noexcept
+    {
+        const auto position = head.load(std::memory_order_relaxed);
+        auto& slot = slots[position & (Depth - 1u)];
+        // subscribers reading the slot meanwhile see it is being overwritten
+        slot.position.store(none, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.latest.publish(std::move(handle));
+        slot.position.store(position, std::memory_order_release);
+        head.store(position + 1u, std::memory_order_release);
+        wake();
+    }
+
+    /// @returns subscriber receiving buffers published from now on
+    /// @throws std::runtime_error if there are MAX_SUBSCRIBERS subscribers already
+    [[nodiscard]] Subscriber subscribe() const
+    {
+        for(std::size_t index = 0u; index < MAX_SUBSCRIBERS; ++index)
+        {
+            auto& cursor = cursors[index];
+            bool active{false};
+            if(cursor.active.compare_exchange_strong(active, true, std::memory_order_acq_rel))
+            {
+                cursor.received.store(0u, std::memory_order_relaxed);
+                cursor.missed.store(0u, std::memory_order_relaxed);
+                cursor.position.store(head.load(std::memory_order_acquire), std::memory_order_release);
+                return Subscriber{this, index};
+            }
+        }
+        throw std::runtime_error{"FrameBroadcast subscribers exhausted"};
+    }
+
+    /// @returns number of buffers published so far
+    [[nodiscard]] uint64_t published() const noexcept
+    {
+        return head.load(std::memory_order_acquire);
+    }
+
+    /// @returns counters of every subscriber
+    [[nodiscard]] std::vector<SubscriberStatistics> statistics() const
+    {
+        std::vector<SubscriberStatistics> subscribers;
+        for(std::size_t index = 0u; index < MAX_SUBSCRIBERS; ++index)
+        {
+            if(cursors[index].active.load(std::memory_order_acquire))
+            {
+                subscribers.push_back(statistics(index));
+            }
+        }
+        return subscribers;
+    }
+
+    FrameBroadcast(const FrameBroadcast&) = delete;
+    FrameBroadcast& operator = (const FrameBroadcast&) = delete;
+    FrameBroadcast(FrameBroadcast&&) = delete;
+    FrameBroadcast& operator = (FrameBroadcast&&) = delete;
+
+private:
+    static constexpr uint64_t none = std::numeric_limits<uint64_t>::max();
+
+    struct Slot
+    {
+        Slot(Pool& pool) noexcept
+        : latest{pool}
+        , position{none}
+        { }
+
+        typename Pool::Latest latest;
+        /// position the buffer was published at, none while being overwritten
+        std::atomic<uint64_t> position;
+    };
+
+    struct Cursor
+    {
+        std::atomic<bool> active{false};
+        /// position of the next buffer to take, written by the subscriber only
+        std::atomic<uint64_t> position{0u};
+        std::atomic<uint64_t> received{0u};
+        std::atomic<uint64_t> missed{0u};
+    };
+
+    template <std::size_t ... I>
+    static std::array<Slot, Depth> makeSlots(Pool& pool, std::index_sequence<I...>)
+    {
+        return {{((void)I, Slot{pool})...}};
+    }
+
+    ConstHandle next(std::size_t index) const noexcept
+    {
+        auto& cursor = cursors[index];
+        auto position = cursor.position.load(std::memory_order_relaxed);
+        for(;;)
+        {
+            const auto published = head.load(std::memory_order_acquire);
+            if(position >= published)
+            {
+                return ConstHandle{};
+            }
+            if(published - position > Depth)
+            {
+                cursor.missed.fetch_add(published - Depth - position, std::memory_order_relaxed);
+                position = published - Depth;
+            }
+            const auto& slot = slots[position & (Depth - 1u)];
+            const auto before = slot.position.load(std::memory_order_acquire);
+            auto handle = slot.latest.load();
+            std::atomic_thread_fence(std::memory_order_acquire);
+            const auto after = slot.position.load(std::memory_order_relaxed);
+            if(before == position && after == position)
+            {
+                cursor.position.store(position + 1u, std::memory_order_release);
+                cursor.received.fetch_add(1u, std::memory_order_relaxed);
+                return handle;
+            }
+            // the producer overwrote the slot meanwhile, the cursor is skipped past it on the next pass
+        }
+    }
+
+    ConstHandle waitNext(std::size_t index, std::chrono::milliseconds timeout) const
+    {
+        if(auto handle = next(index))
+        {
+            return handle;
+        }
+        const auto& cursor = cursors[index];
+        std::unique_lock lock{waitMutex};
+        waiters.fetch_add(1u);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        arrived.wait_for(lock, timeout, [this, &cursor]()
+        {
+            return head.load(std::memory_order_acquire) > cursor.position.load(std::memory_order_relaxed);
+        });
+        waiters.fetch_sub(1u);
+        lock.unlock();
+        return next(index);
+    }
+
+    SubscriberStatistics statistics(std::size_t index) const noexcept
+    {
+        const auto& cursor = cursors[index];
+        const auto position = cursor.position.load(std::memory_order_acquire);
+        return {index, head.load(std::memory_order_acquire) - position,
+                cursor.received.load(std::memory_order_relaxed), cursor.missed.load(std::memory_order_relaxed)};
+    }
+
+    void unsubscribe(std::size_t index) const noexcept
+    {
+        cursors[index].active.store(false, std::memory_order_release);
+    }
+
+    void wake()
+    {
+        // pairs with a waiting subscriber counting itself before checking for a buffer
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if(waiters.load(std::memory_order_relaxed) != 0u)
+        {
+            std::lock_guard lGuard{waitMutex};
+            arrived.notify_all();
+        }
+    }
+
+    std::array<Slot, Depth> slots;
+    /// position the next buffer is published at
+    std::atomic<uint64_t> head;
+    mutable std::array<Cursor, MAX_SUBSCRIBERS> cursors;
+    mutable std::atomic<uint32_t> waiters;
+    mutable std::mutex waitMutex;
+    mutable std::condition_variable arrived;
+};
+
+} // namespace lidar_viewer::dev
+
+#endif //LIDAR_VIEWER_FRAMEBROADCAST_H
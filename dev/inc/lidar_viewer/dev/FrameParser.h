@@ -0,0 +1,72 @@
+#ifndef LIDAR_VIEWER_FRAMEPARSER_H
+#define LIDAR_VIEWER_FRAMEPARSER_H
+
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <vector>
+
+namespace lidar_viewer::dev
+{
+
+/// @brief incremental parser of a byte stream received from lidar,
+/// scans for the frame header, validates length and checksum and resynchronizes on the next header
+/// whenever a frame turns out to be corrupted, partial frames are kept in between calls
+class FrameParser
+{
+public:
+    /// called for every complete and valid raw frame (header, length, payload, checksum)
+    using FrameHandler = std::function<void(std::span<const uint8_t>)>;
+
+    struct Statistics
+    {
+        /// bytes dropped while looking for a valid frame
+        uint64_t bytesSkipped{};
+        /// valid frames handed out
+        uint64_t framesParsed{};
+        /// valid frames found right after skipping some bytes
+        uint64_t framesRecovered{};
+        /// candidate frames with a length out of range
+        uint64_t lengthErrors{};
+        /// candidate frames with a checksum mismatch
+        uint64_t checksumErrors{};
+    };
+
+    /// @brief ctor
+    /// @param maxPayloadSize largest payload accepted, length field above it means corrupted frame
+    explicit FrameParser(std::size_t maxPayloadSize);
+
+    /// @brief parses received bytes
+    /// @param data received bytes
+    /// @param onFrame frame handler, frame is valid only within the call
+    void feed(std::span<const uint8_t> data, const FrameHandler& onFrame);
+
+    /// @returns counters of the parser
+    [[nodiscard]] const Statistics& statistics() const noexcept;
+
+    /// @returns number of bytes kept until the rest of a frame arrives
+    [[nodiscard]] std::size_t pendingBytes() const noexcept;
+
+    /// @brief drops bytes kept in between calls
+    void reset() noexcept;
+
+    /// @brief validates checksum of a raw frame, XOR of length and payload
+    /// @param rawFrame raw frame
+    /// @returns true if checksum matches
+    [[nodiscard]] static bool checksumValid(std::span<const uint8_t> rawFrame) noexcept;
+
+private:
+    /// @returns number of bytes consumed, the rest is beginning of a frame
+    std::size_t parse(std::span<const uint8_t> data, const FrameHandler& onFrame);
+
+    void skip(std::size_t size) noexcept;
+
+    std::size_t maxPayloadSize;
+    std::vector<uint8_t> pending;
+    bool desynchronized;
+    Statistics stats;
+};
+
+} // namespace lidar_viewer::dev
+
+#endif //LIDAR_VIEWER_FRAMEPARSER_H
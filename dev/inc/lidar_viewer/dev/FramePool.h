@@ -0,0 +1,256 @@
+#ifndef LIDAR_VIEWER_FRAMEPOOL_H
+#define LIDAR_VIEWER_FRAMEPOOL_H
+
+#include <atomic>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace lidar_viewer::dev
+{
+
+/// @brief fixed pool of reference counted buffers, all of them allocated once at construction,
+/// acquiring and releasing a buffer is lock free and does not allocate.
+/// A buffer returns to the pool once the last handle to it is gone, the pool has to outlive its handles
+/// @tparam T type of a buffer, default constructible
+/// @tparam N number of buffers, at most 64
+template <typename T, std::size_t N>
+class FramePool
+{
+    static_assert(N > 0u && N <= 64u, "FramePool holds 1 to 64 buffers");
+
+public:
+    /// handle sharing ownership of a buffer, empty when the pool was exhausted
+    template <typename U>
+    class BasicHandle
+    {
+    public:
+        BasicHandle() noexcept = default;
+
+        BasicHandle(const BasicHandle& other) noexcept
+        : pool{other.pool}
+        , index{other.index}
+        {
+            retain();
+        }
+
+        BasicHandle(BasicHandle&& other) noexcept
+        : pool{std::exchange(other.pool, nullptr)}
+        , index{other.index}
+        { }
+
+        /// @brief converts a handle to a handle of a read only buffer
+        template <typename V, typename = std::enable_if_t<std::is_same_v<V, T> && std::is_const_v<U>>>
+        BasicHandle(BasicHandle<V>&& other) noexcept
+        : pool{std::exchange(other.pool, nullptr)}
+        , index{other.index}
+        { }
+
+        BasicHandle& operator = (BasicHandle other) noexcept
+        {
+            std::swap(pool, other.pool);
+            std::swap(index, other.index);
+            return *this;
+        }
+
+        ~BasicHandle() noexcept
+        {
+            if(pool)
+            {
+                pool->release(index);
+            }
+        }
+
+        [[nodiscard]] U* get() const noexcept
+        {
+            return pool ? &pool->buffers[index] : nullptr;
+        }
+
+        U& operator * () const noexcept
+        {
+            return *get();
+        }
+
+        U* operator -> () const noexcept
+        {
+            return get();
+        }
+
+        explicit operator bool () const noexcept
+        {
+            return pool != nullptr;
+        }
+
+        /// @returns number of handles sharing the buffer
+        [[nodiscard]] uint32_t useCount() const noexcept
+        {
+            return pool ? pool->refCounts[index].load(std::memory_order_relaxed) : 0u;
+        }
+
+    private:
+        friend class FramePool;
+        template <typename> friend class BasicHandle;
+
+        BasicHandle(FramePool* pool_, std::size_t index_) noexcept
+        : pool{pool_}
+        , index{index_}
+        { }
+
+        void retain() const noexcept
+        {
+            if(pool)
+            {
+                pool->refCounts[index].fetch_add(1u, std::memory_order_relaxed);
+            }
+        }
+
+        FramePool* pool{nullptr};
+        std::size_t index{0u};
+    };
+
+    using Handle = BasicHandle<T>;
+    using ConstHandle = BasicHandle<const T>;
+
+    /// @brief latest buffer published by a single writer, the writer never blocks,
+    /// readers get the latest complete buffer without locking, retrying only when a newer one is published meanwhile
+    class Latest
+    {
+    public:
+        explicit Latest(FramePool& pool_) noexcept
+        : pool{pool_}
+        , index{none}
+        { }
+
+        ~Latest() noexcept
+        {
+            if(const auto previous = index.exchange(none); previous != none)
+            {
+                pool.release(previous);
+            }
+        }
+
+        /// @brief makes a buffer the latest one, the buffer must not be modified afterwards
+        /// @param handle handle of the buffer, taken over
+        template <typename U>
+        void publish(BasicHandle<U>&& handle) noexcept
+        {
+            const auto published = handle.pool ? handle.index : none;
+            handle.pool = nullptr;
+            if(const auto previous = index.exchange(published, std::memory_order_acq_rel); previous != none)
+            {
+                pool.release(previous);
+            }
+        }
+
+        /// @returns handle of the latest buffer, empty if none was published
+        [[nodiscard]] ConstHandle load() const noexcept
+        {
+            for(;;)
+            {
+                const auto published = index.load(std::memory_order_acquire);
+                if(published == none)
+                {
+                    return ConstHandle{};
+                }
+                // a buffer released meanwhile may not be revived, one reused meanwhile is not published any more
+                if(!pool.tryRetain(published))
+                {
+                    continue;
+                }
+                if(index.load(std::memory_order_acquire) == published)
+                {
+                    return ConstHandle{&pool, published};
+                }
+                pool.release(published);
+            }
+        }
+
+        Latest(const Latest&) = delete;
+        Latest& operator = (const Latest&) = delete;
+        Latest(Latest&&) = delete;
+        Latest& operator = (Latest&&) = delete;
+
+    private:
+        static constexpr std::size_t none = N;
+
+        FramePool& pool;
+        std::atomic<std::size_t> index;
+    };
+
+    FramePool()
+    : buffers{std::make_unique<T[]>(N)}
+    , refCounts{}
+    , freeMask{N == 64u ? ~uint64_t{0u} : (uint64_t{1u} << N) - 1u}
+    { }
+
+    /// @returns handle of a free buffer, empty handle if all buffers are in use,
+    /// the buffer keeps contents it was released with
+    [[nodiscard]] Handle acquire() noexcept
+    {
+        auto mask = freeMask.load(std::memory_order_relaxed);
+        while(mask != 0u)
+        {
+            const auto index = static_cast<std::size_t>(std::countr_zero(mask));
+            if(freeMask.compare_exchange_weak(mask, mask & ~(uint64_t{1u} << index),
+                                              std::memory_order_acquire, std::memory_order_relaxed))
+            {
+                refCounts[index].store(1u, std::memory_order_relaxed);
+                return Handle{this, index};
+            }
+        }
+        return Handle{};
+    }
+
+    /// @returns number of free buffers
+    [[nodiscard]] std::size_t available() const noexcept
+    {
+        return static_cast<std::size_t>(std::popcount(freeMask.load(std::memory_order_relaxed)));
+    }
+
+    [[nodiscard]] static constexpr std::size_t capacity() noexcept
+    {
+        return N;
+    }
+
+    FramePool(const FramePool&) = delete;
+    FramePool& operator = (const FramePool&) = delete;
+    FramePool(FramePool&&) = delete;
+    FramePool& operator = (FramePool&&) = delete;
+
+private:
+    /// @brief takes another reference to a buffer still in use
+    /// @returns false if the buffer was released
+    bool tryRetain(std::size_t index) noexcept
+    {
+        auto count = refCounts[index].load(std::memory_order_relaxed);
+        while(count != 0u)
+        {
+            if(refCounts[index].compare_exchange_weak(count, count + 1u, std::memory_order_acquire,
+                                                      std::memory_order_relaxed))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void release(std::size_t index) noexcept
+    {
+        if(refCounts[index].fetch_sub(1u, std::memory_order_acq_rel) == 1u)
+        {
+            freeMask.fetch_or(uint64_t{1u} << index, std::memory_order_release);
+        }
+    }
+
+    std::unique_ptr<T[]> buffers;
+    std::array<std::atomic<uint32_t>, N> refCounts;
+    std::atomic<uint64_t> freeMask;
+};
+
+} // namespace lidar_viewer::dev
+
+#endif //LIDAR_VIEWER_FRAMEPOOL_H
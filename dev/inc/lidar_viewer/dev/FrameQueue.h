@@ -0,0 +1,271 @@
+#ifndef LIDAR_VIEWER_FRAMEQUEUE_H
+#define LIDAR_VIEWER_FRAMEQUEUE_H
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+
+namespace lidar_viewer::dev
+{
+
+/// what a full queue does with a pushed element
+enum class OverflowPolicy : uint8_t
+{
+    /// the oldest queued element is dropped to make room
+    DropOldest,
+    /// the pushed element is dropped
+    DropNewest,
+    /// the producer waits for the consumer to make room
+    Block
+};
+
+/// @brief bounded single producer single consumer queue, pushing and popping is lock free
+/// unless the producer blocks on a full queue or the consumer waits for an element.
+/// Every slot carries a sequence number telling whose turn it is, so the producer may drop the oldest element
+/// while the consumer takes it out
+/// @tparam T type of an element, default constructible and movable, frame handles usually
+template <typename T>
+class FrameQueue
+{
+public:
+    using value_type = T;
+
+    /// counters of a queue
+    struct Statistics
+    {
+        uint64_t pushed{};
+        uint64_t popped{};
+        /// queued elements dropped to make room, DropOldest
+        uint64_t droppedOldest{};
+        /// pushed elements dropped, DropNewest
+        uint64_t droppedNewest{};
+        /// pushes that had to wait for room, Block
+        uint64_t blocked{};
+    };
+
+    /// @brief ctor
+    /// @param capacity_ number of elements the queue holds, rounded up to a power of two of at least 2
+    /// since a single slot could not tell a full queue from an empty one
+    /// @param policy_ what a full queue does with pushed elements
+    FrameQueue(std::size_t capacity_, OverflowPolicy policy_)
+    : slots{std::make_unique<Slot[]>(std::bit_ceil(std::max<std::size_t>(capacity_, 2u)))}
+    , mask{std::bit_ceil(std::max<std::size_t>(capacity_, 2u)) - 1u}
+    , policy{policy_}
+    , head{0u}
+    , tail{0u}
+    , closed{false}
+    , waiters{0u}
+    , pushed{0u}
+    , popped{0u}
+    , droppedOldest{0u}
+    , droppedNewest{0u}
+    , blocked{0u}
+    {
+        for(std::size_t i = 0u; i <= mask; ++i)
+        {
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    /// @brief queues an element, producer only
+    /// @param element element taken over if queued
+    /// @returns false if the element was dropped or the queue closed
+    bool push(T&& element)
+    {
+        if(closed.load(std::memory_order_relaxed))
+        {
+            return false;
+        }
+        const auto position = head.load(std::memory_order_relaxed);
+        auto& slot = slots[position & mask];
+        for(;;)
+        {
+            if(slot.sequence.load(std::memory_order_acquire) == position)
+            {
+                slot.element = std::move(element);
+                slot.sequence.store(position + 1u, std::memory_order_release);
+                head.store(position + 1u, std::memory_order_release);
+                pushed.fetch_add(1u, std::memory_order_relaxed);
+                wake();
+                return true;
+            }
+            // the slot holds the oldest element, or the consumer is still taking it out
+            auto oldest = position - capacity();
+            const auto full = tail.load(std::memory_order_acquire) == oldest;
+            if(full && policy == OverflowPolicy::DropNewest)
+            {
+                droppedNewest.fetch_add(1u, std::memory_order_relaxed);
+                return false;
+            }
+            if(full && policy == OverflowPolicy::DropOldest
+               && tail.compare_exchange_strong(oldest, oldest + 1u, std::memory_order_acq_rel))
+            {
+                // the consumer moves past the slot, it is the producer's to empty
+                auto dropped = std::move(slot.element);
+                slot.sequence.store(position, std::memory_order_release);
+                droppedOldest.fetch_add(1u, std::memory_order_relaxed);
+                continue;
+            }
+            if(full && policy == OverflowPolicy::Block)
+            {
+                blocked.fetch_add(1u, std::memory_order_relaxed);
+                if(!waitUntil([this, &slot, position]()
+                              { return slot.sequence.load(std::memory_order_acquire) == position; },
+                              std::chrono::milliseconds::max()))
+                {
+                    return false;
+                }
+                continue;
+            }
+            std::this_thread::yield();
+        }
+    }
+
+    /// @returns the oldest element if any, consumer only
+    std::optional<T> tryPop()
+    {
+        auto position = tail.load(std::memory_order_relaxed);
+        for(;;)
+        {
+            auto& slot = slots[position & mask];
+            const auto sequence = slot.sequence.load(std::memory_order_acquire);
+            const auto turn = static_cast<std::ptrdiff_t>(sequence - (position + 1u));
+            if(turn < 0)
+            {
+                return std::nullopt;
+            }
+            if(turn > 0)
+            {
+                // the producer dropped the element meanwhile
+                position = tail.load(std::memory_order_relaxed);
+                continue;
+            }
+            if(tail.compare_exchange_weak(position, position + 1u, std::memory_order_acq_rel,
+                                          std::memory_order_relaxed))
+            {
+                std::optional<T> element{std::move(slot.element)};
+                slot.sequence.store(position + capacity(), std::memory_order_release);
+                popped.fetch_add(1u, std::memory_order_relaxed);
+                wake();
+                return element;
+            }
+        }
+    }
+
+    /// @brief waits for an element, consumer only
+    /// @param timeout longest time to wait
+    /// @returns the oldest element, empty if none arrived in time or the queue is closed and empty
+    std::optional<T> pop(std::chrono::milliseconds timeout)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        for(;;)
+        {
+            if(auto element = tryPop())
+            {
+                return element;
+            }
+            const auto remaining = std::chrono::ceil<std::chrono::milliseconds>(
+                    deadline - std::chrono::steady_clock::now());
+            // popping under the lock would deadlock on waking the producer
+            if(remaining.count() <= 0 || !waitUntil([this]() { return size() != 0u; }, remaining))
+            {
+                return tryPop();
+            }
+        }
+    }
+
+    /// @brief wakes a blocked producer and a waiting consumer, pushes fail afterwards
+    void close()
+    {
+        closed.store(true);
+        std::lock_guard lGuard{waitMutex};
+        changed.notify_all();
+    }
+
+    /// @returns number of queued elements
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        const auto position = tail.load(std::memory_order_acquire);
+        return head.load(std::memory_order_acquire) - position;
+    }
+
+    [[nodiscard]] std::size_t capacity() const noexcept
+    {
+        return mask + 1u;
+    }
+
+    [[nodiscard]] Statistics statistics() const noexcept
+    {
+        return {pushed.load(std::memory_order_relaxed), popped.load(std::memory_order_relaxed),
+                droppedOldest.load(std::memory_order_relaxed), droppedNewest.load(std::memory_order_relaxed),
+                blocked.load(std::memory_order_relaxed)};
+    }
+
+    FrameQueue(const FrameQueue&) = delete;
+    FrameQueue& operator = (const FrameQueue&) = delete;
+    FrameQueue(FrameQueue&&) = delete;
+    FrameQueue& operator = (FrameQueue&&) = delete;
+
+private:
+    struct Slot
+    {
+        /// position an element is pushed at when equal, popped at when one above
+        std::atomic<std::size_t> sequence{0u};
+        T element{};
+    };
+
+    /// @brief waits for a condition checked under the lock, the other side only locks if one waits
+    /// @returns false if the queue was closed or the condition not met in time
+    template <typename Condition>
+    bool waitUntil(Condition&& condition, std::chrono::milliseconds timeout)
+    {
+        std::unique_lock lock{waitMutex};
+        waiters.fetch_add(1u);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const auto met = [this, &condition]() { return condition() || closed.load(); };
+        const auto satisfied = timeout == std::chrono::milliseconds::max() ? (changed.wait(lock, met), true)
+                                                                           : changed.wait_for(lock, timeout, met);
+        waiters.fetch_sub(1u);
+        return satisfied && !closed.load();
+    }
+
+    void wake()
+    {
+        // pairs with the waiting side counting itself before checking its condition
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if(waiters.load(std::memory_order_relaxed) != 0u)
+        {
+            std::lock_guard lGuard{waitMutex};
+            changed.notify_all();
+        }
+    }
+
+    std::unique_ptr<Slot[]> slots;
+    const std::size_t mask;
+    const OverflowPolicy policy;
+    /// monotonic positions, wrapped by mask on access
+    std::atomic<std::size_t> head;
+    std::atomic<std::size_t> tail;
+    std::atomic<bool> closed;
+    std::atomic<uint32_t> waiters;
+    std::atomic<uint64_t> pushed;
+    std::atomic<uint64_t> popped;
+    std::atomic<uint64_t> droppedOldest;
+    std::atomic<uint64_t> droppedNewest;
+    std::atomic<uint64_t> blocked;
+    std::mutex waitMutex;
+    std::condition_variable changed;
+};
+
+} // namespace lidar_viewer::dev
+
+#endif //LIDAR_VIEWER_FRAMEQUEUE_H
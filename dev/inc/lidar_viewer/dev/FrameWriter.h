@@ -33,6 +33,19 @@ public:
 
 private:
 
+    /// @returns subscriber of the 3D frame broadcast if the provider has one
+    auto subscribe() const
+    {
+        if constexpr (requires { lidar.frame3dBroadcast().subscribe(); })
+        {
+            return lidar.frame3dBroadcast().subscribe();
+        }
+        else
+        {
+            return nullptr;
+        }
+    }
+
     const FrameProvider&   lidar;
     IoStream&           ioStream;
     std::atomic<bool>   stopThread;
@@ -56,19 +69,45 @@ FrameWriter<FrameProvider>::~FrameWriter() noexcept
 template <class FrameProvider>
 void FrameWriter<FrameProvider>::start()
 {
-    rxFuture = std::async([this]()
+    // a subscriber of the broadcast gets every frame from now on, even ones published while writing
+    rxFuture = std::async([this, subscriber = subscribe()]() mutable
       {
           using namespace std::chrono_literals;
           using namespace std::string_literals;
           try
           {
+              uint64_t sequence{0u};
               for( ; !stopThread.load() ; )
               {
-                  lidar.use3dFrame([this](const auto& frame)
-                                   {
-                                       ioStream.write(frame.raw(), frame.rawSize());
-                                   });
-                  std::this_thread::sleep_for(5ms);
+                  if constexpr (requires { subscriber.waitNext(5ms); })
+                  {
+                      const auto frame = subscriber.waitNext(100ms);
+                      if(frame)
+                      {
+                          ioStream.writeRecord(frame->raw(), frame->rawSize(),
+                                               frame->stamp.captureTime.time_since_epoch());
+                      }
+                  }
+                  // every frame is written once if the provider tells new frames apart
+                  else if constexpr (requires { lidar.waitFor3dFrame(sequence, 5ms); })
+                  {
+                      const auto frame = lidar.waitFor3dFrame(sequence, 100ms);
+                      if(!frame)
+                      {
+                          continue;
+                      }
+                      sequence = frame->stamp.sequence;
+                      ioStream.writeRecord(frame->raw(), frame->rawSize(),
+                                           frame->stamp.captureTime.time_since_epoch());
+                  }
+                  else
+                  {
+                      lidar.use3dFrame([this](const auto& frame)
+                                       {
+                                           ioStream.write(frame.raw(), frame.rawSize());
+                                       });
+                      std::this_thread::sleep_for(5ms);
+                  }
               }
           } catch (const std::exception& e)
           {
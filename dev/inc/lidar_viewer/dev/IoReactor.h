@@ -0,0 +1,141 @@
+#ifndef LIDAR_VIEWER_IOREACTOR_H
+#define LIDAR_VIEWER_IOREACTOR_H
+
+#include "SerialPort.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace lidar_viewer::dev
+{
+
+/// @brief epoll based reactor multiplexing any number of devices on a single thread,
+/// data received on a file descriptor is drained and handed over to its handler (e.g. CygLidarD1::feed).
+/// Handlers run without locking out registration or statistics, a slow handler delays other devices only
+class IoReactor
+{
+public:
+    /// called with data received on a file descriptor, data is valid only within the call
+    using DataHandler = std::function<void(std::span<const uint8_t>)>;
+
+    /// reads data received by a device without waiting
+    /// @returns number of bytes read, 0 if nothing was received
+    /// @throws std::runtime_error if the device hung up or failed
+    using DataReader = std::function<std::size_t(std::span<uint8_t>)>;
+
+    struct Statistics
+    {
+        /// epoll_wait calls which returned ready descriptors
+        uint64_t wakeups{};
+        /// read calls
+        uint64_t reads{};
+        uint64_t bytesRead{};
+        /// descriptors dropped after hang up or read failure
+        uint64_t devicesClosed{};
+    };
+
+    /// size of a chunk read at once
+    static constexpr std::size_t RX_CHUNK_SIZE = 64u * 1024u;
+
+    /// @brief ctor, creates the epoll instance
+    IoReactor();
+
+    /// @brief dtor, stops the reactor thread
+    ~IoReactor() noexcept;
+
+    /// @brief registers a non blocking file descriptor, descriptor stays owned by the caller
+    /// @param fd file descriptor to read from
+    /// @param handler handler of received data, called from the reactor thread,
+    /// must not add or remove descriptors
+    void add(int fd, DataHandler handler);
+
+    /// @brief registers a device read through a reader of its own, e.g. one buffering received data
+    /// @param fd file descriptor waited for, stays owned by the caller
+    /// @param reader reader of data received by the device, called from the reactor thread
+    /// @param handler handler of received data, called from the reactor thread,
+    /// must not add or remove descriptors
+    void add(int fd, DataReader reader, DataHandler handler);
+
+    /// @brief registers a serial port feeding a sink, data the port buffered already is fed
+    /// ahead of the data received next
+    /// @param serialPort serial port the device is connected to
+    /// @param sink parser of data received on the port, e.g. BasicCygLidar
+    template <typename Sink>
+    requires requires(Sink& sink, std::span<const uint8_t> data) { sink.feed(data); }
+    void add(const SerialPort& serialPort, Sink& sink)
+    {
+        add(serialPort.getFd(), [&serialPort](std::span<uint8_t> chunk) -> std::size_t
+        {
+            return serialPort.readAvailable(chunk.data(), static_cast<unsigned int>(chunk.size()));
+        }, [&sink](std::span<const uint8_t> data)
+        {
+            sink.feed(data);
+        });
+    }
+
+    /// @brief unregisters a file descriptor, once it returns the handler is not running anymore
+    /// @param fd file descriptor
+    void remove(int fd);
+
+    /// @brief waits for data and dispatches it to handlers, single iteration of the reactor loop
+    /// @param timeout maximal time to wait for data
+    /// @returns number of file descriptors data was dispatched from
+    std::size_t poll(std::chrono::milliseconds timeout);
+
+    /// start reactor thread
+    void start();
+
+    /// stop reactor thread
+    void stop();
+
+    /// @returns number of registered file descriptors
+    [[nodiscard]] std::size_t devices() const;
+
+    /// @returns counters of the reactor
+    [[nodiscard]] Statistics statistics() const;
+
+    IoReactor(const IoReactor&) = delete;
+    IoReactor& operator = (const IoReactor&) = delete;
+    IoReactor(IoReactor&&) = delete;
+    IoReactor& operator = (IoReactor&&) = delete;
+
+private:
+    struct Device
+    {
+        DataReader reader;
+        DataHandler handler;
+    };
+
+    /// @brief reads everything available on a device
+    /// @returns false if the device has to be dropped
+    bool drain(const Device& device);
+
+    void removeLocked(int fd);
+
+    int epollFd;
+    int wakeFd;
+    std::atomic<bool> stopThread;
+    std::future<void> reactorFuture;
+    /// guards devices
+    mutable std::mutex handlersMutex;
+    /// held while handlers run, removal waits for the device being handled
+    std::mutex dispatchMutex;
+    std::unordered_map<int, std::shared_ptr<const Device>> devicesByFd;
+    std::vector<uint8_t> rxChunk;
+    std::atomic<uint64_t> wakeups;
+    std::atomic<uint64_t> reads;
+    std::atomic<uint64_t> bytesRead;
+    std::atomic<uint64_t> devicesClosed;
+};
+
+} // namespace lidar_viewer::dev
+
+#endif //LIDAR_VIEWER_IOREACTOR_H
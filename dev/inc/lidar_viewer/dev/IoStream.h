@@ -37,11 +37,24 @@ struct IoStream
     /// @param millis timeout
     unsigned int read(void* ptr, unsigned int size, const std::chrono::milliseconds millis) const noexcept(false);
 
+    /// @brief reads whatever is available, waits only if nothing is
+    /// @param ptr pointer to data to read to
+    /// @param size maximal size of data to read
+    /// @param millis timeout
+    /// @returns number of bytes read
+    unsigned int readSome(void* ptr, unsigned int size, const std::chrono::milliseconds millis) const noexcept(false);
+
     /// @brief write data to an i/o stream when available
     /// @param ptr pointer to data to write
     /// @param size size of data to write
     void write(const void* ptr, unsigned int size, bool discardOutput = false) const;
 
+    /// @brief write data captured at a given time
+    /// @param ptr pointer to data to write
+    /// @param size size of data to write
+    /// @param captureTime monotonic time the data was captured at
+    void writeRecord(const void* ptr, unsigned int size, std::chrono::nanoseconds captureTime) const;
+
     /// @brief closes stream
     void close() const;
 
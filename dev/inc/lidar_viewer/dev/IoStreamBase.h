@@ -20,11 +20,32 @@ struct IoStreamBase
     /// @param millis timeout
     virtual unsigned int read(void* ptr, unsigned int size, const std::chrono::milliseconds millis) const noexcept(false) = 0;
 
+    /// @brief reads whatever is available, waits only if nothing is,
+    /// streams which cannot tell what is available read exactly size bytes
+    /// @param ptr pointer to data to read to
+    /// @param size maximal size of data to read
+    /// @param millis timeout
+    /// @returns number of bytes read
+    virtual unsigned int readSome(void* ptr, unsigned int size, const std::chrono::milliseconds millis) const noexcept(false)
+    {
+        return read(ptr, size, millis);
+    }
+
     /// @brief write data to an i/o stream when available
     /// @param ptr pointer to data to write
     /// @param size size of data to write
     virtual void write(const void* ptr, unsigned int size, bool discardOutput = false) const = 0;
 
+    /// @brief writes data captured at a given time, streams which do not keep time just write it
+    /// @param ptr pointer to data to write
+    /// @param size size of data to write
+    /// @param captureTime monotonic time the data was captured at
+    virtual void writeRecord(const void* ptr, unsigned int size, std::chrono::nanoseconds captureTime) const
+    {
+        static_cast<void>(captureTime);
+        write(ptr, size);
+    }
+
     /// @brief closes stream
     virtual void close() const = 0;
 
@@ -0,0 +1,90 @@
+#ifndef LIDAR_VIEWER_MAPPEDBINARYFILE_H
+#define LIDAR_VIEWER_MAPPEDBINARYFILE_H
+
+#include "IoStreamBase.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+
+namespace lidar_viewer::dev
+{
+
+/// @brief read only, memory mapped binary file, meant for offline replay of recorded captures,
+/// reads are served straight from the mapping, without any pacing
+class MappedBinaryFile
+        : public IoStreamBase
+{
+public:
+    /// access pattern a range of the mapping is read with
+    enum class Access : uint8_t
+    {
+        /// read once front to back, pages are read ahead and dropped behind
+        Sequential,
+        /// read soon, pages are read ahead
+        WillNeed
+    };
+
+    explicit MappedBinaryFile(const std::string& fileName);
+    ~MappedBinaryFile() noexcept override;
+
+    /// @brief NOOP, file is mapped on construction
+    void open() override;
+
+    /// @brief copies data from the mapping, never blocks
+    /// @param ptr pointer to data to read to
+    /// @param size size of data to read
+    /// @returns number of bytes read, less than size only at the end of the file
+    unsigned int read(void* ptr, unsigned int size, const std::chrono::milliseconds millis = std::chrono::milliseconds::max()) const noexcept(false) override;
+
+    /// @brief NOOP, mapping is read only, commands sent to a replayed device are discarded
+    void write(const void* ptr, unsigned int size, bool discardOutput = true) const override;
+
+    /// @brief NOOP, file is unmapped on destruction
+    void close() const noexcept override;
+
+    /// @brief hands out a view on the next bytes of the file without copying them
+    /// @param size size of the view
+    /// @returns view, shorter than size only at the end of the file
+    [[nodiscard]] std::span<const uint8_t> view(std::size_t size) const noexcept(false);
+
+    /// @brief hands out a view on the next complete frame (header, length, payload, checksum)
+    /// @returns view on the raw frame, empty if there is no valid frame header at the current position
+    [[nodiscard]] std::span<const uint8_t> nextFrame() const noexcept(false);
+
+    /// @brief advises the kernel of the access pattern of a range, a hint only, the mapping is read the same
+    /// if it fails
+    /// @param offset beginning of the range
+    /// @param size size of the range, clamped to the end of the file
+    /// @param access access pattern
+    /// @returns true if the advice was taken
+    bool advise(std::size_t offset, std::size_t size, Access access) const noexcept;
+
+    /// @returns view on the whole mapping
+    [[nodiscard]] std::span<const uint8_t> data() const noexcept;
+
+    /// @returns current read position
+    [[nodiscard]] std::size_t position() const noexcept;
+
+    /// @brief moves current read position
+    /// @param pos new position, clamped to the size of the file
+    void seek(std::size_t pos) const noexcept;
+
+    /// @returns size of the mapped file
+    [[nodiscard]] std::size_t size() const noexcept;
+
+    MappedBinaryFile(const MappedBinaryFile& ) = delete;
+    MappedBinaryFile& operator = (const MappedBinaryFile& ) = delete;
+    MappedBinaryFile(MappedBinaryFile&& ) = delete;
+    MappedBinaryFile& operator = (MappedBinaryFile&& ) = delete;
+
+private:
+    const uint8_t* mapping;
+    std::size_t mappingSize;
+    mutable std::size_t readPosition;
+};
+
+} // namespace lidar_viewer::dev
+
+#endif //LIDAR_VIEWER_MAPPEDBINARYFILE_H
@@ -5,6 +5,7 @@
 
 #include <atomic>
 #include <chrono>
+#include <stdexcept>
 #include <string>
 #include <thread>
 
@@ -27,21 +28,42 @@ public:
         stop();
     }
 
-    /// start measurement receival thread
+    /// @brief start measurement receival thread
+    /// @param mode mode of the frames read
+    /// @throws std::runtime_error if frames of both modes are requested from a provider reading frames of one mode only
     void start(PointCloudProvider::Mode mode)
     {
         using namespace std::string_literals;
         using namespace std::chrono_literals;
+        if constexpr (!requires { lidar.readAndParse(); })
+        {
+            // frames of both modes are told apart by the stream parser only
+            if(mode != PointCloudProvider::Mode::Mode3D && mode != PointCloudProvider::Mode::Mode2D)
+            {
+                throw std::runtime_error{"PointCloudReader : provider reads frames of one mode only"};
+            }
+        }
         rxFuture = std::async([this, mode]()
           {
               try
               {
+                  // reads block until data arrives or time out, consumers are notified of every published frame,
+                  // so there is nothing to sleep for
                   for( ; !stopThread.load() ; )
                   {
-                      mode == PointCloudProvider::Mode::Mode3D ? lidar.readAndParse3dFrame()
-                                       : mode == PointCloudProvider::Mode::Mode2D ? lidar.readAndParse2dFrame()
-                                       : (void)mode; // TODO: dual mode
-                      std::this_thread::sleep_for(2ms);
+                      if constexpr (requires { lidar.readAndParse(); })
+                      {
+                          // stream parser resynchronizes on corrupted data and takes frames of any mode
+                          lidar.readAndParse();
+                      }
+                      else if(mode == PointCloudProvider::Mode::Mode3D)
+                      {
+                          lidar.readAndParse3dFrame();
+                      }
+                      else
+                      {
+                          lidar.readAndParse2dFrame();
+                      }
                   }
               }
               catch (std::exception const & e)
@@ -0,0 +1,69 @@
+#ifndef LIDAR_VIEWER_RECORDCODEC_H
+#define LIDAR_VIEWER_RECORDCODEC_H
+
+#include "CygLidarD1.h"
+#include "DepthCodec.h"
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace lidar_viewer::dev::recording
+{
+
+/// layout of a record of a recording compressed with a depth codec:
+/// one byte tag, then for a 3D frame the payload type byte, the checksum and the encoded depths,
+/// for anything else (2D frames, partial frames, garbage) the data stored as is
+/// records of recordings using CodecId::Raw carry no tag, they are stored as is
+
+/// @brief compresses records of a recording, 3D frames go through the depth codec
+class RecordEncoder
+{
+public:
+    /// @brief ctor
+    /// @param codecId codec used for depths of 3D frames
+    explicit RecordEncoder(codec::CodecId codecId);
+
+    /// @brief encodes a record, records have to be encoded in the order they are stored
+    /// @param record raw record
+    /// @returns encoded record, valid until next call
+    std::span<const uint8_t> encode(std::span<const uint8_t> record);
+
+private:
+    std::unique_ptr<codec::DepthCodec> codec;
+    CygLidarD1::PointCloud3D depths;
+    std::vector<uint8_t> encoded;
+};
+
+/// @brief restores raw records from records encoded by RecordEncoder
+class RecordDecoder
+{
+public:
+    /// @brief ctor
+    /// @param codecId codec used for depths of 3D frames
+    explicit RecordDecoder(codec::CodecId codecId);
+
+    /// @brief decodes a record, records have to be decoded in the order they were encoded,
+    /// starting at a keyframe
+    /// @param record encoded record
+    /// @returns raw record, valid until next call
+    std::span<const uint8_t> decode(std::span<const uint8_t> record) noexcept(false);
+
+    /// @param record encoded record
+    /// @returns true if record is a 3D frame which can be decoded without decoding any preceding record,
+    /// that is decoding may start at it
+    [[nodiscard]] bool keyframe(std::span<const uint8_t> record) const noexcept;
+
+    /// @brief drops the state of the codec, next decoded record has to be a keyframe
+    void reset() noexcept;
+
+private:
+    std::unique_ptr<codec::DepthCodec> codec;
+    CygLidarD1::PointCloud3D depths;
+    std::vector<uint8_t> decoded;
+};
+
+} // namespace lidar_viewer::dev::recording
+
+#endif //LIDAR_VIEWER_RECORDCODEC_H
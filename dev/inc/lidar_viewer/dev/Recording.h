@@ -0,0 +1,99 @@
+#ifndef LIDAR_VIEWER_RECORDING_H
+#define LIDAR_VIEWER_RECORDING_H
+
+#include "CygLidarD1.h"
+#include "DepthCodec.h"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+namespace lidar_viewer::dev::recording
+{
+
+/// layout of a timestamped recording:
+/// FileHeader, then for every recorded frame a RecordHeader followed by RecordHeader::size bytes of frame,
+/// raw or encoded by the codec given in the header (see RecordCodec.h),
+/// then an index of all records (IndexEntry each) closed by an IndexFooter
+/// recordings which were not closed properly have no index, it is then rebuilt by hopping over record headers
+/// files without the magic are treated as legacy recordings, a flat concatenation of raw frames
+
+constexpr std::array<uint8_t, 8> fileMagic{'C', 'Y', 'G', 'L', 'R', 'E', 'C', '\0'};
+constexpr std::array<uint8_t, 8> indexMagic{'C', 'Y', 'G', 'L', 'I', 'D', 'X', '\0'};
+constexpr uint16_t formatVersion = 3u;
+
+/// assumed cadence of legacy recordings, which carry no timestamps
+constexpr std::chrono::milliseconds legacyFramePeriod{20};
+
+/// description of the device and its configuration at the time of recording
+struct RecordingInfo
+{
+    uint8_t mode{};
+    uint8_t baudRate{};
+    uint8_t frequencyChannel{};
+    uint8_t sensitivity{};
+    uint16_t pulseDuration{};
+    uint16_t width{};
+    uint16_t height{};
+    /// size of payload of the recorded data frames
+    uint16_t frameSize{};
+} __attribute__((packed));
+
+struct FileHeader
+{
+    std::array<uint8_t, 8> magic{fileMagic};
+    uint16_t version{formatVersion};
+    uint16_t headerSize{sizeof(FileHeader)};
+    /// since version 2
+    RecordingInfo info{};
+    /// since version 3, codec of the recorded frames
+    codec::CodecId codec{codec::CodecId::Raw};
+} __attribute__((packed));
+
+struct RecordHeader
+{
+    /// monotonic capture time in nanoseconds
+    uint64_t captureTimeNs{};
+    /// size of the record data following the header
+    uint32_t size{};
+} __attribute__((packed));
+
+struct IndexEntry
+{
+    /// offset of the RecordHeader from the beginning of the file
+    uint64_t offset{};
+    /// monotonic capture time in nanoseconds
+    uint64_t captureTimeNs{};
+} __attribute__((packed));
+
+struct IndexFooter
+{
+    /// offset of the first IndexEntry from the beginning of the file
+    uint64_t indexOffset{};
+    uint64_t frameCount{};
+    std::array<uint8_t, 8> magic{indexMagic};
+} __attribute__((packed));
+
+/// @brief describes a recording of a lidar
+/// @param cfg configuration the lidar was set up with
+/// @param mode mode the lidar was run in
+/// @returns recording info
+inline RecordingInfo makeRecordingInfo(const CygLidarD1::Config& cfg, CygLidarD1::Mode mode)
+{
+    const auto [width, height] = CygLidarD1::get3dFrameWindow();
+    return RecordingInfo{
+            .mode = static_cast<uint8_t>(mode),
+            .baudRate = static_cast<uint8_t>(cfg.baudRate),
+            .frequencyChannel = cfg.frequencyCh,
+            .sensitivity = cfg.sensitivity,
+            .pulseDuration = cfg.pulseDuration.get(),
+            .width = static_cast<uint16_t>(width),
+            .height = static_cast<uint16_t>(mode == CygLidarD1::Mode::Mode2D ? 1u : height),
+            .frameSize = static_cast<uint16_t>(mode == CygLidarD1::Mode::Mode2D ? CygLidarD1::FRAME_SIZE_2D
+                                                                                : CygLidarD1::FRAME_SIZE_3D)
+    };
+}
+
+} // namespace lidar_viewer::dev::recording
+
+#endif //LIDAR_VIEWER_RECORDING_H
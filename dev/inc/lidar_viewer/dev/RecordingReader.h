@@ -0,0 +1,160 @@
+#ifndef LIDAR_VIEWER_RECORDINGREADER_H
+#define LIDAR_VIEWER_RECORDINGREADER_H
+
+#include "IoStreamBase.h"
+#include "MappedBinaryFile.h"
+#include "RecordCodec.h"
+#include "Recording.h"
+#include "ReplayClock.h"
+#include "StatusOr.h"
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace lidar_viewer::dev
+{
+
+/// single raw frame of a recording, data points straight into the mapped file, into storage if the frame
+/// had to be decoded for random access, or into the decoder of sequential replay
+struct RecordedFrame
+{
+    std::size_t index{};
+    std::chrono::nanoseconds captureTime{};
+    std::span<const uint8_t> data{};
+    std::shared_ptr<const std::vector<uint8_t>> storage{};
+};
+
+/// @brief read only stream replaying a recording, paced by a replay clock,
+/// handles timestamped recordings as well as legacy ones (flat concatenation of raw frames),
+/// besides sequential replay it provides random access to recorded frames
+class RecordingReader
+        : public IoStreamBase
+{
+public:
+    /// @brief ctor
+    /// @param fileName name of the recording file
+    /// @param clock clock pacing the replay
+    explicit RecordingReader(const std::string& fileName, ReplayClock clock = ReplayClock::realTime());
+    ~RecordingReader() noexcept override = default;
+
+    /// @brief NOOP, file is mapped on construction
+    void open() override;
+
+    /// @brief reads recorded data, blocks until the record being entered is due according to the replay clock
+    /// @param ptr pointer to data to read to
+    /// @param size size of data to read
+    /// @returns number of bytes read, less than size only at the end of the recording
+    unsigned int read(void* ptr, unsigned int size, const std::chrono::milliseconds millis = std::chrono::milliseconds::max()) const noexcept(false) override;
+
+    /// @brief reads the rest of the current record, or the next record when it is due
+    /// @param ptr pointer to data to read to
+    /// @param size maximal size of data to read
+    /// @returns number of bytes read
+    unsigned int readSome(void* ptr, unsigned int size, const std::chrono::milliseconds millis) const noexcept(false) override;
+
+    /// @brief NOOP, commands sent to a replayed device are discarded
+    void write(const void* ptr, unsigned int size, bool discardOutput = true) const override;
+
+    /// @brief NOOP, file is unmapped on destruction
+    void close() const noexcept override;
+
+    /// @returns true if recording carries capture timestamps
+    [[nodiscard]] bool timestamped() const noexcept;
+
+    /// @returns description of the recorded device, zeroed for legacy recordings
+    [[nodiscard]] const recording::RecordingInfo& info() const noexcept;
+
+    /// @returns codec the recorded frames are encoded with
+    [[nodiscard]] codec::CodecId frameCodec() const noexcept;
+
+    /// @returns capture time of the record currently being read
+    [[nodiscard]] std::chrono::nanoseconds captureTime() const noexcept;
+
+    /// @returns number of records entered so far, that is index of the next record to be read
+    [[nodiscard]] std::size_t recordsRead() const noexcept;
+
+    /// @returns number of frames in the recording, legacy recordings and recordings without index
+    /// are scanned once on first call
+    [[nodiscard]] std::size_t frameCount() const;
+
+    /// @brief random access to a recorded frame, does not affect sequential replay
+    /// @param frameIndex index of a frame
+    /// @returns recorded frame
+    [[nodiscard]] RecordedFrame frame(std::size_t frameIndex) const noexcept(false);
+
+    /// @brief moves sequential replay to a frame, replay clock starts a new timeline,
+    /// frames are decoded from the preceding keyframe only if the frame is not the current or the next one
+    /// @param frameIndex index of the frame to be read next
+    void seek(std::size_t frameIndex) const noexcept(false);
+
+    /// @brief steps sequential replay one frame forward, without pacing, decodes a single record
+    /// @returns next frame or BAD at the end of recording, data is valid until sequential replay moves on
+    StatusOr<RecordedFrame> next() const;
+
+    /// @brief steps sequential replay one frame backward, without pacing, decodes from the preceding keyframe
+    /// @returns frame preceding the one returned last or BAD at the beginning of recording,
+    /// data is valid until sequential replay moves on
+    StatusOr<RecordedFrame> previous() const;
+
+    /// @brief processes all frames in parallel, frames are split into contiguous chunks, one thread per chunk
+    /// @param chunks number of chunks
+    /// @param function function called for every frame, called concurrently from different chunks,
+    /// data of the frame is valid only within the call
+    void forEachChunk(std::size_t chunks, const std::function<void(const RecordedFrame&)>& function) const;
+
+    RecordingReader(const RecordingReader& ) = delete;
+    RecordingReader& operator = (const RecordingReader& ) = delete;
+    RecordingReader(RecordingReader&& ) = delete;
+    RecordingReader& operator = (RecordingReader&& ) = delete;
+
+private:
+    /// @brief enters next record and waits until it is due
+    /// @returns false at the end of the recording
+    bool nextRecord() const;
+
+    /// @returns record header at offset, or BAD if it does not fit into the recorded data
+    StatusOr<recording::RecordHeader> recordHeaderAt(std::size_t offset) const;
+
+    /// @brief builds frame index by scanning the file, if there is no index stored in it
+    void buildIndex() const;
+
+    /// @returns index entry of a frame
+    recording::IndexEntry indexEntry(std::size_t frameIndex) const;
+
+    /// @returns frame as stored in the file, possibly encoded
+    std::span<const uint8_t> storedFrame(std::size_t frameIndex) const;
+
+    /// @brief moves sequential replay to a frame the decoder is ready for
+    void moveTo(std::size_t frameIndex) const;
+
+    /// @brief brings decoder to the state in which it is able to decode a frame,
+    /// decodes frames starting at the closest preceding keyframe
+    void prime(recording::RecordDecoder& recordDecoder, std::size_t frameIndex) const;
+
+    /// @returns decoded frame, data is valid until next use of the decoder
+    RecordedFrame decodeFrame(recording::RecordDecoder& recordDecoder, std::size_t frameIndex) const;
+
+    MappedBinaryFile file;
+    mutable ReplayClock clock;
+    bool hasTimestamps;
+    recording::RecordingInfo recordingInfo;
+    codec::CodecId codecId;
+    mutable recording::RecordDecoder decoder;
+    std::size_t dataEnd;
+    std::size_t storedIndexOffset;
+    std::size_t storedIndexSize;
+    mutable bool indexed;
+    mutable std::vector<recording::IndexEntry> rebuiltIndex;
+    mutable std::span<const uint8_t> record;
+    mutable std::chrono::nanoseconds recordCaptureTime;
+    mutable std::size_t recordCount;
+};
+
+} // namespace lidar_viewer::dev
+
+#endif //LIDAR_VIEWER_RECORDINGREADER_H
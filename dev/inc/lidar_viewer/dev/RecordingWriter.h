@@ -0,0 +1,72 @@
+#ifndef LIDAR_VIEWER_RECORDINGWRITER_H
+#define LIDAR_VIEWER_RECORDINGWRITER_H
+
+#include "IoStreamBase.h"
+#include "RecordCodec.h"
+#include "Recording.h"
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace lidar_viewer::dev
+{
+
+/// @brief write only stream creating a timestamped recording,
+/// every write call is stored as a single record stamped with a monotonic capture time,
+/// index of all records is appended when the recording is closed
+class RecordingWriter
+        : public IoStreamBase
+{
+public:
+    /// @brief creates (or truncates) a recording file and writes its header
+    /// @param fileName name of the recording file
+    /// @param info description of the recorded device
+    /// @param codecId codec compressing recorded 3D frames
+    explicit RecordingWriter(const std::string& fileName, recording::RecordingInfo info = {},
+                             codec::CodecId codecId = codec::CodecId::Raw);
+
+    /// dtor, closes the recording
+    ~RecordingWriter() noexcept override;
+
+    /// @brief NOOP, file is created on construction
+    void open() override;
+
+    /// @brief not supported, recording is write only
+    unsigned int read(void* ptr, unsigned int size, const std::chrono::milliseconds millis = std::chrono::milliseconds::max()) const noexcept(false) override;
+
+    /// @brief stores data as a single record stamped with current monotonic time
+    /// @param ptr pointer to data to write
+    /// @param size size of data to write
+    void write(const void* ptr, unsigned int size, bool discardOutput = false) const override;
+
+    /// @brief stores data as a single record, encoded by the codec of the recording
+    /// @param ptr pointer to data to write
+    /// @param size size of data to write
+    /// @param captureTime monotonic capture time of the data
+    void writeRecord(const void* ptr, unsigned int size, std::chrono::nanoseconds captureTime) const override;
+
+    /// @brief appends the index of records and flushes the file, no records can be written afterwards
+    void close() const noexcept override;
+
+    /// @returns number of records written so far
+    [[nodiscard]] std::size_t recordsWritten() const noexcept;
+
+    RecordingWriter(const RecordingWriter& ) = delete;
+    RecordingWriter& operator = (const RecordingWriter& ) = delete;
+    RecordingWriter(RecordingWriter&& ) = delete;
+    RecordingWriter& operator = (RecordingWriter&& ) = delete;
+
+private:
+    mutable std::ofstream fStream;
+    mutable recording::RecordEncoder encoder;
+    mutable std::vector<recording::IndexEntry> index;
+    mutable uint64_t writeOffset;
+    mutable bool closed;
+};
+
+} // namespace lidar_viewer::dev
+
+#endif //LIDAR_VIEWER_RECORDINGWRITER_H
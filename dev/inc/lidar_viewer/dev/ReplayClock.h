@@ -0,0 +1,47 @@
+#ifndef LIDAR_VIEWER_REPLAYCLOCK_H
+#define LIDAR_VIEWER_REPLAYCLOCK_H
+
+#include <chrono>
+
+namespace lidar_viewer::dev
+{
+
+/// @brief paces replay of recorded frames according to their capture timestamps
+class ReplayClock
+{
+public:
+    /// @brief ctor
+    /// @param speed multiple of the original cadence, 1.0 replays in real time,
+    ///        0 (or less) replays as fast as possible
+    explicit ReplayClock(double speed = 1.0);
+
+    /// @returns clock replaying at the original cadence
+    static ReplayClock realTime();
+
+    /// @returns clock which never waits
+    static ReplayClock unthrottled();
+
+    /// @brief blocks until the frame captured at captureTime is due,
+    /// first call anchors the recording timeline to the wall clock
+    /// @param captureTime monotonic capture timestamp of a frame
+    void waitFor(std::chrono::nanoseconds captureTime);
+
+    /// @brief drops the anchor, next waitFor call starts a new timeline
+    void reset() noexcept;
+
+    /// @returns replay speed, 0 if unthrottled
+    [[nodiscard]] double speed() const noexcept;
+
+    /// @returns false if the clock never waits
+    [[nodiscard]] bool throttled() const noexcept;
+
+private:
+    double replaySpeed;
+    bool anchored;
+    std::chrono::steady_clock::time_point wallAnchor;
+    std::chrono::nanoseconds captureAnchor;
+};
+
+} // namespace lidar_viewer::dev
+
+#endif //LIDAR_VIEWER_REPLAYCLOCK_H
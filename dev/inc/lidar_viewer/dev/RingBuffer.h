@@ -0,0 +1,77 @@
+#ifndef LIDAR_VIEWER_RINGBUFFER_H
+#define LIDAR_VIEWER_RINGBUFFER_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace lidar_viewer::dev
+{
+
+/// @brief single threaded byte ring buffer, filled straight from the kernel (see writableRegions)
+/// and drained by copying into the frames being parsed
+class RingBuffer
+{
+public:
+    /// up to two contiguous regions, second is empty unless the region wraps around
+    using Regions = std::array<std::span<uint8_t>, 2u>;
+    using ConstRegions = std::array<std::span<const uint8_t>, 2u>;
+
+    /// @brief ctor
+    /// @param capacity capacity of the buffer, rounded up to a power of two
+    explicit RingBuffer(std::size_t capacity);
+
+    /// @returns number of bytes stored
+    [[nodiscard]] std::size_t size() const noexcept;
+
+    /// @returns number of bytes which can be stored
+    [[nodiscard]] std::size_t capacity() const noexcept;
+
+    /// @returns number of bytes which can be stored before the buffer is full
+    [[nodiscard]] std::size_t freeSpace() const noexcept;
+
+    /// @returns true if no bytes are stored
+    [[nodiscard]] bool empty() const noexcept;
+
+    /// @brief copies stored bytes and consumes them
+    /// @param ptr pointer to data to read to
+    /// @param size maximal number of bytes to read
+    /// @returns number of bytes read
+    std::size_t read(void* ptr, std::size_t size) noexcept;
+
+    /// @brief copies bytes into the buffer
+    /// @param ptr pointer to data to write
+    /// @param size number of bytes to write
+    /// @returns number of bytes written, less than size if the buffer gets full
+    std::size_t write(const void* ptr, std::size_t size) noexcept;
+
+    /// @returns free space of the buffer, to be filled and committed
+    [[nodiscard]] Regions writableRegions() noexcept;
+
+    /// @brief marks bytes written into writable regions as stored
+    /// @param size number of bytes written
+    void commit(std::size_t size) noexcept;
+
+    /// @returns stored bytes, without consuming them
+    [[nodiscard]] ConstRegions readableRegions() const noexcept;
+
+    /// @brief drops stored bytes
+    /// @param size number of bytes to drop
+    void consume(std::size_t size) noexcept;
+
+    /// @brief drops all stored bytes
+    void clear() noexcept;
+
+private:
+    std::vector<uint8_t> storage;
+    std::size_t mask;
+    /// monotonic positions, wrapped by mask on access
+    std::size_t head;
+    std::size_t tail;
+};
+
+} // namespace lidar_viewer::dev
+
+#endif //LIDAR_VIEWER_RINGBUFFER_H
@@ -0,0 +1,53 @@
+#ifndef LIDAR_VIEWER_SENSORDESCRIPTOR_H
+#define LIDAR_VIEWER_SENSORDESCRIPTOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace lidar_viewer::dev
+{
+
+/// @brief compile time description of a ToF sensor speaking the CygLidar protocol,
+/// everything sized after the sensor is derived from it
+/// @tparam Width3D columns of a 3D frame
+/// @tparam Height3D rows of a 3D frame
+/// @tparam Width2D depths of a 2D frame
+/// @tparam BitsPerDepth3D bits a depth of a 3D frame is packed into
+/// @tparam HorizontalFov horizontal field of view in degrees
+/// @tparam VerticalFov vertical field of view in degrees
+template <unsigned int Width3D, unsigned int Height3D, unsigned int Width2D, unsigned int BitsPerDepth3D,
+          unsigned int HorizontalFov, unsigned int VerticalFov>
+struct SensorDescriptor
+{
+    static constexpr unsigned int WIDTH_3D = Width3D;
+    static constexpr unsigned int HEIGHT_3D = Height3D;
+    static constexpr unsigned int WIDTH_2D = Width2D;
+    static constexpr unsigned int BITS_PER_DEPTH_3D = BitsPerDepth3D;
+
+    static constexpr std::size_t DEPTHS_3D = std::size_t{Width3D} * Height3D;
+    static constexpr std::size_t DEPTHS_2D = Width2D;
+
+    /// payload sizes, payload header included, 2D frames end with two more bytes
+    static constexpr std::size_t FRAME_SIZE_3D = 1u + (DEPTHS_3D * BitsPerDepth3D + 7u) / 8u;
+    static constexpr std::size_t FRAME_SIZE_2D = 1u + 2u * DEPTHS_2D + 2u;
+
+    static constexpr float HORIZONTAL_FOV = static_cast<float>(HorizontalFov);
+    static constexpr float VERTICAL_FOV = static_cast<float>(VerticalFov);
+
+    static_assert(DEPTHS_3D > 0u && Width2D > 0u, "a sensor has depths");
+    static_assert(BitsPerDepth3D > 0u && BitsPerDepth3D <= 16u, "depths are at most 16 bit");
+
+    /// @returns columns and rows of a 3D frame
+    static constexpr std::pair<unsigned int, unsigned int> window3d() noexcept
+    {
+        return {Width3D, Height3D};
+    }
+};
+
+/// CygLidar D1, 160x60 3D frames of 12 bit depths, 120x65 degrees
+using CygLidarD1Sensor = SensorDescriptor<160u, 60u, 160u, 12u, 120u, 65u>;
+
+} // namespace lidar_viewer::dev
+
+#endif //LIDAR_VIEWER_SENSORDESCRIPTOR_H
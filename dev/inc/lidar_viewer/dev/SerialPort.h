@@ -2,18 +2,33 @@
 #define LIDAR_VIEWER_SERIALPORT_H
 
 #include "IoStreamBase.h"
+#include "RingBuffer.h"
 
+#include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <string>
 
 namespace lidar_viewer::dev
 {
 
-/// @brief simple RAII based serial port controller for unix stream
+/// @brief simple RAII based serial port controller for unix stream,
+/// received data is drained into a ring buffer, reads are served from it
 class SerialPort
         : public IoStreamBase
 {
 public:
+    /// syscall counters of the receiving side
+    struct Statistics
+    {
+        uint64_t polls{};
+        uint64_t reads{};
+        uint64_t bytesRead{};
+    };
+
+    /// default size of the receive buffer, ~200ms of data at 3Mbaud
+    static constexpr std::size_t RX_BUFFER_SIZE = 64u * 1024u;
+
     explicit SerialPort(const std::string& fileName);
     explicit SerialPort(const std::string& fileName, const unsigned int baudRate);
     ~SerialPort() noexcept override;
@@ -28,12 +43,27 @@ public:
     /// @param baudRate serial port baud rate, can be of any type, but takes into account regular types defined in termios-baud.h
     void configure(const unsigned int baudRate) const;
 
-    /// @brief tries to read data from serial port up until a certain timeout expires
+    /// @brief tries to read data from serial port up until a certain timeout expires,
+    /// buffered data is served first, then everything available is drained with a single syscall per poll
     /// @param ptr pointer to data to read from
     /// @param size size of data to read
     /// @param millis timeout
     unsigned int read(void* ptr, unsigned int size, const std::chrono::milliseconds millis = std::chrono::milliseconds::max()) const noexcept(false) override;
 
+    /// @brief serves buffered data, if there is none polls once and drains everything available
+    /// @param ptr pointer to data to read to
+    /// @param size maximal size of data to read
+    /// @param millis timeout
+    unsigned int readSome(void* ptr, unsigned int size, const std::chrono::milliseconds millis) const noexcept(false) override;
+
+    /// @brief serves buffered data, if there is none reads whatever the port received without waiting,
+    /// for ports multiplexed by IoReactor
+    /// @param ptr pointer to data to read to
+    /// @param size maximal size of data to read
+    /// @returns number of bytes read, 0 if nothing was received
+    /// @throws std::runtime_error if the port hung up or failed
+    unsigned int readAvailable(void* ptr, unsigned int size) const noexcept(false);
+
     /// @brief write data to serial port when available
     /// @param ptr pointer to data to write
     /// @param size size of data to write
@@ -46,14 +76,28 @@ public:
     /// @param fd file descriptor
     void setFd(const int fd);
 
+    /// @returns file descriptor of the port, e.g. to be multiplexed by IoReactor
+    [[nodiscard]] int getFd() const noexcept;
+
+    /// @returns syscall counters of the receiving side
+    [[nodiscard]] Statistics statistics() const noexcept;
+
     SerialPort(const SerialPort& ) = delete;
     SerialPort& operator = (const SerialPort& ) = delete;
     SerialPort(SerialPort&& ) = delete;
     SerialPort& operator = (SerialPort&& ) = delete;
 
 private:
+    /// @brief reads everything available into the receive buffer
+    /// @returns number of bytes read
+    std::size_t fill() const noexcept(false);
 
     int fd;
+    mutable RingBuffer rxBuffer;
+    /// counted by the reading thread, read by any
+    mutable std::atomic<uint64_t> polls;
+    mutable std::atomic<uint64_t> reads;
+    mutable std::atomic<uint64_t> bytesRead;
 };
 
 } // namespace lidar_viewer::dev
@@ -0,0 +1,105 @@
+#ifndef LIDAR_VIEWER_URINGSTREAM_H
+#define LIDAR_VIEWER_URINGSTREAM_H
+
+#include "IoStreamBase.h"
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace lidar_viewer::dev
+{
+
+/// @brief i/o stream keeping reads permanently queued in an io_uring against a serial port or a file,
+/// completed reads are served without any syscall, received data ends up in the frame parser through readSome,
+/// falls back to SerialPort or BinaryFile when io_uring is not available
+class UringStream
+        : public IoStreamBase
+{
+public:
+    struct Statistics
+    {
+        /// read requests handed over to the kernel
+        uint64_t submissions{};
+        /// completed read requests
+        uint64_t completions{};
+        /// io_uring_enter calls
+        uint64_t enters{};
+        /// waits for a completion
+        uint64_t waits{};
+        uint64_t bytesRead{};
+    };
+
+    /// reads queued against a file, a serial port keeps a single one to preserve order of data
+    static constexpr std::size_t FILE_QUEUE_DEPTH = 4u;
+    /// size of a single queued read
+    static constexpr std::size_t BUFFER_SIZE = 16u * 1024u;
+
+    /// @brief ctor, opens serial port
+    /// @param deviceName serial port device
+    /// @param baudRate baud rate
+    UringStream(const std::string& deviceName, unsigned int baudRate);
+
+    /// @brief ctor, opens file for reading
+    /// @param fileName file name
+    explicit UringStream(const std::string& fileName);
+
+    /// @brief dtor, cancels queued reads
+    ~UringStream() noexcept override;
+
+    /// @brief tries to open i/o stream
+    void open() override;
+
+    /// @brief reads data, waits up until a certain timeout expires
+    /// @param ptr pointer to data to read to
+    /// @param size size of data to read
+    /// @param millis timeout
+    /// @returns number of bytes read
+    unsigned int read(void* ptr, unsigned int size, const std::chrono::milliseconds millis) const noexcept(false) override;
+
+    /// @brief reads whatever was completed, waits only if nothing was
+    /// @param ptr pointer to data to read to
+    /// @param size maximal size of data to read
+    /// @param millis timeout
+    /// @returns number of bytes read
+    unsigned int readSome(void* ptr, unsigned int size, const std::chrono::milliseconds millis) const noexcept(false) override;
+
+    /// @brief write data through the underlying stream
+    /// @param ptr pointer to data to write
+    /// @param size size of data to write
+    void write(const void* ptr, unsigned int size, bool discardOutput = false) const override;
+
+    /// @brief closes stream
+    void close() const noexcept override;
+
+    /// @returns true if reads go through io_uring, false if the fallback stream is used
+    [[nodiscard]] bool usingUring() const noexcept;
+
+    /// @returns counters of the queued reads
+    [[nodiscard]] Statistics statistics() const noexcept;
+
+    /// @returns true if io_uring can be set up
+    [[nodiscard]] static bool available() noexcept;
+
+    UringStream(const UringStream& ) = delete;
+    UringStream& operator = (const UringStream& ) = delete;
+    UringStream(UringStream&& ) = delete;
+    UringStream& operator = (UringStream&& ) = delete;
+
+private:
+    class Ring;
+
+    /// @brief sets up the ring, keeps the fallback stream only when that fails
+    void setupRing(int fd, bool seekable);
+
+    /// serial port or binary file, serves writes and reads when the ring is not set up
+    std::unique_ptr<IoStreamBase> fallback;
+    std::unique_ptr<Ring> ring;
+    /// file opened for the ring, -1 if fd of the fallback stream is used
+    int ownedFd;
+};
+
+} // namespace lidar_viewer::dev
+
+#endif //LIDAR_VIEWER_URINGSTREAM_H
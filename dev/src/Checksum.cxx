@@ -0,0 +1,104 @@
+#include "lidar_viewer/dev/Checksum.h"
+
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define LIDAR_VIEWER_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+namespace lidar_viewer::dev
+{
+
+namespace
+{
+
+/// @returns XOR of the bytes of a word
+uint8_t foldWord(uint64_t word) noexcept
+{
+    word ^= word >> 32u;
+    word ^= word >> 16u;
+    word ^= word >> 8u;
+    return static_cast<uint8_t>(word);
+}
+
+/// @returns XOR of whole words, bytes left over are not taken
+uint64_t xorWords(const uint8_t* data, std::size_t words) noexcept
+{
+    // independent accumulators keep the loads in flight
+    uint64_t accumulators[4]{};
+    std::size_t word = 0u;
+    for( ; word + 4u <= words; word += 4u)
+    {
+        for(auto lane = 0u; lane < 4u; ++lane)
+        {
+            uint64_t value;
+            std::memcpy(&value, data + 8u * (word + lane), sizeof(value));
+            accumulators[lane] ^= value;
+        }
+    }
+    for( ; word < words; ++word)
+    {
+        uint64_t value;
+        std::memcpy(&value, data + 8u * word, sizeof(value));
+        accumulators[0u] ^= value;
+    }
+    return accumulators[0u] ^ accumulators[1u] ^ accumulators[2u] ^ accumulators[3u];
+}
+
+#if defined(LIDAR_VIEWER_X86_KERNELS)
+
+/// @returns XOR of whole 32 byte blocks folded to a word, bytes left over are not taken
+__attribute__((target("avx2")))
+uint64_t xorBlocksAvx2(const uint8_t* data, std::size_t blocks) noexcept
+{
+    auto first = _mm256_setzero_si256();
+    auto second = _mm256_setzero_si256();
+    std::size_t block = 0u;
+    for( ; block + 2u <= blocks; block += 2u)
+    {
+        first = _mm256_xor_si256(first, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + 32u * block)));
+        second = _mm256_xor_si256(second, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + 32u * block + 32u)));
+    }
+    if(block < blocks)
+    {
+        first = _mm256_xor_si256(first, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + 32u * block)));
+    }
+    const auto all = _mm256_xor_si256(first, second);
+    const auto half = _mm_xor_si128(_mm256_castsi256_si128(all), _mm256_extracti128_si256(all, 1));
+    return static_cast<uint64_t>(_mm_cvtsi128_si64(half)) ^ static_cast<uint64_t>(_mm_extract_epi64(half, 1));
+}
+
+#endif
+
+} // namespace
+
+uint8_t xorChecksum(std::span<const uint8_t> data) noexcept
+{
+    const auto* bytes = data.data();
+    auto size = data.size();
+    uint64_t word{0u};
+#if defined(LIDAR_VIEWER_X86_KERNELS)
+    static const auto avx2 = __builtin_cpu_supports("avx2") != 0;
+    if(avx2 && size >= 32u)
+    {
+        const auto blocks = size / 32u;
+        word = xorBlocksAvx2(bytes, blocks);
+        bytes += 32u * blocks;
+        size -= 32u * blocks;
+    }
+#endif
+    const auto words = size / 8u;
+    word ^= xorWords(bytes, words);
+    bytes += 8u * words;
+    size -= 8u * words;
+
+    auto checksum = foldWord(word);
+    for(std::size_t i = 0u; i < size; ++i)
+    {
+        checksum ^= bytes[i];
+    }
+    return checksum;
+}
+
+} // namespace lidar_viewer::dev
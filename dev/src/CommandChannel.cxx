@@ -0,0 +1,174 @@
+#include "lidar_viewer/dev/CommandChannel.h"
+#include "lidar_viewer/dev/CygLidarFrame.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace
+{
+
+/// header and length field preceding the payload of a raw frame
+constexpr std::size_t payloadOffset = lidar_viewer::dev::frameHeader.size() + 2u;
+
+}
+
+namespace lidar_viewer::dev
+{
+
+CommandChannel::CommandChannel(IoStream& ioStream_, std::chrono::milliseconds timeout_)
+: ioStream{ioStream_}
+, timeout{timeout_}
+, mutex{}
+, pending{}
+, inFlightCount{0u}
+, stats{}
+{
+    pending.reserve(MAX_IN_FLIGHT);
+}
+
+CommandChannel::~CommandChannel() noexcept
+{
+    std::lock_guard lGuard{mutex};
+    const auto now = std::chrono::steady_clock::now();
+    while(!pending.empty())
+    {
+        complete(0u, Status::Cancelled, now - pending.front().sentAt);
+    }
+}
+
+std::future<CommandChannel::Result> CommandChannel::send(std::span<const uint8_t> rawRequest)
+{
+    if(rawRequest.size() <= payloadOffset)
+    {
+        throw std::runtime_error{"CommandChannel : request without payload"};
+    }
+    std::lock_guard lGuard{mutex};
+    if(pending.size() == MAX_IN_FLIGHT)
+    {
+        throw std::runtime_error{"CommandChannel : too many requests awaiting replies"};
+    }
+    // registered before writing, the reply may arrive before write returns
+    auto& request = pending.emplace_back(Pending{rawRequest[payloadOffset], std::chrono::steady_clock::now(),
+                                                 std::nullopt, std::nullopt, {}});
+    auto result = request.result.get_future();
+    try
+    {
+        ioStream.write(rawRequest.data(), static_cast<unsigned int>(rawRequest.size()));
+    }
+    catch (...)
+    {
+        pending.pop_back();
+        throw ;
+    }
+    inFlightCount.store(pending.size());
+    ++stats.sent;
+    return result;
+}
+
+bool CommandChannel::reply(std::span<const uint8_t> rawFrame)
+{
+    if(rawFrame.size() <= payloadOffset)
+    {
+        return false;
+    }
+    const auto type = rawFrame[payloadOffset];
+    std::lock_guard lGuard{mutex};
+    const auto request = std::find_if(pending.begin(), pending.end(),
+                                      [type](const auto& p) { return p.type == type && !p.acknowledgedAt; });
+    if(request == pending.end())
+    {
+        ++stats.unmatchedReplies;
+        return false;
+    }
+    const auto now = std::chrono::steady_clock::now();
+    request->acknowledgedAt = now;
+    // complete once the effect was seen as well
+    if(request->frameAt)
+    {
+        complete(static_cast<std::size_t>(request - pending.begin()), Status::Acknowledged, now - request->sentAt);
+    }
+    return true;
+}
+
+void CommandChannel::frameReceived()
+{
+    if(inFlightCount.load(std::memory_order_relaxed) == 0u)
+    {
+        return ;
+    }
+    std::lock_guard lGuard{mutex};
+    const auto now = std::chrono::steady_clock::now();
+    for(auto index = pending.size(); index-- > 0u; )
+    {
+        auto& request = pending[index];
+        if(!request.frameAt)
+        {
+            request.frameAt = now;
+        }
+        if(request.acknowledgedAt)
+        {
+            complete(index, Status::Acknowledged, *request.acknowledgedAt - request.sentAt);
+        }
+    }
+}
+
+void CommandChannel::expire()
+{
+    if(inFlightCount.load(std::memory_order_relaxed) == 0u)
+    {
+        return ;
+    }
+    std::lock_guard lGuard{mutex};
+    const auto now = std::chrono::steady_clock::now();
+    // the oldest requests time out first, acknowledged ones no frame followed complete without an effect latency
+    while(!pending.empty() && now - pending.front().sentAt > timeout)
+    {
+        const auto& request = pending.front();
+        if(request.acknowledgedAt)
+        {
+            complete(0u, Status::Acknowledged, *request.acknowledgedAt - request.sentAt);
+        }
+        else
+        {
+            complete(0u, Status::Unconfirmed, now - request.sentAt);
+        }
+    }
+}
+
+std::size_t CommandChannel::inFlight() const noexcept
+{
+    return inFlightCount.load();
+}
+
+CommandChannel::Statistics CommandChannel::statistics() const
+{
+    std::lock_guard lGuard{mutex};
+    return stats;
+}
+
+void CommandChannel::complete(std::size_t index, Status status, std::chrono::steady_clock::duration latency)
+{
+    auto& request = pending[index];
+    if(status == Status::Acknowledged)
+    {
+        ++stats.acknowledged;
+        stats.lastLatency = latency;
+        stats.maxLatency = std::max(stats.maxLatency, latency);
+    }
+    else if(status == Status::Unconfirmed)
+    {
+        ++stats.unconfirmed;
+    }
+    std::optional<std::chrono::steady_clock::duration> effectLatency{};
+    if(request.frameAt)
+    {
+        effectLatency = *request.frameAt - request.sentAt;
+        stats.lastEffectLatency = *effectLatency;
+        stats.maxEffectLatency = std::max(stats.maxEffectLatency, *effectLatency);
+    }
+    request.result.set_value({status, latency, effectLatency});
+    pending.erase(pending.begin() + static_cast<std::ptrdiff_t>(index));
+    inFlightCount.store(pending.size());
+}
+
+} // namespace lidar_viewer::dev
@@ -4,9 +4,6 @@
 #include <iostream>
 #include <stdexcept>
 
-using namespace std::chrono_literals;
-using namespace std::string_literals;
-
 namespace
 {
 
@@ -23,38 +20,47 @@ enum RequestTypes
     BaudRate = 0x12u
 };
 
+lidar_viewer::dev::Req3 pulseDurationRequest(lidar_viewer::dev::CygLidarBase::PulseDuration pulseDuration)
+{
+    const auto duration = pulseDuration.get();
+    return lidar_viewer::dev::Req3({RequestTypes::SetLightPulseDuration, static_cast<uint8_t>(duration & 0xffu),
+                 static_cast<uint8_t>((duration & 0xff00u) >> 8u)});
+}
+
+template <uint16_t s>
+std::future<lidar_viewer::dev::CommandChannel::Result> send(lidar_viewer::dev::CommandChannel& commands,
+                                                            const lidar_viewer::dev::Frame<s>& request)
+{
+    return commands.send({request.raw(), request.rawSize()});
+}
 
 }
 
 namespace lidar_viewer::dev
 {
 
-CygLidarD1::PulseDuration::PulseDuration(
+CygLidarBase::PulseDuration::PulseDuration(
         PulseMode pulseMode, uint16_t duration_)
         : duration{duration_}
 {
     duration |= static_cast<uint16_t>(pulseMode);
 }
 
-CygLidarD1::PulseDuration::PulseDuration()
+CygLidarBase::PulseDuration::PulseDuration()
 : duration{static_cast<uint16_t>(PulseMode::AutoDual)}
 { }
 
-uint16_t CygLidarD1::PulseDuration::get() const
+uint16_t CygLidarBase::PulseDuration::get() const
 {
     return duration;
 }
 
-CygLidarD1::CygLidarD1(IoStream& _ioStream)
+CygLidarBase::CygLidarBase(IoStream& _ioStream)
 : ioStream{_ioStream}
-, frame3D{}
-, frame2D{}
-, pointcloud3d{}
-, pointcloud2d{}
-, failureInRead{false}
+, commands{_ioStream, COMMAND_TIMEOUT}
 { }
 
-CygLidarD1::~CygLidarD1() noexcept
+CygLidarBase::~CygLidarBase() noexcept
 {
     stop();
 }
@@ -68,7 +74,7 @@ std::ostream& operator << (std::ostream& outStream, const Frame<7>& deviceInfo)
     return outStream;
 }
 
-void CygLidarD1::printDeviceInfo()
+void CygLidarBase::printDeviceInfo()
 {
     using Resp = Frame<7u>;
     write(Req2({RequestTypes::DeviceInfo, 0x00u}), ioStream);
@@ -82,113 +88,63 @@ void CygLidarD1::printDeviceInfo()
     return ;
 }
 
-void CygLidarD1::configure(const Config cfg)
+std::vector<std::future<CommandChannel::Result>> CygLidarBase::configure(const Config cfg)
 {
-    write( Req2({RequestTypes::BaudRate, static_cast<uint8_t>(cfg.baudRate)} ), ioStream );
-    const auto pulseDuration = cfg.pulseDuration.get();
-    write( Req3({RequestTypes::SetLightPulseDuration, static_cast<uint8_t>(pulseDuration & 0xffu),
-            static_cast<uint8_t>((pulseDuration & 0xff00u) >> 8u)} ), ioStream );
-    write( Req2({RequestTypes::SetFreqChannel, static_cast<uint8_t>(cfg.frequencyCh)} ), ioStream );
-    write( Req2({RequestTypes::SetSensitivity, static_cast<uint8_t>(cfg.sensitivity)} ), ioStream );
+    // sent through the channel, so their replies are matched like those of requests sent while streaming
+    std::vector<std::future<CommandChannel::Result>> results;
+    results.push_back(send(commands, Req2({RequestTypes::BaudRate, static_cast<uint8_t>(cfg.baudRate)})));
+    for(auto& result : reconfigure(cfg))
+    {
+        results.push_back(std::move(result));
+    }
+    return results;
 }
 
-void CygLidarD1::run(Mode mode)
+void CygLidarBase::run(Mode mode)
 {
     write(Req2( {static_cast<uint8_t>(mode), 0x00u} ), ioStream);
 }
 
-void CygLidarD1::readAndParse3dFrame()
+uint16_t CygLidarBase::payloadLength(std::span<const uint8_t> rawFrame) noexcept
 {
-    std::lock_guard lGuard{rwMutex};
-    auto parsingFunction = [](auto& pointCloud, const auto& returnedPayload )
-    {
-        auto frame3dIt = pointCloud.begin();
-        auto returnedFrameIt = (returnedPayload->begin())+1;
-        for ( ; frame3dIt != pointCloud.end() && returnedFrameIt != returnedPayload->end();
-                ++frame3dIt, ++returnedFrameIt )
-        {
-            const auto firstEl = *returnedFrameIt;
-            const auto secondEl = *(++returnedFrameIt);
-            const auto thirdEl = *(++returnedFrameIt);
-
-            *frame3dIt = firstEl;
-            *frame3dIt |= ((secondEl & 0xfu) << 8u);
-            frame3dIt++;
-            *frame3dIt = ((secondEl & 0xf0u) >> 4u);
-            *frame3dIt |= (thirdEl << 4u);
-        }
-    };
-    readAndParseFrame(frame3D, parsingFunction, pointcloud3d);
-}
-
-void CygLidarD1::readAndParse2dFrame()
-{
-    std::lock_guard lGuard{rwMutex};
-    auto parsingFunction = [](auto& pointCloud, const auto& returnedPayload )
-    {
-        auto frame2dIt = pointCloud.begin();
-        auto returnedFrameIt = (returnedPayload->begin())+1;
-        for ( ; frame2dIt != pointCloud.end() && returnedFrameIt != returnedPayload->end();
-                ++frame2dIt, ++returnedFrameIt )
-        {
-            const auto firstEl = *returnedFrameIt;
-            const auto secondEl = *(++returnedFrameIt);
-
-            *frame2dIt = firstEl;
-            *frame2dIt |= ((secondEl & 0xfu) << 8u);
-        }
-    };
-    readAndParseFrame( frame2D , parsingFunction, pointcloud2d);
+    const auto offset = frameHeader.size();
+    return static_cast<uint16_t>(rawFrame[offset] | (rawFrame[offset + 1u] << 8u));
 }
 
-void CygLidarD1::use2dPointCloud(CygLidarD1::PointCloud2DAccessorFunction&& accessor2d) const
+void CygLidarBase::stop()
 {
-    std::lock_guard lGuard{rwMutex};
-    if(!accessor2d)
-    {
-        return ;
-    }
-    accessor2d(pointcloud2d);
+    write(Req2( {0x02, 0x00u} ),ioStream);
 }
 
-void CygLidarD1::use3dPointCloud(CygLidarD1::PointCloud3DAccessorFunction&& accessor3d) const
+std::future<CommandChannel::Result> CygLidarBase::setPulseDuration(PulseDuration pulseDuration)
 {
-    std::lock_guard lGuard{rwMutex};
-    if (!accessor3d)
-    {
-        return;
-    }
-    accessor3d(pointcloud3d);
+    return send(commands, pulseDurationRequest(pulseDuration));
 }
 
-void CygLidarD1::stop()
+std::future<CommandChannel::Result> CygLidarBase::setFrequencyChannel(FrequencyChannel frequencyCh)
 {
-    write(Req2( {0x02, 0x00u} ),ioStream);
+    return send(commands, Req2({RequestTypes::SetFreqChannel, static_cast<uint8_t>(frequencyCh)}));
 }
 
-void CygLidarD1::use3dFrame(CygLidarD1::Frame3DAccessorFunction &&accessor3d) const
+std::future<CommandChannel::Result> CygLidarBase::setSensitivity(uint8_t sensitivity)
 {
-    std::lock_guard lGuard{rwMutex};
-    if (!accessor3d)
-    {
-        return;
-    }
-    accessor3d(frame3D);
+    return send(commands, Req2({RequestTypes::SetSensitivity, sensitivity}));
 }
 
-void CygLidarD1::use2dFrame(CygLidarD1::Frame2DAccessorFunction &&accessor2d) const
+std::vector<std::future<CommandChannel::Result>> CygLidarBase::reconfigure(const Config& cfg)
 {
-    std::lock_guard lGuard{rwMutex};
-    if(!accessor2d)
-    {
-        return ;
-    }
-    accessor2d(frame2D);
+    std::vector<std::future<CommandChannel::Result>> results;
+    results.push_back(setPulseDuration(cfg.pulseDuration));
+    results.push_back(setFrequencyChannel(cfg.frequencyCh));
+    results.push_back(setSensitivity(cfg.sensitivity));
+    return results;
 }
 
-bool CygLidarD1::failedToRead() const
+CommandChannel::Statistics CygLidarBase::commandStatistics() const
 {
-    return failureInRead.load();
+    return commands.statistics();
 }
 
+template class BasicCygLidar<CygLidarD1Sensor>;
+
 } // namespace lidar_viewer::dev
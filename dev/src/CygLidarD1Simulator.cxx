@@ -0,0 +1,343 @@
+#include "lidar_viewer/dev/CygLidarD1Simulator.h"
+#include "lidar_viewer/dev/DepthPacking.h"
+
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+using namespace std::chrono_literals;
+using namespace std::string_literals;
+
+namespace
+{
+
+/// request types as sent by CygLidarD1
+enum RequestTypes
+{
+    DeviceInfo = 0x10u,
+    Run2DMOde = 0x1u,
+    Run3DMode = 0x8u,
+    RunDualMode = 0x7u,
+    Stop = 0x2u,
+    SetLightPulseDuration = 0xCu,
+    SetFreqChannel = 0xFu,
+    SetSensitivity = 0x11u,
+    BaudRate = 0x12u
+};
+
+/// frames of a scene sent in turn
+constexpr std::size_t sceneFrames = 8u;
+constexpr std::size_t width = lidar_viewer::dev::CygLidarD1::Sensor::WIDTH_3D;
+constexpr std::size_t height = lidar_viewer::dev::CygLidarD1::Sensor::HEIGHT_3D;
+constexpr std::size_t rawPrefixSize = 5u;
+
+template <typename FrameType>
+std::vector<uint8_t> rawFrame(const typename FrameType::Payload& payload)
+{
+    const auto frame = std::make_unique<FrameType>(payload);
+    return {frame->raw(), frame->raw() + frame->rawSize()};
+}
+
+/// @brief 3D frame of a slanted wall with a box moving across
+std::vector<uint8_t> make3dFrame(std::size_t phase)
+{
+    std::vector<uint16_t> depths(width * height);
+    for(auto y = 0u; y < height; ++y)
+    {
+        for(auto x = 0u; x < width; ++x)
+        {
+            const auto inBox = x >= phase * 16u && x < phase * 16u + 32u && y >= 20u && y < 40u;
+            depths[y * width + x] = static_cast<uint16_t>(inBox ? 800u : 2000u + x * 8u + y * 4u);
+        }
+    }
+    auto payload = std::make_unique<lidar_viewer::dev::CygLidarD1::Frame3D::Payload>();
+    (*payload)[0u] = RequestTypes::Run3DMode;
+    lidar_viewer::dev::pack12(depths, std::span{*payload}.subspan(1u));
+    return rawFrame<lidar_viewer::dev::CygLidarD1::Frame3D>(*payload);
+}
+
+/// @brief 2D frame of a slanted wall
+std::vector<uint8_t> make2dFrame()
+{
+    lidar_viewer::dev::CygLidarD1::Frame2D::Payload payload{};
+    payload[0u] = RequestTypes::Run2DMOde;
+    for(auto x = 0u; x < width; ++x)
+    {
+        const auto depth = static_cast<uint16_t>(2000u + x * 8u);
+        payload[1u + 2u * x] = static_cast<uint8_t>(depth & 0xffu);
+        payload[2u + 2u * x] = static_cast<uint8_t>(depth >> 8u);
+    }
+    return rawFrame<lidar_viewer::dev::CygLidarD1::Frame2D>(payload);
+}
+
+}
+
+namespace lidar_viewer::dev
+{
+
+CygLidarD1Simulator::CygLidarD1Simulator()
+: CygLidarD1Simulator(Config{})
+{ }
+
+CygLidarD1Simulator::CygLidarD1Simulator(Config cfg)
+: config{cfg}
+, master{::posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC)}
+, requestParser{16u}
+, rxChunk{}
+, frames3d{}
+, frame2d{make2dFrame()}
+, nextFrame3d{0u}
+, nextPeriod{}
+, wireFree{}
+, stopThread{false}
+, simulatorFuture{}
+, stateMutex{}
+, state{}
+, stats{}
+{
+    if(master < 0 || ::grantpt(master) != 0 || ::unlockpt(master) != 0)
+    {
+        const auto error = errno;
+        ::close(master);
+        throw std::runtime_error{"CygLidarD1Simulator : unable to open a pseudo terminal : "s + ::strerror(error)};
+    }
+    termios tty{};
+    if(::tcgetattr(master, &tty) == 0)
+    {
+        ::cfmakeraw(&tty);
+        (void)::tcsetattr(master, TCSANOW, &tty);
+    }
+    for(auto phase = 0u; phase < sceneFrames; ++phase)
+    {
+        frames3d.emplace_back(make3dFrame(phase));
+    }
+}
+
+CygLidarD1Simulator::~CygLidarD1Simulator() noexcept
+{
+    stop();
+    ::close(master);
+}
+
+std::string CygLidarD1Simulator::deviceName() const
+{
+    return ::ptsname(master);
+}
+
+void CygLidarD1Simulator::start()
+{
+    simulatorFuture = std::async(std::launch::async, [this]()
+    {
+        try
+        {
+            run();
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "Exception in lidar simulator operation: \n"s << e.what() << '\n';
+        }
+    });
+}
+
+void CygLidarD1Simulator::stop()
+{
+    if ( stopThread.exchange(true) )
+    {
+        return ;
+    }
+    if (simulatorFuture.valid())
+    {
+        simulatorFuture.wait();
+    }
+}
+
+CygLidarD1Simulator::Settings CygLidarD1Simulator::settings() const
+{
+    std::lock_guard lGuard{stateMutex};
+    return state;
+}
+
+CygLidarD1Simulator::Statistics CygLidarD1Simulator::statistics() const
+{
+    std::lock_guard lGuard{stateMutex};
+    return stats;
+}
+
+void CygLidarD1Simulator::run()
+{
+    const auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(1.0 / std::max(config.frameRate, 0.001)));
+    nextPeriod = std::chrono::steady_clock::now();
+    for( ; !stopThread.load() ; )
+    {
+        const auto streaming = settings().mode.has_value();
+        const auto now = std::chrono::steady_clock::now();
+        const auto timeout = streaming
+                ? std::chrono::ceil<std::chrono::milliseconds>(std::max(nextPeriod - now, std::chrono::steady_clock::duration::zero()))
+                : 100ms;
+        pollfd pfd{.fd = master, .events = POLLIN, .revents{}};
+        if(::poll(&pfd, 1, static_cast<int>(timeout.count())) < 0 && errno != EINTR)
+        {
+            throw std::runtime_error{"CygLidarD1Simulator : ::poll returned : "s + ::strerror(errno)};
+        }
+        if(pfd.revents & POLLIN)
+        {
+            receive();
+        }
+        if(pfd.revents & POLLHUP)
+        {
+            // nobody has the device open
+            std::this_thread::sleep_for(10ms);
+            nextPeriod = std::chrono::steady_clock::now();
+            continue;
+        }
+        if(!settings().mode.has_value())
+        {
+            continue;
+        }
+        if(std::chrono::steady_clock::now() < nextPeriod)
+        {
+            continue;
+        }
+        sendFrames();
+        nextPeriod += period;
+        if(const auto late = std::chrono::steady_clock::now() - nextPeriod; late > late.zero())
+        {
+            const auto missed = static_cast<uint64_t>(late / period) + 1u;
+            nextPeriod += period * missed;
+            std::lock_guard lGuard{stateMutex};
+            stats.periodsMissed += missed;
+        }
+    }
+}
+
+void CygLidarD1Simulator::receive()
+{
+    const auto rret = ::read(master, rxChunk.data(), rxChunk.size());
+    if(rret <= 0)
+    {
+        return ;
+    }
+    requestParser.feed({rxChunk.data(), static_cast<std::size_t>(rret)}, [this](std::span<const uint8_t> rawRequest)
+    {
+        handleRequest(rawRequest);
+    });
+}
+
+void CygLidarD1Simulator::handleRequest(std::span<const uint8_t> rawRequest)
+{
+    const auto payload = rawRequest.subspan(rawPrefixSize, rawRequest.size() - rawPrefixSize - 1u);
+    const auto argument = [&payload](std::size_t index) -> uint8_t
+    {
+        return index < payload.size() ? payload[index] : 0u;
+    };
+    std::unique_lock lGuard{stateMutex};
+    ++stats.requests;
+    bool acknowledge{true};
+    switch(payload[0u])
+    {
+        case RequestTypes::DeviceInfo:
+        {
+            lGuard.unlock();
+            const Frame<7u> response{config.deviceInfo};
+            send({response.raw(), response.rawSize()});
+            return ;
+        }
+        case RequestTypes::Run2DMOde:
+        case RequestTypes::Run3DMode:
+        case RequestTypes::RunDualMode:
+            if(!state.mode)
+            {
+                nextPeriod = std::chrono::steady_clock::now();
+            }
+            state.mode = static_cast<CygLidarD1::Mode>(payload[0u]);
+            acknowledge = false;
+            break;
+        case RequestTypes::Stop:
+            state.mode.reset();
+            acknowledge = false;
+            break;
+        case RequestTypes::BaudRate:
+            state.baudRate = argument(1u);
+            break;
+        case RequestTypes::SetLightPulseDuration:
+            state.pulseDuration = static_cast<uint16_t>(argument(1u) | (argument(2u) << 8u));
+            break;
+        case RequestTypes::SetFreqChannel:
+            state.frequencyChannel = argument(1u);
+            break;
+        case RequestTypes::SetSensitivity:
+            state.sensitivity = argument(1u);
+            break;
+        default:
+            std::cerr << "CygLidarD1Simulator : unknown request: " << std::to_string(payload[0u]) << "\n";
+            acknowledge = false;
+            break;
+    }
+    if(acknowledge)
+    {
+        // configuration replies echo the request type, sent in between frames, a layout assumed rather than taken from
+        // the protocol of the device, the host reports requests it matches no reply to as unconfirmed
+        lGuard.unlock();
+        const Req2 reply{{payload[0u], 0x00u}};
+        send({reply.raw(), reply.rawSize()});
+    }
+}
+
+void CygLidarD1Simulator::sendFrames()
+{
+    const auto mode = settings().mode;
+    if(!mode)
+    {
+        return ;
+    }
+    if(*mode == CygLidarD1::Mode::Mode2D || *mode == CygLidarD1::Mode::Dual)
+    {
+        send(frame2d);
+        std::lock_guard lGuard{stateMutex};
+        ++stats.frames2d;
+    }
+    if(*mode == CygLidarD1::Mode::Mode3D || *mode == CygLidarD1::Mode::Dual)
+    {
+        send(frames3d[nextFrame3d]);
+        nextFrame3d = (nextFrame3d + 1u) % frames3d.size();
+        std::lock_guard lGuard{stateMutex};
+        ++stats.frames3d;
+    }
+}
+
+std::size_t CygLidarD1Simulator::send(std::span<const uint8_t> data)
+{
+    std::size_t written{0u};
+    for(std::size_t position = 0u; position < data.size(); position += TX_CHUNK_SIZE)
+    {
+        const auto chunk = data.subspan(position, std::min(TX_CHUNK_SIZE, data.size() - position));
+        if(config.baudRate != 0u)
+        {
+            // 8N1, ten bits on the line per byte
+            const auto now = std::chrono::steady_clock::now();
+            wireFree = std::max(wireFree, now);
+            std::this_thread::sleep_until(wireFree);
+            wireFree += std::chrono::nanoseconds{chunk.size() * 10u * 1000000000ull / config.baudRate};
+        }
+        const auto wret = ::write(master, chunk.data(), chunk.size());
+        const auto chunkWritten = wret > 0 ? static_cast<std::size_t>(wret) : 0u;
+        written += chunkWritten;
+        std::lock_guard lGuard{stateMutex};
+        stats.bytesWritten += chunkWritten;
+        stats.bytesDropped += chunk.size() - chunkWritten;
+    }
+    return written;
+}
+
+} // namespace lidar_viewer::dev
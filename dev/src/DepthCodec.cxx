@@ -0,0 +1,366 @@
+#include "lidar_viewer/dev/DepthCodec.h"
+#include "lidar_viewer/dev/DepthPacking.h"
+#include "lidar_viewer/dev/DepthUnpacking.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace lidar_viewer::dev::codec
+{
+
+namespace
+{
+
+constexpr uint8_t keyframeTag = 0x00u;
+constexpr uint8_t deltaTag = 0x01u;
+
+inline uint32_t zigzag(int32_t value) noexcept
+{
+    return (static_cast<uint32_t>(value) << 1u) ^ static_cast<uint32_t>(value >> 31);
+}
+
+inline int32_t unzigzag(uint32_t value) noexcept
+{
+    return static_cast<int32_t>(value >> 1u) ^ -static_cast<int32_t>(value & 1u);
+}
+
+/// writes variable length values as nibbles, 3 bits of value and a continuation bit each
+class NibbleWriter
+{
+public:
+    explicit NibbleWriter(std::vector<uint8_t>& out_)
+    : out{out_}
+    , pending{0u}
+    , hasPending{false}
+    { }
+
+    void put(uint32_t value)
+    {
+        do
+        {
+            auto nibble = value & 0x7u;
+            value >>= 3u;
+            if(value != 0u)
+            {
+                nibble |= 0x8u;
+            }
+            putNibble(static_cast<uint8_t>(nibble));
+        } while(value != 0u);
+    }
+
+    void flush()
+    {
+        if(hasPending)
+        {
+            out.push_back(pending);
+            hasPending = false;
+        }
+    }
+
+private:
+    void putNibble(uint8_t nibble)
+    {
+        if(hasPending)
+        {
+            out.push_back(static_cast<uint8_t>(pending | nibble));
+            hasPending = false;
+            return ;
+        }
+        pending = static_cast<uint8_t>(nibble << 4u);
+        hasPending = true;
+    }
+
+    std::vector<uint8_t>& out;
+    uint8_t pending;
+    bool hasPending;
+};
+
+class NibbleReader
+{
+public:
+    explicit NibbleReader(std::span<const uint8_t> in_)
+    : in{in_}
+    , position{0u}
+    { }
+
+    uint32_t get()
+    {
+        uint32_t value{0u};
+        for(auto shift = 0u; ; shift += 3u)
+        {
+            if(shift > 30u)
+            {
+                throw std::runtime_error{"DepthCodec : malformed variable length value"};
+            }
+            const auto nibble = getNibble();
+            value |= (nibble & 0x7u) << shift;
+            if((nibble & 0x8u) == 0u)
+            {
+                return value;
+            }
+        }
+    }
+
+    /// @returns number of bytes consumed, including a partially used one
+    [[nodiscard]] std::size_t consumed() const noexcept
+    {
+        return (position + 1u) / 2u;
+    }
+
+private:
+    uint32_t getNibble()
+    {
+        const auto byte = position / 2u;
+        if(byte >= in.size())
+        {
+            throw std::runtime_error{"DepthCodec : truncated data"};
+        }
+        const auto nibble = (position % 2u) == 0u ? (in[byte] >> 4u) : (in[byte] & 0xfu);
+        ++position;
+        return nibble;
+    }
+
+    std::span<const uint8_t> in;
+    std::size_t position;
+};
+
+/// @brief RVL coding of residuals, alternating runs of zero and non zero residuals
+/// @param count number of residuals
+/// @param residual function returning residual at an index
+template <typename ResidualFunction>
+void encodeRvl(std::size_t count, ResidualFunction&& residual, std::vector<uint8_t>& encoded)
+{
+    NibbleWriter writer{encoded};
+    for(std::size_t i = 0u; i < count; )
+    {
+        const auto zerosBegin = i;
+        for( ; i < count && residual(i) == 0; ++i)
+        { }
+        writer.put(static_cast<uint32_t>(i - zerosBegin));
+
+        auto nonZerosEnd = i;
+        for( ; nonZerosEnd < count && residual(nonZerosEnd) != 0; ++nonZerosEnd)
+        { }
+        writer.put(static_cast<uint32_t>(nonZerosEnd - i));
+        for( ; i < nonZerosEnd; ++i)
+        {
+            writer.put(zigzag(residual(i)));
+        }
+    }
+    writer.flush();
+}
+
+/// @brief decodes residuals coded by encodeRvl
+/// @param count number of residuals
+/// @param apply function consuming residual at an index, called in ascending order of indices
+/// @returns number of bytes consumed
+template <typename ApplyFunction>
+std::size_t decodeRvl(std::span<const uint8_t> encoded, std::size_t count, ApplyFunction&& apply)
+{
+    NibbleReader reader{encoded};
+    for(std::size_t i = 0u; i < count; )
+    {
+        const auto zeros = reader.get();
+        const auto nonZeros = zeros <= count - i ? reader.get() : 0u;
+        if(zeros + static_cast<std::size_t>(nonZeros) > count - i)
+        {
+            throw std::runtime_error{"DepthCodec : run exceeds frame"};
+        }
+        for(const auto zerosEnd = i + zeros; i < zerosEnd; ++i)
+        {
+            apply(i, 0);
+        }
+        for(const auto nonZerosEnd = i + nonZeros; i < nonZerosEnd; ++i)
+        {
+            apply(i, unzigzag(reader.get()));
+        }
+    }
+    return reader.consumed();
+}
+
+void encodeSpatial(std::span<const uint16_t> depths, std::vector<uint8_t>& encoded)
+{
+    encodeRvl(depths.size(), [depths](std::size_t i)
+    {
+        return static_cast<int32_t>(depths[i]) - (i == 0u ? 0 : static_cast<int32_t>(depths[i - 1u]));
+    }, encoded);
+}
+
+std::size_t decodeSpatial(std::span<const uint8_t> encoded, std::span<uint16_t> depths)
+{
+    return decodeRvl(encoded, depths.size(), [depths](std::size_t i, int32_t residual)
+    {
+        const auto previousDepth = i == 0u ? 0 : static_cast<int32_t>(depths[i - 1u]);
+        depths[i] = static_cast<uint16_t>(previousDepth + residual);
+    });
+}
+
+} // namespace
+
+CodecId RawCodec::id() const noexcept
+{
+    return CodecId::Raw;
+}
+
+void RawCodec::encode(std::span<const uint16_t> depths, std::vector<uint8_t>& encoded)
+{
+    if(depths.size() % 2u != 0u)
+    {
+        throw std::runtime_error{"RawCodec::encode : odd number of depths"};
+    }
+    const auto offset = encoded.size();
+    encoded.resize(offset + depths.size() / 2u * 3u);
+    pack12(depths, std::span{encoded}.subspan(offset));
+}
+
+std::size_t RawCodec::decode(std::span<const uint8_t> encoded, std::span<uint16_t> depths) noexcept(false)
+{
+    const auto packedSize = depths.size() / 2u * 3u;
+    if(depths.size() % 2u != 0u || encoded.size() < packedSize)
+    {
+        throw std::runtime_error{"RawCodec::decode : truncated data"};
+    }
+    unpack3dDepths(encoded.first(packedSize), depths);
+    return packedSize;
+}
+
+bool RawCodec::keyframe(std::span<const uint8_t> ) const noexcept
+{
+    return true;
+}
+
+void RawCodec::reset() noexcept
+{ }
+
+CodecId RvlCodec::id() const noexcept
+{
+    return CodecId::Rvl;
+}
+
+void RvlCodec::encode(std::span<const uint16_t> depths, std::vector<uint8_t>& encoded)
+{
+    encodeSpatial(depths, encoded);
+}
+
+std::size_t RvlCodec::decode(std::span<const uint8_t> encoded, std::span<uint16_t> depths) noexcept(false)
+{
+    return decodeSpatial(encoded, depths);
+}
+
+bool RvlCodec::keyframe(std::span<const uint8_t> ) const noexcept
+{
+    return true;
+}
+
+void RvlCodec::reset() noexcept
+{ }
+
+TemporalRvlCodec::TemporalRvlCodec(unsigned int keyframeInterval_)
+: keyframeInterval{std::max(keyframeInterval_, 1u)}
+, framesSinceKeyframe{0u}
+, hasPrevious{false}
+, previous{}
+{ }
+
+CodecId TemporalRvlCodec::id() const noexcept
+{
+    return CodecId::TemporalRvl;
+}
+
+void TemporalRvlCodec::encode(std::span<const uint16_t> depths, std::vector<uint8_t>& encoded)
+{
+    const auto isKeyframe = !hasPrevious || previous.size() != depths.size()
+                            || framesSinceKeyframe + 1u >= keyframeInterval;
+    if(isKeyframe)
+    {
+        encoded.push_back(keyframeTag);
+        encodeSpatial(depths, encoded);
+        framesSinceKeyframe = 0u;
+    }
+    else
+    {
+        encoded.push_back(deltaTag);
+        encodeRvl(depths.size(), [depths, this](std::size_t i)
+        {
+            return static_cast<int32_t>(depths[i]) - static_cast<int32_t>(previous[i]);
+        }, encoded);
+        ++framesSinceKeyframe;
+    }
+    previous.assign(depths.begin(), depths.end());
+    hasPrevious = true;
+}
+
+std::size_t TemporalRvlCodec::decode(std::span<const uint8_t> encoded, std::span<uint16_t> depths) noexcept(false)
+{
+    if(encoded.empty())
+    {
+        throw std::runtime_error{"TemporalRvlCodec::decode : truncated data"};
+    }
+    std::size_t consumed{};
+    if(encoded.front() == keyframeTag)
+    {
+        consumed = decodeSpatial(encoded.subspan(1u), depths);
+    }
+    else if(encoded.front() == deltaTag)
+    {
+        if(!hasPrevious || previous.size() != depths.size())
+        {
+            throw std::runtime_error{"TemporalRvlCodec::decode : delta frame without preceding keyframe"};
+        }
+        consumed = decodeRvl(encoded.subspan(1u), depths.size(), [depths, this](std::size_t i, int32_t residual)
+        {
+            depths[i] = static_cast<uint16_t>(static_cast<int32_t>(previous[i]) + residual);
+        });
+    }
+    else
+    {
+        throw std::runtime_error{"TemporalRvlCodec::decode : unknown frame type"};
+    }
+    previous.assign(depths.begin(), depths.end());
+    hasPrevious = true;
+    return consumed + 1u;
+}
+
+bool TemporalRvlCodec::keyframe(std::span<const uint8_t> encoded) const noexcept
+{
+    return !encoded.empty() && encoded.front() == keyframeTag;
+}
+
+void TemporalRvlCodec::reset() noexcept
+{
+    framesSinceKeyframe = 0u;
+    hasPrevious = false;
+}
+
+std::unique_ptr<DepthCodec> makeDepthCodec(CodecId id)
+{
+    switch(id)
+    {
+        case CodecId::Raw:
+            return std::make_unique<RawCodec>();
+        case CodecId::Rvl:
+            return std::make_unique<RvlCodec>();
+        case CodecId::TemporalRvl:
+            return std::make_unique<TemporalRvlCodec>();
+    }
+    throw std::runtime_error{"Unknown depth codec : " + std::to_string(static_cast<unsigned int>(id))};
+}
+
+CodecId codecIdFromName(const std::string& name) noexcept(false)
+{
+    if(name == "raw")
+    {
+        return CodecId::Raw;
+    }
+    if(name == "rvl")
+    {
+        return CodecId::Rvl;
+    }
+    if(name == "delta")
+    {
+        return CodecId::TemporalRvl;
+    }
+    throw std::runtime_error{"Unknown depth codec : " + name};
+}
+
+} // namespace lidar_viewer::dev::codec
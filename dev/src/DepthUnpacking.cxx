@@ -0,0 +1,177 @@
+#include "lidar_viewer/dev/DepthUnpacking.h"
+#include "lidar_viewer/dev/DepthPacking.h"
+
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define LIDAR_VIEWER_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+namespace lidar_viewer::dev
+{
+
+namespace
+{
+
+/// depth pairs two spans allow
+std::size_t pairs3d(std::span<const uint8_t> packed, std::span<uint16_t> depths) noexcept
+{
+    return std::min(packed.size() / 3u, depths.size() / 2u);
+}
+
+std::size_t depths2d(std::span<const uint8_t> packed, std::span<uint16_t> depths) noexcept
+{
+    return std::min(packed.size() / 2u, depths.size());
+}
+
+void unpack2dScalar(const uint8_t* packed, uint16_t* depths, std::size_t count) noexcept
+{
+    for(std::size_t i = 0u; i < count; ++i)
+    {
+        depths[i] = static_cast<uint16_t>(packed[2u * i] | ((packed[2u * i + 1u] & 0xfu) << 8u));
+    }
+}
+
+#if defined(LIDAR_VIEWER_X86_KERNELS)
+
+// every 16 bit lane takes the two bytes a depth is spread over, even lanes keep the lower 12 bits,
+// odd lanes are shifted right by a nibble
+__attribute__((target("ssse3")))
+std::size_t unpack3dSsse3(const uint8_t* packed, std::size_t packedSize, uint16_t* depths, std::size_t pairs) noexcept
+{
+    const auto shuffle = _mm_setr_epi8(0, 1, 1, 2, 3, 4, 4, 5, 6, 7, 7, 8, 9, 10, 10, 11);
+    const auto evenMask = _mm_setr_epi16(0x0fff, 0, 0x0fff, 0, 0x0fff, 0, 0x0fff, 0);
+    const auto oddMask = _mm_setr_epi16(0, 0x0fff, 0, 0x0fff, 0, 0x0fff, 0, 0x0fff);
+    std::size_t pair = 0u;
+    // 12 bytes make 8 depths, a whole vector is loaded
+    for( ; pair + 4u <= pairs && 3u * pair + 16u <= packedSize; pair += 4u)
+    {
+        const auto raw = _mm_loadu_si128(reinterpret_cast<const __m128i*>(packed + 3u * pair));
+        const auto lanes = _mm_shuffle_epi8(raw, shuffle);
+        const auto result = _mm_or_si128(_mm_and_si128(lanes, evenMask),
+                                         _mm_and_si128(_mm_srli_epi16(lanes, 4), oddMask));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(depths + 2u * pair), result);
+    }
+    return pair;
+}
+
+__attribute__((target("avx2")))
+std::size_t unpack3dAvx2(const uint8_t* packed, std::size_t packedSize, uint16_t* depths, std::size_t pairs) noexcept
+{
+    const auto shuffle = _mm256_setr_epi8(0, 1, 1, 2, 3, 4, 4, 5, 6, 7, 7, 8, 9, 10, 10, 11,
+                                          0, 1, 1, 2, 3, 4, 4, 5, 6, 7, 7, 8, 9, 10, 10, 11);
+    const auto evenMask = _mm256_setr_epi16(0x0fff, 0, 0x0fff, 0, 0x0fff, 0, 0x0fff, 0,
+                                            0x0fff, 0, 0x0fff, 0, 0x0fff, 0, 0x0fff, 0);
+    const auto oddMask = _mm256_setr_epi16(0, 0x0fff, 0, 0x0fff, 0, 0x0fff, 0, 0x0fff,
+                                           0, 0x0fff, 0, 0x0fff, 0, 0x0fff, 0, 0x0fff);
+    std::size_t pair = 0u;
+    // shuffles stay within 128 bit lanes, each lane gets 12 bytes making 8 depths
+    for( ; pair + 8u <= pairs && 3u * pair + 28u <= packedSize; pair += 8u)
+    {
+        const auto low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(packed + 3u * pair));
+        const auto high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(packed + 3u * pair + 12u));
+        const auto raw = _mm256_inserti128_si256(_mm256_castsi128_si256(low), high, 1);
+        const auto lanes = _mm256_shuffle_epi8(raw, shuffle);
+        const auto result = _mm256_or_si256(_mm256_and_si256(lanes, evenMask),
+                                            _mm256_and_si256(_mm256_srli_epi16(lanes, 4), oddMask));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(depths + 2u * pair), result);
+    }
+    return pair;
+}
+
+// 2D depths are little endian 16 bit words, masking is all there is to do
+__attribute__((target("ssse3")))
+std::size_t unpack2dSsse3(const uint8_t* packed, uint16_t* depths, std::size_t count) noexcept
+{
+    const auto mask = _mm_set1_epi16(0x0fff);
+    std::size_t i = 0u;
+    for( ; i + 8u <= count; i += 8u)
+    {
+        const auto raw = _mm_loadu_si128(reinterpret_cast<const __m128i*>(packed + 2u * i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(depths + i), _mm_and_si128(raw, mask));
+    }
+    return i;
+}
+
+__attribute__((target("avx2")))
+std::size_t unpack2dAvx2(const uint8_t* packed, uint16_t* depths, std::size_t count) noexcept
+{
+    const auto mask = _mm256_set1_epi16(0x0fff);
+    std::size_t i = 0u;
+    for( ; i + 16u <= count; i += 16u)
+    {
+        const auto raw = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(packed + 2u * i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(depths + i), _mm256_and_si256(raw, mask));
+    }
+    return i;
+}
+
+#endif
+
+} // namespace
+
+bool unpackKernelSupported(UnpackKernel kernel) noexcept
+{
+    switch(kernel)
+    {
+#if defined(LIDAR_VIEWER_X86_KERNELS)
+        case UnpackKernel::Ssse3:
+            return __builtin_cpu_supports("ssse3");
+        case UnpackKernel::Avx2:
+            return __builtin_cpu_supports("avx2");
+#endif
+        case UnpackKernel::Scalar:
+            return true;
+        default:
+            return false;
+    }
+}
+
+UnpackKernel bestUnpackKernel() noexcept
+{
+    static const auto best = unpackKernelSupported(UnpackKernel::Avx2) ? UnpackKernel::Avx2
+                           : unpackKernelSupported(UnpackKernel::Ssse3) ? UnpackKernel::Ssse3
+                           : UnpackKernel::Scalar;
+    return best;
+}
+
+void unpack3dDepths(std::span<const uint8_t> packed, std::span<uint16_t> depths, UnpackKernel kernel) noexcept
+{
+    const auto pairs = pairs3d(packed, depths);
+    std::size_t done{0u};
+#if defined(LIDAR_VIEWER_X86_KERNELS)
+    if(kernel == UnpackKernel::Avx2 && unpackKernelSupported(kernel))
+    {
+        done = unpack3dAvx2(packed.data(), packed.size(), depths.data(), pairs);
+    }
+    if(kernel != UnpackKernel::Scalar && unpackKernelSupported(UnpackKernel::Ssse3))
+    {
+        done += unpack3dSsse3(packed.data() + 3u * done, packed.size() - 3u * done, depths.data() + 2u * done, pairs - done);
+    }
+#else
+    (void)kernel;
+#endif
+    unpack12(packed.subspan(3u * done, 3u * (pairs - done)), depths.subspan(2u * done, 2u * (pairs - done)));
+}
+
+void unpack2dDepths(std::span<const uint8_t> packed, std::span<uint16_t> depths, UnpackKernel kernel) noexcept
+{
+    const auto count = depths2d(packed, depths);
+    std::size_t done{0u};
+#if defined(LIDAR_VIEWER_X86_KERNELS)
+    if(kernel == UnpackKernel::Avx2 && unpackKernelSupported(kernel))
+    {
+        done = unpack2dAvx2(packed.data(), depths.data(), count);
+    }
+    if(kernel != UnpackKernel::Scalar && unpackKernelSupported(UnpackKernel::Ssse3))
+    {
+        done += unpack2dSsse3(packed.data() + 2u * done, depths.data() + done, count - done);
+    }
+#else
+    (void)kernel;
+#endif
+    unpack2dScalar(packed.data() + 2u * done, depths.data() + done, count - done);
+}
+
+} // namespace lidar_viewer::dev
@@ -0,0 +1,133 @@
+#include "lidar_viewer/dev/DepthValidity.h"
+#include "lidar_viewer/dev/CygLidarD1.h"
+
+#include <algorithm>
+#include <bit>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define LIDAR_VIEWER_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+namespace lidar_viewer::dev
+{
+
+namespace
+{
+
+using ErrorCodes3D = CygLidarD1::ErrorCodes3D;
+using ErrorCodes2D = CygLidarD1::ErrorCodes2D;
+
+constexpr auto lowAmplitude = static_cast<uint16_t>(ErrorCodes3D::LowAmplitude);
+constexpr auto adcOverflow = static_cast<uint16_t>(ErrorCodes3D::AdcOverflow);
+constexpr auto saturation = static_cast<uint16_t>(ErrorCodes3D::Saturation);
+constexpr auto firstErrorCode2d = static_cast<uint16_t>(ErrorCodes2D::LowAmplitude);
+constexpr auto lastErrorCode2d = static_cast<uint16_t>(ErrorCodes2D::BadPixel);
+
+/// @brief classifies depths one at a time, without branching on them
+void classifyScalar(const uint16_t* depths, std::size_t count, uint16_t minDepth, uint16_t maxDepth,
+                    uint64_t* mask, Depth3DCounts& counts) noexcept
+{
+    const auto span = static_cast<uint16_t>(maxDepth - minDepth);
+    for(std::size_t i = 0u; i < count; ++i)
+    {
+        const auto depth = depths[i];
+        const auto valid = static_cast<uint16_t>(depth - minDepth) <= span;
+        mask[i / 64u] |= static_cast<uint64_t>(valid) << (i % 64u);
+        counts.lowAmplitude += depth == lowAmplitude;
+        counts.adcOverflow += depth == adcOverflow;
+        counts.saturation += depth == saturation;
+    }
+}
+
+#if defined(LIDAR_VIEWER_X86_KERNELS)
+
+/// @returns number of depths equal to a code in two vectors of depths
+__attribute__((target("avx2")))
+inline uint32_t countEqual(__m256i low, __m256i high, __m256i code) noexcept
+{
+    const auto equal = _mm256_packs_epi16(_mm256_cmpeq_epi16(low, code), _mm256_cmpeq_epi16(high, code));
+    return static_cast<uint32_t>(std::popcount(static_cast<uint32_t>(_mm256_movemask_epi8(equal))));
+}
+
+/// @brief classifies 32 depths, a depth is valid if clamping it to the range leaves it unchanged
+/// @returns 32 bits of a mask word
+__attribute__((target("avx2")))
+inline uint64_t classify32(const uint16_t* block, __m256i lower, __m256i upper, Depth3DCounts& counts) noexcept
+{
+    const auto low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+    const auto high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 16u));
+    const auto validLow = _mm256_cmpeq_epi16(_mm256_min_epu16(_mm256_max_epu16(low, lower), upper), low);
+    const auto validHigh = _mm256_cmpeq_epi16(_mm256_min_epu16(_mm256_max_epu16(high, lower), upper), high);
+    // packing interleaves 128 bit lanes, permuting restores the order of depths
+    const auto valid = _mm256_permute4x64_epi64(_mm256_packs_epi16(validLow, validHigh), 0xd8);
+    counts.lowAmplitude += countEqual(low, high, _mm256_set1_epi16(static_cast<short>(lowAmplitude)));
+    counts.adcOverflow += countEqual(low, high, _mm256_set1_epi16(static_cast<short>(adcOverflow)));
+    counts.saturation += countEqual(low, high, _mm256_set1_epi16(static_cast<short>(saturation)));
+    return static_cast<uint32_t>(_mm256_movemask_epi8(valid));
+}
+
+/// @returns number of depths classified, whole blocks of 64 depths making a mask word
+__attribute__((target("avx2")))
+std::size_t classifyAvx2(const uint16_t* depths, std::size_t count, uint16_t minDepth, uint16_t maxDepth,
+                         uint64_t* mask, Depth3DCounts& counts) noexcept
+{
+    const auto lower = _mm256_set1_epi16(static_cast<short>(minDepth));
+    const auto upper = _mm256_set1_epi16(static_cast<short>(maxDepth));
+    std::size_t word = 0u;
+    for( ; 64u * (word + 1u) <= count; ++word)
+    {
+        mask[word] = classify32(depths + 64u * word, lower, upper, counts)
+                   | (classify32(depths + 64u * word + 32u, lower, upper, counts) << 32u);
+    }
+    return 64u * word;
+}
+
+#endif
+
+} // namespace
+
+Depth3DCounts classify3dDepths(std::span<const uint16_t> depths, uint16_t minDepth, uint16_t maxDepth,
+                               std::span<uint64_t> mask) noexcept
+{
+    const auto count = std::min(depths.size(), 64u * mask.size());
+    maxDepth = std::min<uint16_t>(maxDepth, lowAmplitude - 1u);
+    std::fill(mask.begin(), mask.end(), 0u);
+    Depth3DCounts counts{};
+    std::size_t done{0u};
+#if defined(LIDAR_VIEWER_X86_KERNELS)
+    static const auto avx2 = __builtin_cpu_supports("avx2") != 0;
+    if(avx2)
+    {
+        done = classifyAvx2(depths.data(), count, minDepth, maxDepth, mask.data(), counts);
+    }
+#endif
+    // mask words of the scalar part start at a word boundary
+    classifyScalar(depths.data() + done, count - done, minDepth, maxDepth, mask.data() + done / 64u, counts);
+
+    for(const auto word : mask)
+    {
+        counts.valid += static_cast<uint32_t>(std::popcount(word));
+    }
+    counts.outOfRange = static_cast<uint32_t>(count) - counts.valid
+                      - counts.lowAmplitude - counts.adcOverflow - counts.saturation;
+    return counts;
+}
+
+uint32_t restore2dErrorCodes(std::span<const uint8_t> packed, std::span<uint16_t> depths) noexcept
+{
+    const auto count = std::min(packed.size() / 2u, depths.size());
+    uint32_t restored{0u};
+    for(std::size_t i = 0u; i < count; ++i)
+    {
+        const auto value = static_cast<uint16_t>(packed[2u * i] | (packed[2u * i + 1u] << 8u));
+        if(static_cast<uint16_t>(value - firstErrorCode2d) <= lastErrorCode2d - firstErrorCode2d)
+        {
+            depths[i] = value;
+            ++restored;
+        }
+    }
+    return restored;
+}
+
+} // namespace lidar_viewer::dev
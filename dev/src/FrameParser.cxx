@@ -0,0 +1,152 @@
+#include "lidar_viewer/dev/FrameParser.h"
+#include "lidar_viewer/dev/CygLidarFrame.h"
+#include "lidar_viewer/dev/Checksum.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace lidar_viewer::dev
+{
+
+namespace
+{
+
+constexpr std::size_t lengthSize = sizeof(uint16_t);
+constexpr std::size_t checksumSize = 1u;
+constexpr std::size_t prefixSize = frameHeader.size() + lengthSize;
+
+/// @returns length of the longest frame header prefix ending the data
+std::size_t partialHeaderLength(std::span<const uint8_t> data) noexcept
+{
+    for(auto length = std::min(frameHeader.size() - 1u, data.size()); length > 0u; --length)
+    {
+        if(std::equal(frameHeader.begin(), frameHeader.begin() + static_cast<std::ptrdiff_t>(length),
+                      data.end() - static_cast<std::ptrdiff_t>(length)))
+        {
+            return length;
+        }
+    }
+    return 0u;
+}
+
+} // namespace
+
+FrameParser::FrameParser(std::size_t maxPayloadSize_)
+: maxPayloadSize{maxPayloadSize_}
+, pending{}
+, desynchronized{false}
+, stats{}
+{
+    pending.reserve(prefixSize + maxPayloadSize + checksumSize);
+}
+
+void FrameParser::feed(std::span<const uint8_t> data, const FrameHandler& onFrame)
+{
+    if(pending.empty())
+    {
+        // parse straight from the received data, only the beginning of a frame gets copied
+        const auto consumed = parse(data, onFrame);
+        pending.assign(data.begin() + static_cast<std::ptrdiff_t>(consumed), data.end());
+        return ;
+    }
+    pending.insert(pending.end(), data.begin(), data.end());
+    const auto consumed = parse(pending, onFrame);
+    pending.erase(pending.begin(), pending.begin() + static_cast<std::ptrdiff_t>(consumed));
+}
+
+const FrameParser::Statistics& FrameParser::statistics() const noexcept
+{
+    return stats;
+}
+
+std::size_t FrameParser::pendingBytes() const noexcept
+{
+    return pending.size();
+}
+
+void FrameParser::reset() noexcept
+{
+    pending.clear();
+}
+
+bool FrameParser::checksumValid(std::span<const uint8_t> rawFrame) noexcept
+{
+    if(rawFrame.size() < prefixSize + checksumSize)
+    {
+        return false;
+    }
+    // XOR of the length and the whole payload, as computed by Frame::checksum
+    const auto checksummed = rawFrame.subspan(frameHeader.size(), rawFrame.size() - frameHeader.size() - checksumSize);
+    return xorChecksum(checksummed) == rawFrame.back();
+}
+
+std::size_t FrameParser::parse(std::span<const uint8_t> data, const FrameHandler& onFrame)
+{
+    std::size_t position{0u};
+    for(;;)
+    {
+        const auto remaining = data.subspan(position);
+        const auto header = std::search(remaining.begin(), remaining.end(), frameHeader.begin(), frameHeader.end());
+        if(header == remaining.end())
+        {
+            // keep what may be the beginning of a header split between calls
+            const auto garbage = remaining.size() - partialHeaderLength(remaining);
+            skip(garbage);
+            return position + garbage;
+        }
+        const auto garbage = static_cast<std::size_t>(header - remaining.begin());
+        skip(garbage);
+        position += garbage;
+
+        if(data.size() - position < prefixSize)
+        {
+            return position;
+        }
+        uint16_t length{};
+        std::memcpy(&length, data.data() + position + frameHeader.size(), sizeof(length));
+        if(length == 0u || length > maxPayloadSize)
+        {
+            // false header, resynchronize on the next one
+            ++stats.lengthErrors;
+            skip(1u);
+            ++position;
+            continue;
+        }
+        const auto rawSize = prefixSize + length + checksumSize;
+        if(data.size() - position < rawSize)
+        {
+            return position;
+        }
+        const auto rawFrame = data.subspan(position, rawSize);
+        if(!checksumValid(rawFrame))
+        {
+            ++stats.checksumErrors;
+            skip(1u);
+            ++position;
+            continue;
+        }
+        ++stats.framesParsed;
+        if(desynchronized)
+        {
+            ++stats.framesRecovered;
+            desynchronized = false;
+        }
+        position += rawSize;
+        if(onFrame)
+        {
+            onFrame(rawFrame);
+        }
+    }
+}
+
+void FrameParser::skip(std::size_t size) noexcept
+{
+    if(size == 0u)
+    {
+        return ;
+    }
+    stats.bytesSkipped += size;
+    desynchronized = true;
+}
+
+} // namespace lidar_viewer::dev
@@ -0,0 +1,243 @@
+#include "lidar_viewer/dev/IoReactor.h"
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+namespace lidar_viewer::dev
+{
+
+using namespace std::string_literals;
+
+IoReactor::IoReactor()
+: epollFd{::epoll_create1(EPOLL_CLOEXEC)}
+, wakeFd{::eventfd(0u, EFD_NONBLOCK | EFD_CLOEXEC)}
+, stopThread{false}
+, reactorFuture{}
+, handlersMutex{}
+, dispatchMutex{}
+, devicesByFd{}
+, rxChunk(RX_CHUNK_SIZE)
+, wakeups{0u}
+, reads{0u}
+, bytesRead{0u}
+, devicesClosed{0u}
+{
+    if(epollFd < 0 || wakeFd < 0)
+    {
+        const auto error = errno;
+        ::close(epollFd);
+        ::close(wakeFd);
+        throw std::runtime_error{"IoReactor : unable to create epoll instance : "s + ::strerror(error)};
+    }
+    epoll_event event{.events = EPOLLIN, .data{.fd = wakeFd}};
+    if(::epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &event) < 0)
+    {
+        const auto error = errno;
+        ::close(epollFd);
+        ::close(wakeFd);
+        throw std::runtime_error{"IoReactor : unable to register wake up descriptor : "s + ::strerror(error)};
+    }
+}
+
+IoReactor::~IoReactor() noexcept
+{
+    stop();
+    ::close(wakeFd);
+    ::close(epollFd);
+}
+
+void IoReactor::add(int fd, DataHandler handler)
+{
+    add(fd, [fd](std::span<uint8_t> chunk) -> std::size_t
+    {
+        for(;;)
+        {
+            const auto rret = ::read(fd, chunk.data(), chunk.size());
+            if(rret > 0)
+            {
+                return static_cast<std::size_t>(rret);
+            }
+            if(rret < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+            {
+                return 0u;
+            }
+            if(rret < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            throw std::runtime_error{"::read returned: "s + (rret < 0 ? ::strerror(errno) : "EOF")};
+        }
+    }, std::move(handler));
+}
+
+void IoReactor::add(int fd, DataReader reader, DataHandler handler)
+{
+    std::lock_guard lGuard{handlersMutex};
+    epoll_event event{.events = EPOLLIN, .data{.fd = fd}};
+    if(::epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) < 0)
+    {
+        throw std::runtime_error{"IoReactor::add : ::epoll_ctl returned : "s + ::strerror(errno)};
+    }
+    devicesByFd[fd] = std::make_shared<const Device>(Device{std::move(reader), std::move(handler)});
+}
+
+void IoReactor::remove(int fd)
+{
+    {
+        std::lock_guard lGuard{handlersMutex};
+        removeLocked(fd);
+    }
+    // the device may be being handled, it is not handled anymore once the dispatch in progress is over
+    std::lock_guard dGuard{dispatchMutex};
+}
+
+std::size_t IoReactor::poll(std::chrono::milliseconds timeout)
+{
+    std::array<epoll_event, 32u> events{};
+    const auto ready = ::epoll_wait(epollFd, events.data(), static_cast<int>(events.size()),
+                                    static_cast<int>(timeout.count()));
+    if(ready < 0)
+    {
+        if(errno == EINTR)
+        {
+            return 0u;
+        }
+        throw std::runtime_error{"IoReactor::poll : ::epoll_wait returned : "s + ::strerror(errno)};
+    }
+    if(ready > 0)
+    {
+        wakeups.fetch_add(1u, std::memory_order_relaxed);
+    }
+
+    std::lock_guard dGuard{dispatchMutex};
+    auto dispatched = 0u;
+    for(auto i = 0; i < ready; ++i)
+    {
+        const auto fd = events[static_cast<std::size_t>(i)].data.fd;
+        if(fd == wakeFd)
+        {
+            uint64_t counter{};
+            (void)::read(wakeFd, &counter, sizeof(counter));
+            continue;
+        }
+        std::shared_ptr<const Device> device;
+        {
+            // handlers run unlocked, a device removed meanwhile is skipped
+            std::lock_guard lGuard{handlersMutex};
+            if(const auto found = devicesByFd.find(fd); found != devicesByFd.end())
+            {
+                device = found->second;
+            }
+        }
+        if(!device)
+        {
+            continue;
+        }
+        if(!drain(*device))
+        {
+            std::cerr << "IoReactor : dropping fd: " << fd << "\n";
+            std::lock_guard lGuard{handlersMutex};
+            if(const auto found = devicesByFd.find(fd); found != devicesByFd.end() && found->second == device)
+            {
+                removeLocked(fd);
+                devicesClosed.fetch_add(1u, std::memory_order_relaxed);
+            }
+            continue;
+        }
+        ++dispatched;
+    }
+    return dispatched;
+}
+
+void IoReactor::start()
+{
+    reactorFuture = std::async(std::launch::async, [this]()
+    {
+        using namespace std::chrono_literals;
+        try
+        {
+            for( ; !stopThread.load() ; )
+            {
+                poll(100ms);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "Exception in I/O reactor operation: \n"s << e.what() << '\n';
+        }
+    });
+}
+
+void IoReactor::stop()
+{
+    if ( stopThread.exchange(true) )
+    {
+        return ;
+    }
+    const uint64_t wakeUp{1u};
+    (void)::write(wakeFd, &wakeUp, sizeof(wakeUp));
+    if (reactorFuture.valid())
+    {
+        reactorFuture.wait();
+    }
+}
+
+std::size_t IoReactor::devices() const
+{
+    std::lock_guard lGuard{handlersMutex};
+    return devicesByFd.size();
+}
+
+IoReactor::Statistics IoReactor::statistics() const
+{
+    return {wakeups.load(std::memory_order_relaxed), reads.load(std::memory_order_relaxed),
+            bytesRead.load(std::memory_order_relaxed), devicesClosed.load(std::memory_order_relaxed)};
+}
+
+bool IoReactor::drain(const Device& device)
+{
+    for(;;)
+    {
+        reads.fetch_add(1u, std::memory_order_relaxed);
+        std::size_t received{};
+        try
+        {
+            received = device.reader(rxChunk);
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "IoReactor : " << e.what() << "\n";
+            return false;
+        }
+        if(received == 0u)
+        {
+            return true;
+        }
+        bytesRead.fetch_add(received, std::memory_order_relaxed);
+        device.handler({rxChunk.data(), received});
+        if(received < rxChunk.size())
+        {
+            // level triggered, anything arriving in the meantime wakes the next poll
+            return true;
+        }
+    }
+}
+
+void IoReactor::removeLocked(int fd)
+{
+    if(devicesByFd.erase(fd) == 0u)
+    {
+        return ;
+    }
+    (void)::epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+}
+
+} // namespace lidar_viewer::dev
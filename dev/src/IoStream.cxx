@@ -13,11 +13,21 @@ unsigned int IoStream::read(void *ptr, unsigned int size, const std::chrono::mil
     return ioStreamBase->read(ptr, size, millis);
 }
 
+unsigned int IoStream::readSome(void *ptr, unsigned int size, const std::chrono::milliseconds millis) const noexcept(false)
+{
+    return ioStreamBase->readSome(ptr, size, millis);
+}
+
 void IoStream::write(const void *ptr, unsigned int size, bool discardOutput) const
 {
     ioStreamBase->write(ptr, size, discardOutput);
 }
 
+void IoStream::writeRecord(const void *ptr, unsigned int size, std::chrono::nanoseconds captureTime) const
+{
+    ioStreamBase->writeRecord(ptr, size, captureTime);
+}
+
 void IoStream::close() const
 {
     ioStreamBase->close();
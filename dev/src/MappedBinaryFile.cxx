@@ -0,0 +1,158 @@
+#include "lidar_viewer/dev/MappedBinaryFile.h"
+#include "lidar_viewer/dev/CygLidarFrame.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace
+{
+
+constexpr auto frameLengthSize = sizeof(uint16_t);
+constexpr auto frameChecksumSize = sizeof(uint8_t);
+
+}
+
+namespace lidar_viewer::dev
+{
+
+MappedBinaryFile::MappedBinaryFile(const std::string& fileName)
+: mapping{nullptr}
+, mappingSize{0u}
+, readPosition{0u}
+{
+    using namespace std::string_literals;
+    const auto fd = ::open(fileName.c_str(), O_RDONLY | O_CLOEXEC);
+    if(fd < 0)
+    {
+        throw std::runtime_error{"Unable to open file : "s + fileName + ", "s + ::strerror(errno)};
+    }
+
+    struct stat fileStat{};
+    if(::fstat(fd, &fileStat) < 0)
+    {
+        const auto err = errno;
+        ::close(fd);
+        throw std::runtime_error{"Unable to stat file : "s + fileName + ", "s + ::strerror(err)};
+    }
+
+    mappingSize = static_cast<std::size_t>(fileStat.st_size);
+    if(mappingSize == 0u)
+    {
+        // nothing to map, every read reports EOF
+        ::close(fd);
+        return ;
+    }
+
+    auto addr = ::mmap(nullptr, mappingSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    const auto err = errno;
+    // mapping keeps its own reference to the file
+    ::close(fd);
+    if(addr == MAP_FAILED)
+    {
+        throw std::runtime_error{"Unable to map file : "s + fileName + ", "s + ::strerror(err)};
+    }
+    // default read ahead, recordings are read sequentially, randomly, backwards and in parallel chunks alike,
+    // readers advise ranges they know the access pattern of
+    mapping = static_cast<const uint8_t*>(addr);
+}
+
+MappedBinaryFile::~MappedBinaryFile() noexcept
+{
+    if(mapping)
+    {
+        ::munmap(const_cast<uint8_t*>(mapping), mappingSize);
+    }
+}
+
+void MappedBinaryFile::open()
+{ /*NOOP*/ }
+
+unsigned int MappedBinaryFile::read(void *ptr, unsigned int size, const std::chrono::milliseconds ) const noexcept(false)
+{
+    const auto chunk = view(size);
+    std::memcpy(ptr, chunk.data(), chunk.size());
+    return static_cast<unsigned int>(chunk.size());
+}
+
+void MappedBinaryFile::write(const void *, unsigned int , bool ) const
+{ /*NOOP*/ }
+
+void MappedBinaryFile::close() const noexcept
+{ /*NOOP*/ }
+
+bool MappedBinaryFile::advise(std::size_t offset, std::size_t size, Access access) const noexcept
+{
+    if(!mapping || offset >= mappingSize || size == 0u)
+    {
+        return false;
+    }
+    static const auto pageSize = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    const auto begin = offset / pageSize * pageSize;
+    const auto end = std::min(offset + size, mappingSize);
+    // advice values are not flags, a single one per call
+    const auto advice = access == Access::Sequential ? MADV_SEQUENTIAL : MADV_WILLNEED;
+    return ::madvise(const_cast<uint8_t*>(mapping) + begin, end - begin, advice) == 0;
+}
+
+std::span<const uint8_t> MappedBinaryFile::view(std::size_t size) const noexcept(false)
+{
+    if(readPosition >= mappingSize)
+    {
+        throw std::runtime_error{"MappedBinaryFile::read : reached EOF"};
+    }
+    const auto available = std::min(size, mappingSize - readPosition);
+    std::span<const uint8_t> chunk{mapping + readPosition, available};
+    readPosition += available;
+    return chunk;
+}
+
+std::span<const uint8_t> MappedBinaryFile::nextFrame() const noexcept(false)
+{
+    if(readPosition >= mappingSize)
+    {
+        throw std::runtime_error{"MappedBinaryFile::nextFrame : reached EOF"};
+    }
+    const auto remaining = mappingSize - readPosition;
+    if(remaining < frameHeader.size() + frameLengthSize
+        || !std::equal(frameHeader.begin(), frameHeader.end(), mapping + readPosition))
+    {
+        return {};
+    }
+
+    uint16_t length{};
+    std::memcpy(&length, mapping + readPosition + frameHeader.size(), sizeof(length));
+    const auto rawSize = frameHeader.size() + frameLengthSize + length + frameChecksumSize;
+    if(rawSize > remaining)
+    {
+        return {};
+    }
+    return view(rawSize);
+}
+
+std::span<const uint8_t> MappedBinaryFile::data() const noexcept
+{
+    return {mapping, mappingSize};
+}
+
+std::size_t MappedBinaryFile::position() const noexcept
+{
+    return readPosition;
+}
+
+void MappedBinaryFile::seek(std::size_t pos) const noexcept
+{
+    readPosition = std::min(pos, mappingSize);
+}
+
+std::size_t MappedBinaryFile::size() const noexcept
+{
+    return mappingSize;
+}
+
+} // namespace lidar_viewer::dev
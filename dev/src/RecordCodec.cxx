@@ -0,0 +1,116 @@
+#include "lidar_viewer/dev/RecordCodec.h"
+#include "lidar_viewer/dev/DepthPacking.h"
+#include "lidar_viewer/dev/DepthUnpacking.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace lidar_viewer::dev::recording
+{
+
+namespace
+{
+
+constexpr uint8_t storedTag = 0x00u;
+constexpr uint8_t frame3dTag = 0x01u;
+
+constexpr std::size_t lengthSize = sizeof(uint16_t);
+/// offset of the payload type byte of a raw frame
+constexpr std::size_t payloadOffset = frameHeader.size() + lengthSize;
+constexpr std::size_t frame3dRawSize = payloadOffset + CygLidarD1::FRAME_SIZE_3D + 1u;
+
+bool isFrame3d(std::span<const uint8_t> record) noexcept
+{
+    if(record.size() != frame3dRawSize || !std::equal(frameHeader.begin(), frameHeader.end(), record.begin()))
+    {
+        return false;
+    }
+    uint16_t length{};
+    std::memcpy(&length, record.data() + frameHeader.size(), sizeof(length));
+    return length == CygLidarD1::FRAME_SIZE_3D;
+}
+
+} // namespace
+
+RecordEncoder::RecordEncoder(codec::CodecId codecId)
+: codec{codecId == codec::CodecId::Raw ? nullptr : codec::makeDepthCodec(codecId)}
+, depths{}
+, encoded{}
+{ }
+
+std::span<const uint8_t> RecordEncoder::encode(std::span<const uint8_t> record)
+{
+    if(!codec)
+    {
+        return record;
+    }
+    encoded.clear();
+    if(!isFrame3d(record))
+    {
+        encoded.push_back(storedTag);
+        encoded.insert(encoded.end(), record.begin(), record.end());
+        return encoded;
+    }
+    encoded.push_back(frame3dTag);
+    encoded.push_back(record[payloadOffset]);
+    encoded.push_back(record.back());
+    unpack3dDepths(record.subspan(payloadOffset + 1u, CygLidarD1::FRAME_SIZE_3D - 1u), depths);
+    codec->encode(depths, encoded);
+    return encoded;
+}
+
+RecordDecoder::RecordDecoder(codec::CodecId codecId)
+: codec{codecId == codec::CodecId::Raw ? nullptr : codec::makeDepthCodec(codecId)}
+, depths{}
+, decoded{}
+{ }
+
+std::span<const uint8_t> RecordDecoder::decode(std::span<const uint8_t> record) noexcept(false)
+{
+    if(!codec)
+    {
+        return record;
+    }
+    if(record.empty())
+    {
+        throw std::runtime_error{"RecordDecoder::decode : empty record"};
+    }
+    if(record.front() == storedTag)
+    {
+        return record.subspan(1u);
+    }
+    if(record.front() != frame3dTag || record.size() < 3u)
+    {
+        throw std::runtime_error{"RecordDecoder::decode : malformed record"};
+    }
+    codec->decode(record.subspan(3u), depths);
+
+    constexpr auto length = static_cast<uint16_t>(CygLidarD1::FRAME_SIZE_3D);
+    decoded.resize(frame3dRawSize);
+    std::copy(frameHeader.begin(), frameHeader.end(), decoded.begin());
+    std::memcpy(decoded.data() + frameHeader.size(), &length, sizeof(length));
+    decoded[payloadOffset] = record[1u];
+    pack12(depths, std::span{decoded}.subspan(payloadOffset + 1u, CygLidarD1::FRAME_SIZE_3D - 1u));
+    decoded.back() = record[2u];
+    return decoded;
+}
+
+bool RecordDecoder::keyframe(std::span<const uint8_t> record) const noexcept
+{
+    if(!codec)
+    {
+        return true;
+    }
+    return record.size() >= 3u && record.front() == frame3dTag && codec->keyframe(record.subspan(3u));
+}
+
+void RecordDecoder::reset() noexcept
+{
+    if(codec)
+    {
+        codec->reset();
+    }
+}
+
+} // namespace lidar_viewer::dev::recording
@@ -0,0 +1,421 @@
+#include "lidar_viewer/dev/RecordingReader.h"
+#include "lidar_viewer/dev/CygLidarFrame.h"
+#include "lidar_viewer/dev/Recording.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <future>
+#include <stdexcept>
+
+namespace lidar_viewer::dev
+{
+
+RecordingReader::RecordingReader(const std::string& fileName, ReplayClock clock_)
+: file{fileName}
+, clock{clock_}
+, hasTimestamps{false}
+, recordingInfo{}
+, codecId{codec::CodecId::Raw}
+, decoder{codec::CodecId::Raw}
+, dataEnd{0u}
+, storedIndexOffset{0u}
+, storedIndexSize{0u}
+, indexed{false}
+, rebuiltIndex{}
+, record{}
+, recordCaptureTime{}
+, recordCount{0u}
+{
+    recording::FileHeader fileHeader{};
+    const auto mapping = file.data();
+    dataEnd = mapping.size();
+    // headers of older versions are prefixes of the current one
+    constexpr auto minimalHeaderSize = offsetof(recording::FileHeader, info);
+    if(mapping.size() < minimalHeaderSize)
+    {
+        return ;
+    }
+    std::memcpy(&fileHeader, mapping.data(), std::min(sizeof(fileHeader), mapping.size()));
+    if(fileHeader.magic != recording::fileMagic)
+    {
+        return ;
+    }
+    if(fileHeader.version > recording::formatVersion)
+    {
+        throw std::runtime_error{"Unsupported recording version : " + std::to_string(fileHeader.version)};
+    }
+    if(fileHeader.headerSize > mapping.size() || fileHeader.headerSize < minimalHeaderSize)
+    {
+        throw std::runtime_error{"Corrupted recording header : " + fileName};
+    }
+    hasTimestamps = true;
+    if(fileHeader.headerSize >= offsetof(recording::FileHeader, codec))
+    {
+        recordingInfo = fileHeader.info;
+    }
+    if(fileHeader.headerSize >= sizeof(fileHeader))
+    {
+        codecId = fileHeader.codec;
+        decoder = recording::RecordDecoder{codecId};
+    }
+    file.seek(fileHeader.headerSize);
+
+    recording::IndexFooter indexFooter{};
+    if(mapping.size() < fileHeader.headerSize + sizeof(indexFooter))
+    {
+        return ;
+    }
+    std::memcpy(&indexFooter, mapping.data() + mapping.size() - sizeof(indexFooter), sizeof(indexFooter));
+    const auto indexEnd = indexFooter.indexOffset + indexFooter.frameCount * sizeof(recording::IndexEntry);
+    if(indexFooter.magic != recording::indexMagic
+       || indexFooter.indexOffset < fileHeader.headerSize
+       || indexEnd != mapping.size() - sizeof(indexFooter))
+    {
+        // not closed properly, index is rebuilt on demand
+        return ;
+    }
+    dataEnd = indexFooter.indexOffset;
+    storedIndexOffset = indexFooter.indexOffset;
+    storedIndexSize = indexFooter.frameCount;
+    indexed = true;
+}
+
+void RecordingReader::open()
+{ /*NOOP*/ }
+
+unsigned int RecordingReader::read(void *ptr, unsigned int size, const std::chrono::milliseconds ) const noexcept(false)
+{
+    auto uptr = reinterpret_cast<uint8_t*>(ptr);
+    auto readBytes = 0u;
+    while(readBytes < size)
+    {
+        if(record.empty() && !nextRecord())
+        {
+            break;
+        }
+        const auto chunk = std::min<std::size_t>(size - readBytes, record.size());
+        std::memcpy(uptr + readBytes, record.data(), chunk);
+        record = record.subspan(chunk);
+        readBytes += chunk;
+    }
+    if(readBytes == 0u && size != 0u)
+    {
+        throw std::runtime_error{"RecordingReader::read : reached EOF"};
+    }
+    return readBytes;
+}
+
+unsigned int RecordingReader::readSome(void *ptr, unsigned int size, const std::chrono::milliseconds ) const noexcept(false)
+{
+    if(record.empty() && size != 0u && !nextRecord())
+    {
+        throw std::runtime_error{"RecordingReader::read : reached EOF"};
+    }
+    const auto chunk = std::min<std::size_t>(size, record.size());
+    std::memcpy(ptr, record.data(), chunk);
+    record = record.subspan(chunk);
+    return static_cast<unsigned int>(chunk);
+}
+
+void RecordingReader::write(const void *, unsigned int , bool ) const
+{ /*NOOP*/ }
+
+void RecordingReader::close() const noexcept
+{ /*NOOP*/ }
+
+bool RecordingReader::timestamped() const noexcept
+{
+    return hasTimestamps;
+}
+
+const recording::RecordingInfo& RecordingReader::info() const noexcept
+{
+    return recordingInfo;
+}
+
+codec::CodecId RecordingReader::frameCodec() const noexcept
+{
+    return codecId;
+}
+
+std::chrono::nanoseconds RecordingReader::captureTime() const noexcept
+{
+    return recordCaptureTime;
+}
+
+std::size_t RecordingReader::recordsRead() const noexcept
+{
+    return recordCount;
+}
+
+std::size_t RecordingReader::frameCount() const
+{
+    buildIndex();
+    return storedIndexSize != 0u ? storedIndexSize : rebuiltIndex.size();
+}
+
+RecordedFrame RecordingReader::frame(std::size_t frameIndex) const noexcept(false)
+{
+    if(frameIndex >= frameCount())
+    {
+        throw std::out_of_range{"RecordingReader::frame : no frame " + std::to_string(frameIndex)};
+    }
+    if(codecId == codec::CodecId::Raw)
+    {
+        recording::RecordDecoder passThrough{codecId};
+        return decodeFrame(passThrough, frameIndex);
+    }
+    recording::RecordDecoder frameDecoder{codecId};
+    prime(frameDecoder, frameIndex);
+    auto recordedFrame = decodeFrame(frameDecoder, frameIndex);
+    auto storage = std::make_shared<const std::vector<uint8_t>>(recordedFrame.data.begin(), recordedFrame.data.end());
+    recordedFrame.data = *storage;
+    recordedFrame.storage = std::move(storage);
+    return recordedFrame;
+}
+
+void RecordingReader::seek(std::size_t frameIndex) const noexcept(false)
+{
+    if(frameIndex > frameCount())
+    {
+        throw std::out_of_range{"RecordingReader::seek : no frame " + std::to_string(frameIndex)};
+    }
+    // decoder is ready for the frame at recordCount, it is primed from a keyframe only on a jump
+    if(frameIndex == recordCount + 1u)
+    {
+        (void)decoder.decode(storedFrame(recordCount));
+    }
+    else if(frameIndex != recordCount)
+    {
+        prime(decoder, frameIndex);
+    }
+    moveTo(frameIndex);
+}
+
+StatusOr<RecordedFrame> RecordingReader::next() const
+{
+    if(recordCount >= frameCount())
+    {
+        return Status::BAD;
+    }
+    auto recordedFrame = decodeFrame(decoder, recordCount);
+    moveTo(recordCount + 1u);
+    recordCaptureTime = recordedFrame.captureTime;
+    return recordedFrame;
+}
+
+StatusOr<RecordedFrame> RecordingReader::previous() const
+{
+    if(recordCount < 2u)
+    {
+        return Status::BAD;
+    }
+    const auto frameIndex = recordCount - 2u;
+    prime(decoder, frameIndex);
+    auto recordedFrame = decodeFrame(decoder, frameIndex);
+    moveTo(frameIndex + 1u);
+    recordCaptureTime = recordedFrame.captureTime;
+    return recordedFrame;
+}
+
+void RecordingReader::forEachChunk(std::size_t chunks, const std::function<void(const RecordedFrame&)>& function) const
+{
+    const auto count = frameCount();
+    chunks = std::clamp<std::size_t>(chunks, 1u, std::max<std::size_t>(count, 1u));
+    const auto chunkSize = (count + chunks - 1u) / chunks;
+
+    std::vector<std::future<void>> workers;
+    workers.reserve(chunks);
+    for(std::size_t begin = 0u; begin < count; begin += chunkSize)
+    {
+        const auto end = std::min(begin + chunkSize, count);
+        // every record of the chunk is read, its pages are read ahead
+        const auto chunkOffset = indexEntry(begin).offset;
+        const auto chunkEnd = end == count ? dataEnd : indexEntry(end).offset;
+        file.advise(chunkOffset, chunkEnd - chunkOffset, MappedBinaryFile::Access::WillNeed);
+        workers.emplace_back(std::async(std::launch::async, [this, begin, end, &function]()
+        {
+            // every chunk decodes on its own, starting at the keyframe preceding it
+            recording::RecordDecoder chunkDecoder{codecId};
+            prime(chunkDecoder, begin);
+            for(auto i = begin; i < end; ++i)
+            {
+                function(decodeFrame(chunkDecoder, i));
+            }
+        }));
+    }
+    // rethrows the first failure, remaining workers are joined by future dtors
+    for(auto& worker : workers)
+    {
+        worker.get();
+    }
+}
+
+bool RecordingReader::nextRecord() const
+{
+    if(file.position() >= dataEnd)
+    {
+        return false;
+    }
+
+    if(hasTimestamps)
+    {
+        const auto recordHeader = recordHeaderAt(file.position());
+        if(!recordHeader.ok())
+        {
+            // truncated record of a recording which was not closed properly
+            file.seek(dataEnd);
+            return false;
+        }
+        file.seek(file.position() + sizeof(recording::RecordHeader));
+        record = decoder.decode(file.view(recordHeader.value().size));
+        recordCaptureTime = std::chrono::nanoseconds{recordHeader.value().captureTimeNs};
+    }
+    else
+    {
+        if(record = file.nextFrame(); record.empty())
+        {
+            // garbage in between frames is handed out unpaced, up until next frame header
+            const auto mapping = file.data();
+            const auto garbageBegin = mapping.begin() + static_cast<std::ptrdiff_t>(file.position());
+            const auto nextHeader = std::search(garbageBegin + 1, mapping.end(),
+                                                frameHeader.begin(), frameHeader.end());
+            record = file.view(static_cast<std::size_t>(nextHeader - garbageBegin));
+            return true;
+        }
+        recordCaptureTime = recording::legacyFramePeriod * recordCount;
+    }
+    ++recordCount;
+    clock.waitFor(recordCaptureTime);
+    return true;
+}
+
+StatusOr<recording::RecordHeader> RecordingReader::recordHeaderAt(std::size_t offset) const
+{
+    recording::RecordHeader recordHeader{};
+    if(offset + sizeof(recordHeader) > dataEnd)
+    {
+        return Status::BAD;
+    }
+    std::memcpy(&recordHeader, file.data().data() + offset, sizeof(recordHeader));
+    if(offset + sizeof(recordHeader) + recordHeader.size > dataEnd)
+    {
+        return Status::BAD;
+    }
+    return recordHeader;
+}
+
+void RecordingReader::buildIndex() const
+{
+    if(indexed)
+    {
+        return ;
+    }
+    indexed = true;
+
+    if(hasTimestamps)
+    {
+        // hop over record headers, starting right after the file header
+        uint16_t headerSize{};
+        std::memcpy(&headerSize, file.data().data() + offsetof(recording::FileHeader, headerSize), sizeof(headerSize));
+        for(std::size_t offset = headerSize; ; )
+        {
+            const auto recordHeader = recordHeaderAt(offset);
+            if(!recordHeader.ok())
+            {
+                break;
+            }
+            rebuiltIndex.emplace_back(recording::IndexEntry{.offset = offset,
+                                                            .captureTimeNs = recordHeader.value().captureTimeNs});
+            offset += sizeof(recording::RecordHeader) + recordHeader.value().size;
+        }
+        return ;
+    }
+
+    // legacy recording, scan for valid frames skipping garbage in between
+    const auto mapping = file.data();
+    const auto savedPosition = file.position();
+    for(file.seek(0u); file.position() < mapping.size(); )
+    {
+        const auto offset = file.position();
+        if(const auto rawFrame = file.nextFrame(); !rawFrame.empty())
+        {
+            const auto captureTime = std::chrono::nanoseconds{recording::legacyFramePeriod * rebuiltIndex.size()};
+            rebuiltIndex.emplace_back(recording::IndexEntry{.offset = offset,
+                                                            .captureTimeNs = static_cast<uint64_t>(captureTime.count())});
+            continue;
+        }
+        const auto nextHeader = std::search(mapping.begin() + static_cast<std::ptrdiff_t>(offset) + 1, mapping.end(),
+                                            frameHeader.begin(), frameHeader.end());
+        file.seek(static_cast<std::size_t>(nextHeader - mapping.begin()));
+    }
+    file.seek(savedPosition);
+}
+
+recording::IndexEntry RecordingReader::indexEntry(std::size_t frameIndex) const
+{
+    if(storedIndexSize == 0u)
+    {
+        return rebuiltIndex[frameIndex];
+    }
+    recording::IndexEntry entry{};
+    std::memcpy(&entry,
+                file.data().data() + storedIndexOffset + frameIndex * sizeof(recording::IndexEntry),
+                sizeof(entry));
+    return entry;
+}
+
+std::span<const uint8_t> RecordingReader::storedFrame(std::size_t frameIndex) const
+{
+    const auto entry = indexEntry(frameIndex);
+    const auto mapping = file.data();
+    if(hasTimestamps)
+    {
+        const auto recordHeader = recordHeaderAt(entry.offset);
+        if(!recordHeader.ok())
+        {
+            throw std::runtime_error{"RecordingReader::frame : index points past recorded data"};
+        }
+        return mapping.subspan(entry.offset + sizeof(recording::RecordHeader), recordHeader.value().size);
+    }
+    // legacy frames were validated when the index was built
+    uint16_t length{};
+    std::memcpy(&length, mapping.data() + entry.offset + frameHeader.size(), sizeof(length));
+    return mapping.subspan(entry.offset, frameHeader.size() + sizeof(length) + length + 1u);
+}
+
+void RecordingReader::moveTo(std::size_t frameIndex) const
+{
+    file.seek(frameIndex == frameCount() ? dataEnd : indexEntry(frameIndex).offset);
+    record = {};
+    recordCount = frameIndex;
+    clock.reset();
+}
+
+void RecordingReader::prime(recording::RecordDecoder& recordDecoder, std::size_t frameIndex) const
+{
+    if(codecId == codec::CodecId::Raw)
+    {
+        return ;
+    }
+    recordDecoder.reset();
+    auto start = std::min(frameIndex, frameCount());
+    for( ; start > 0u && (start == frameCount() || !recordDecoder.keyframe(storedFrame(start))); --start)
+    { }
+    for(auto i = start; i < frameIndex; ++i)
+    {
+        (void)recordDecoder.decode(storedFrame(i));
+    }
+}
+
+RecordedFrame RecordingReader::decodeFrame(recording::RecordDecoder& recordDecoder, std::size_t frameIndex) const
+{
+    return RecordedFrame{
+            .index = frameIndex,
+            .captureTime = std::chrono::nanoseconds{indexEntry(frameIndex).captureTimeNs},
+            .data = recordDecoder.decode(storedFrame(frameIndex))
+    };
+}
+
+} // namespace lidar_viewer::dev
@@ -0,0 +1,88 @@
+#include "lidar_viewer/dev/RecordingWriter.h"
+
+#include <stdexcept>
+
+namespace lidar_viewer::dev
+{
+
+RecordingWriter::RecordingWriter(const std::string& fileName, recording::RecordingInfo info, codec::CodecId codecId)
+: fStream{fileName, std::ofstream::binary | std::ofstream::out | std::ofstream::trunc}
+, encoder{codecId}
+, index{}
+, writeOffset{0u}
+, closed{false}
+{
+    if(!fStream.is_open())
+    {
+        throw std::runtime_error{ "Unable to create file : " + fileName };
+    }
+    const recording::FileHeader fileHeader{.info = info, .codec = codecId};
+    fStream.write(reinterpret_cast<const char*>(&fileHeader), sizeof(fileHeader));
+    fStream.flush();
+    writeOffset = sizeof(fileHeader);
+}
+
+RecordingWriter::~RecordingWriter() noexcept
+{
+    close();
+}
+
+void RecordingWriter::open()
+{ /*NOOP*/ }
+
+unsigned int RecordingWriter::read(void *, unsigned int , const std::chrono::milliseconds ) const noexcept(false)
+{
+    throw std::runtime_error{"RecordingWriter::read : recording is write only"};
+}
+
+void RecordingWriter::write(const void *ptr, unsigned int size, bool discardOutput) const
+{
+    if(discardOutput)
+    {
+        return ;
+    }
+    writeRecord(ptr, size, std::chrono::steady_clock::now().time_since_epoch());
+}
+
+void RecordingWriter::writeRecord(const void *ptr, unsigned int size, std::chrono::nanoseconds captureTime) const
+{
+    if(closed)
+    {
+        throw std::runtime_error{"RecordingWriter::write : recording already closed"};
+    }
+    const auto record = encoder.encode({reinterpret_cast<const uint8_t*>(ptr), size});
+    const recording::RecordHeader recordHeader{
+            .captureTimeNs = static_cast<uint64_t>(captureTime.count()),
+            .size = static_cast<uint32_t>(record.size())
+    };
+    fStream.write(reinterpret_cast<const char*>(&recordHeader), sizeof(recordHeader));
+    fStream.write(reinterpret_cast<const char*>(record.data()), static_cast<std::streamsize>(record.size()));
+    fStream.flush();
+    if(!fStream)
+    {
+        throw std::runtime_error{"RecordingWriter::write : failed to write a record"};
+    }
+    index.emplace_back(recording::IndexEntry{.offset = writeOffset, .captureTimeNs = recordHeader.captureTimeNs});
+    writeOffset += sizeof(recordHeader) + record.size();
+}
+
+void RecordingWriter::close() const noexcept
+{
+    if(closed)
+    {
+        return ;
+    }
+    closed = true;
+    const recording::IndexFooter indexFooter{.indexOffset = writeOffset, .frameCount = index.size()};
+    fStream.write(reinterpret_cast<const char*>(index.data()),
+                  static_cast<std::streamsize>(index.size() * sizeof(recording::IndexEntry)));
+    fStream.write(reinterpret_cast<const char*>(&indexFooter), sizeof(indexFooter));
+    fStream.flush();
+}
+
+std::size_t RecordingWriter::recordsWritten() const noexcept
+{
+    return index.size();
+}
+
+} // namespace lidar_viewer::dev
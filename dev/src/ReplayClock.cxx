@@ -0,0 +1,63 @@
+#include "lidar_viewer/dev/ReplayClock.h"
+
+#include <thread>
+
+namespace lidar_viewer::dev
+{
+
+ReplayClock::ReplayClock(double speed)
+: replaySpeed{speed > 0. ? speed : 0.}
+, anchored{false}
+, wallAnchor{}
+, captureAnchor{}
+{ }
+
+ReplayClock ReplayClock::realTime()
+{
+    return ReplayClock{1.};
+}
+
+ReplayClock ReplayClock::unthrottled()
+{
+    return ReplayClock{0.};
+}
+
+void ReplayClock::waitFor(std::chrono::nanoseconds captureTime)
+{
+    if(!throttled())
+    {
+        return ;
+    }
+    if(!anchored)
+    {
+        anchored = true;
+        wallAnchor = std::chrono::steady_clock::now();
+        captureAnchor = captureTime;
+        return ;
+    }
+    if(captureTime <= captureAnchor)
+    {
+        return ;
+    }
+    const auto scaledOffset = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::duration<double, std::nano>(
+                    static_cast<double>((captureTime - captureAnchor).count()) / replaySpeed));
+    std::this_thread::sleep_until(wallAnchor + scaledOffset);
+}
+
+void ReplayClock::reset() noexcept
+{
+    anchored = false;
+}
+
+double ReplayClock::speed() const noexcept
+{
+    return replaySpeed;
+}
+
+bool ReplayClock::throttled() const noexcept
+{
+    return replaySpeed > 0.;
+}
+
+} // namespace lidar_viewer::dev
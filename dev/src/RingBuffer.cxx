@@ -0,0 +1,94 @@
+#include "lidar_viewer/dev/RingBuffer.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+namespace lidar_viewer::dev
+{
+
+RingBuffer::RingBuffer(std::size_t capacity_)
+: storage(std::bit_ceil(std::max<std::size_t>(capacity_, 1u)))
+, mask{storage.size() - 1u}
+, head{0u}
+, tail{0u}
+{ }
+
+std::size_t RingBuffer::size() const noexcept
+{
+    return head - tail;
+}
+
+std::size_t RingBuffer::capacity() const noexcept
+{
+    return storage.size();
+}
+
+std::size_t RingBuffer::freeSpace() const noexcept
+{
+    return capacity() - size();
+}
+
+bool RingBuffer::empty() const noexcept
+{
+    return head == tail;
+}
+
+std::size_t RingBuffer::read(void* ptr, std::size_t size_) noexcept
+{
+    auto uptr = reinterpret_cast<uint8_t*>(ptr);
+    std::size_t readBytes{0u};
+    for(const auto& region : readableRegions())
+    {
+        const auto chunk = std::min(size_ - readBytes, region.size());
+        std::memcpy(uptr + readBytes, region.data(), chunk);
+        readBytes += chunk;
+    }
+    consume(readBytes);
+    return readBytes;
+}
+
+std::size_t RingBuffer::write(const void* ptr, std::size_t size_) noexcept
+{
+    auto uptr = reinterpret_cast<const uint8_t*>(ptr);
+    std::size_t writtenBytes{0u};
+    for(const auto& region : writableRegions())
+    {
+        const auto chunk = std::min(size_ - writtenBytes, region.size());
+        std::memcpy(region.data(), uptr + writtenBytes, chunk);
+        writtenBytes += chunk;
+    }
+    commit(writtenBytes);
+    return writtenBytes;
+}
+
+RingBuffer::Regions RingBuffer::writableRegions() noexcept
+{
+    const auto begin = head & mask;
+    const auto first = std::min(freeSpace(), capacity() - begin);
+    return {std::span{storage}.subspan(begin, first), std::span{storage}.first(freeSpace() - first)};
+}
+
+void RingBuffer::commit(std::size_t size_) noexcept
+{
+    head += std::min(size_, freeSpace());
+}
+
+RingBuffer::ConstRegions RingBuffer::readableRegions() const noexcept
+{
+    const auto begin = tail & mask;
+    const auto first = std::min(size(), capacity() - begin);
+    return {std::span{storage}.subspan(begin, first), std::span{storage}.first(size() - first)};
+}
+
+void RingBuffer::consume(std::size_t size_) noexcept
+{
+    tail += std::min(size_, size());
+}
+
+void RingBuffer::clear() noexcept
+{
+    tail = head;
+}
+
+} // namespace lidar_viewer::dev
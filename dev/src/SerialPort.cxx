@@ -6,9 +6,12 @@
 #include <fcntl.h>
 #include <poll.h>
 #include <sys/ioctl.h>
+#include <sys/uio.h>
 #include <asm/ioctls.h>
+#include <cerrno>
 #include <cstring>
 
+#include <array>
 #include <chrono>
 #include <stdexcept>
 #include <iostream>
@@ -48,10 +51,18 @@ namespace lidar_viewer::dev
 
 SerialPort::SerialPort(const std::string& fileName)
 : fd{ open(fileName) }
+, rxBuffer{ RX_BUFFER_SIZE }
+, polls{0u}
+, reads{0u}
+, bytesRead{0u}
 { }
 
 SerialPort::SerialPort(const std::string &fileName, const unsigned int baudRate)
 : fd{ open(fileName) }
+, rxBuffer{ RX_BUFFER_SIZE }
+, polls{0u}
+, reads{0u}
+, bytesRead{0u}
 {
     configure(baudRate);
 }
@@ -131,28 +142,65 @@ void SerialPort::configure(const unsigned int baudRate) const
 
 unsigned int SerialPort::read(void *ptr, unsigned int size, const std::chrono::milliseconds millis) const
 {
-    using namespace std::chrono_literals;
-    using namespace std::string_literals;
-    auto rret = 0;
-    auto rretsum = 0u;
     auto uptr = reinterpret_cast<uint8_t*>(ptr);
-    do
+    auto rretsum = static_cast<unsigned int>(rxBuffer.read(uptr, size));
+    while ( rretsum < size )
     {
+        polls.fetch_add(1u, std::memory_order_relaxed);
         if( !pollFor(fd, millis, POLLIN))
         {
             return rretsum ;
         }
+        fill();
+        rretsum += static_cast<unsigned int>(rxBuffer.read(uptr + rretsum, size - rretsum));
+    }
+    return rretsum;
+}
 
-        uptr += rret;
-
-        if( rret = static_cast<int>(::read(fd, uptr, size-rretsum));
-                rret <= 0 )
+unsigned int SerialPort::readSome(void *ptr, unsigned int size, const std::chrono::milliseconds millis) const
+{
+    if( rxBuffer.empty() && size != 0u )
+    {
+        polls.fetch_add(1u, std::memory_order_relaxed);
+        if( !pollFor(fd, millis, POLLIN))
         {
-            throw std::runtime_error("::read returned: "s + ::strerror(rret) );
+            return 0u;
         }
-        rretsum += rret;
-    } while ( rretsum < size );
-    return rretsum;
+        fill();
+    }
+    return static_cast<unsigned int>(rxBuffer.read(ptr, size));
+}
+
+unsigned int SerialPort::readAvailable(void *ptr, unsigned int size) const
+{
+    if( rxBuffer.empty() && size != 0u )
+    {
+        fill();
+    }
+    return static_cast<unsigned int>(rxBuffer.read(ptr, size));
+}
+
+std::size_t SerialPort::fill() const
+{
+    using namespace std::string_literals;
+    const auto regions = rxBuffer.writableRegions();
+    std::array<iovec, 2u> iov{
+            iovec{.iov_base = regions[0u].data(), .iov_len = regions[0u].size()},
+            iovec{.iov_base = regions[1u].data(), .iov_len = regions[1u].size()}
+    };
+    reads.fetch_add(1u, std::memory_order_relaxed);
+    const auto rret = ::readv(fd, iov.data(), regions[1u].empty() ? 1 : 2);
+    if( rret < 0 && (errno == EAGAIN || errno == EWOULDBLOCK) )
+    {
+        return 0u;
+    }
+    if( rret <= 0 )
+    {
+        throw std::runtime_error("::readv returned: "s + (rret < 0 ? ::strerror(errno) : "EOF"));
+    }
+    rxBuffer.commit(static_cast<std::size_t>(rret));
+    bytesRead.fetch_add(static_cast<uint64_t>(rret), std::memory_order_relaxed);
+    return static_cast<std::size_t>(rret);
 }
 
 void SerialPort::write(const void *ptr, unsigned int size, bool ) const noexcept(false)
@@ -195,6 +243,18 @@ void SerialPort::close() const noexcept
 void SerialPort::setFd(const int _fd)
 {
     fd = _fd;
+    rxBuffer.clear();
+}
+
+int SerialPort::getFd() const noexcept
+{
+    return fd;
+}
+
+SerialPort::Statistics SerialPort::statistics() const noexcept
+{
+    return {polls.load(std::memory_order_relaxed), reads.load(std::memory_order_relaxed),
+            bytesRead.load(std::memory_order_relaxed)};
 }
 
 void SerialPort::open()
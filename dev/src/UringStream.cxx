@@ -0,0 +1,567 @@
+#include "lidar_viewer/dev/UringStream.h"
+#include "lidar_viewer/dev/BinaryFile.h"
+#include "lidar_viewer/dev/SerialPort.h"
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#if defined(LIDAR_VIEWER_IO_URING)
+#include <linux/io_uring.h>
+#include <linux/time_types.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+namespace lidar_viewer::dev
+{
+
+using namespace std::string_literals;
+
+#if defined(LIDAR_VIEWER_IO_URING)
+
+namespace
+{
+
+int uringSetup(unsigned int entries, io_uring_params& params) noexcept
+{
+    return static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+}
+
+/// @returns time left until deadline, nullopt if there is none
+std::optional<std::chrono::milliseconds> timeLeft(const std::optional<std::chrono::steady_clock::time_point>& deadline)
+{
+    if(!deadline)
+    {
+        return std::nullopt;
+    }
+    const auto left = std::chrono::duration_cast<std::chrono::milliseconds>(*deadline - std::chrono::steady_clock::now());
+    return std::max(left, std::chrono::milliseconds{0});
+}
+
+} // namespace
+
+/// submission and completion queues mapped from the kernel, a read queued per slot
+class UringStream::Ring
+{
+public:
+    Ring(int fd_, bool seekable_)
+    : fd{fd_}
+    , seekable{seekable_}
+    , params{}
+    , ringFd{uringSetup(ENTRIES, params)}
+    , slots(seekable ? FILE_QUEUE_DEPTH : 1u)
+    {
+        if(ringFd < 0)
+        {
+            throw std::runtime_error{"UringStream : ::io_uring_setup returned : "s + ::strerror(errno)};
+        }
+        try
+        {
+            map();
+        }
+        catch (...)
+        {
+            unmap();
+            ::close(ringFd);
+            throw ;
+        }
+        for(auto& slot : slots)
+        {
+            slot.buffer.resize(BUFFER_SIZE);
+            queue(slot);
+        }
+        submit();
+    }
+
+    ~Ring() noexcept
+    {
+        cancel();
+        unmap();
+        ::close(ringFd);
+    }
+
+    unsigned int read(uint8_t* ptr, unsigned int size, std::chrono::milliseconds millis, bool some)
+    {
+        std::optional<std::chrono::steady_clock::time_point> deadline{};
+        if(millis != std::chrono::milliseconds::max())
+        {
+            deadline = std::chrono::steady_clock::now() + millis;
+        }
+        unsigned int readBytes{0u};
+        while(readBytes < size)
+        {
+            auto& slot = slots[head];
+            if(!slot.completed)
+            {
+                if((some && readBytes > 0u) || !wait(timeLeft(deadline)))
+                {
+                    break;
+                }
+                continue;
+            }
+            if(slot.result <= 0)
+            {
+                if(!seekable && (slot.result == 0 || slot.result == -EAGAIN))
+                {
+                    // raced with another reader of the port, nothing to serve
+                    queue(slot);
+                    continue;
+                }
+                if(readBytes > 0u)
+                {
+                    break;
+                }
+                throw std::runtime_error{"UringStream::read : "s
+                                         + (slot.result == 0 ? "reached EOF"s : ::strerror(-slot.result))};
+            }
+            const auto chunk = std::min(size - readBytes, static_cast<unsigned int>(slot.result) - slot.consumed);
+            std::memcpy(ptr + readBytes, slot.buffer.data() + slot.consumed, chunk);
+            readBytes += chunk;
+            slot.consumed += chunk;
+            if(slot.consumed == static_cast<unsigned int>(slot.result))
+            {
+                queue(slot);
+                head = (head + 1u) % slots.size();
+                if(unsubmitted() >= slots.size())
+                {
+                    submit();
+                }
+            }
+        }
+        return readBytes;
+    }
+
+    Statistics stats{};
+
+private:
+    static constexpr unsigned int ENTRIES = 16u;
+
+    enum class Request : uint64_t
+    {
+        Read = 0u,
+        Poll = 1u,
+        Cancel = 2u
+    };
+
+    struct Slot
+    {
+        std::vector<uint8_t> buffer{};
+        iovec iov{};
+        int result{};
+        unsigned int consumed{};
+        bool completed{false};
+        bool inFlight{false};
+    };
+
+    static uint64_t userData(std::size_t slot, Request request) noexcept
+    {
+        return (static_cast<uint64_t>(request) << 32u) | slot;
+    }
+
+    void map()
+    {
+        sqSize = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+        cqSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        const auto singleMmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0u;
+        if(singleMmap)
+        {
+            sqSize = cqSize = std::max(sqSize, cqSize);
+        }
+        sqRing = mapRegion(sqSize, IORING_OFF_SQ_RING);
+        cqRing = singleMmap ? sqRing : mapRegion(cqSize, IORING_OFF_CQ_RING);
+        sqes = reinterpret_cast<io_uring_sqe*>(mapRegion(params.sq_entries * sizeof(io_uring_sqe), IORING_OFF_SQES));
+
+        sqHead = ringField(sqRing, params.sq_off.head);
+        sqTail = ringField(sqRing, params.sq_off.tail);
+        sqMask = *ringField(sqRing, params.sq_off.ring_mask);
+        sqArray = ringField(sqRing, params.sq_off.array);
+        cqHead = ringField(cqRing, params.cq_off.head);
+        cqTail = ringField(cqRing, params.cq_off.tail);
+        cqMask = *ringField(cqRing, params.cq_off.ring_mask);
+        cqes = reinterpret_cast<io_uring_cqe*>(reinterpret_cast<uint8_t*>(cqRing) + params.cq_off.cqes);
+    }
+
+    void* mapRegion(std::size_t size, off_t offset) const
+    {
+        const auto ptr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, offset);
+        if(ptr == MAP_FAILED)
+        {
+            throw std::runtime_error{"UringStream : ::mmap returned : "s + ::strerror(errno)};
+        }
+        return ptr;
+    }
+
+    static uint32_t* ringField(void* ring, uint32_t offset) noexcept
+    {
+        return reinterpret_cast<uint32_t*>(reinterpret_cast<uint8_t*>(ring) + offset);
+    }
+
+    void unmap() noexcept
+    {
+        if(sqes != nullptr)
+        {
+            ::munmap(sqes, params.sq_entries * sizeof(io_uring_sqe));
+        }
+        if(cqRing != nullptr && cqRing != sqRing)
+        {
+            ::munmap(cqRing, cqSize);
+        }
+        if(sqRing != nullptr)
+        {
+            ::munmap(sqRing, sqSize);
+        }
+        sqes = nullptr;
+        sqRing = cqRing = nullptr;
+    }
+
+    /// @brief queues read of a slot, a serial port read is linked to a poll for data,
+    /// since the port is set up to return straight away when there is nothing to read
+    void queue(Slot& slot)
+    {
+        const auto index = static_cast<std::size_t>(&slot - slots.data());
+        slot.iov = iovec{.iov_base = slot.buffer.data(), .iov_len = slot.buffer.size()};
+        slot.result = 0;
+        slot.consumed = 0u;
+        slot.completed = false;
+        slot.inFlight = true;
+        if(!seekable)
+        {
+            io_uring_sqe poll{};
+            poll.opcode = IORING_OP_POLL_ADD;
+            poll.fd = fd;
+            poll.flags = IOSQE_IO_LINK;
+            poll.poll32_events = POLLIN;
+            poll.user_data = userData(index, Request::Poll);
+            push(poll);
+        }
+        io_uring_sqe read{};
+        read.opcode = IORING_OP_READV;
+        read.fd = fd;
+        read.addr = reinterpret_cast<uint64_t>(&slot.iov);
+        read.len = 1u;
+        read.off = seekable ? offset : static_cast<uint64_t>(-1);
+        read.user_data = userData(index, Request::Read);
+        push(read);
+        offset += slot.buffer.size();
+        ++stats.submissions;
+    }
+
+    void push(const io_uring_sqe& sqe)
+    {
+        if(unsubmitted() + 1u > params.sq_entries - 1u)
+        {
+            submit();
+        }
+        const auto tail = *sqTail;
+        const auto index = tail & sqMask;
+        sqes[index] = sqe;
+        sqArray[index] = index;
+        std::atomic_ref<uint32_t>{*sqTail}.store(tail + 1u, std::memory_order_release);
+        ++outstanding;
+    }
+
+    [[nodiscard]] uint32_t unsubmitted() const noexcept
+    {
+        return *sqTail - std::atomic_ref<uint32_t>{*sqHead}.load(std::memory_order_acquire);
+    }
+
+    void submit()
+    {
+        while(unsubmitted() > 0u)
+        {
+            if(enter(unsubmitted(), 0u, 0u, nullptr) < 0 && errno != EINTR && errno != EAGAIN && errno != EBUSY)
+            {
+                throw std::runtime_error{"UringStream : ::io_uring_enter returned : "s + ::strerror(errno)};
+            }
+        }
+    }
+
+    /// @returns true if the slot served next completed
+    bool wait(const std::optional<std::chrono::milliseconds>& timeout)
+    {
+        reap();
+        if(slots[head].completed)
+        {
+            return true;
+        }
+        if(timeout && timeout->count() == 0)
+        {
+            submit();
+            reap();
+            return slots[head].completed;
+        }
+        ++stats.waits;
+        // a serial port read completes along with its poll
+        const auto completions = seekable ? 1u : 2u;
+        if((params.features & IORING_FEAT_EXT_ARG) != 0u)
+        {
+            __kernel_timespec ts{};
+            io_uring_getevents_arg arg{};
+            if(timeout)
+            {
+                ts.tv_sec = timeout->count() / 1000;
+                ts.tv_nsec = (timeout->count() % 1000) * 1000000;
+                arg.ts = reinterpret_cast<uint64_t>(&ts);
+            }
+            // submits and waits in a single syscall
+            if(enter(unsubmitted(), completions, IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &arg) < 0
+               && errno != ETIME && errno != EINTR)
+            {
+                throw std::runtime_error{"UringStream : ::io_uring_enter returned : "s + ::strerror(errno)};
+            }
+        }
+        else
+        {
+            submit();
+            pollfd pfd{.fd = ringFd, .events = POLLIN, .revents{}};
+            (void)::poll(&pfd, 1, timeout ? static_cast<int>(timeout->count()) : -1);
+        }
+        reap();
+        return slots[head].completed;
+    }
+
+    void reap() noexcept
+    {
+        auto cqHeadValue = *cqHead;
+        const auto cqTailValue = std::atomic_ref<uint32_t>{*cqTail}.load(std::memory_order_acquire);
+        for( ; cqHeadValue != cqTailValue; ++cqHeadValue)
+        {
+            const auto& cqe = cqes[cqHeadValue & cqMask];
+            --outstanding;
+            if(static_cast<Request>(cqe.user_data >> 32u) != Request::Read)
+            {
+                continue;
+            }
+            auto& slot = slots[cqe.user_data & 0xffffffffu];
+            slot.result = cqe.res;
+            slot.completed = true;
+            slot.inFlight = false;
+            ++stats.completions;
+            if(cqe.res > 0)
+            {
+                stats.bytesRead += static_cast<uint64_t>(cqe.res);
+            }
+        }
+        std::atomic_ref<uint32_t>{*cqHead}.store(cqHeadValue, std::memory_order_release);
+    }
+
+    /// @brief cancels queued reads, buffers have to outlive them
+    void cancel() noexcept
+    {
+        try
+        {
+            for(auto index = 0u; index < slots.size(); ++index)
+            {
+                if(!slots[index].inFlight)
+                {
+                    continue;
+                }
+                io_uring_sqe cancelRequest{};
+                cancelRequest.opcode = IORING_OP_ASYNC_CANCEL;
+                cancelRequest.fd = -1;
+                cancelRequest.addr = userData(index, seekable ? Request::Read : Request::Poll);
+                cancelRequest.user_data = userData(index, Request::Cancel);
+                push(cancelRequest);
+            }
+            submit();
+            for(auto attempt = 0u; outstanding > 0u && attempt < 10u; ++attempt)
+            {
+                pollfd pfd{.fd = ringFd, .events = POLLIN, .revents{}};
+                (void)::poll(&pfd, 1, 100);
+                reap();
+            }
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "UringStream : unable to cancel queued reads: " << e.what() << "\n";
+        }
+    }
+
+    int enter(unsigned int toSubmit, unsigned int minComplete, unsigned int flags, io_uring_getevents_arg* arg) noexcept
+    {
+        ++stats.enters;
+        return static_cast<int>(::syscall(__NR_io_uring_enter, ringFd, toSubmit, minComplete, flags,
+                                          arg, arg == nullptr ? 0u : sizeof(*arg)));
+    }
+
+    int fd;
+    bool seekable;
+    io_uring_params params;
+    int ringFd;
+    std::vector<Slot> slots;
+    std::size_t head{0u};
+    uint64_t offset{0u};
+    std::size_t outstanding{0u};
+
+    std::size_t sqSize{};
+    std::size_t cqSize{};
+    void* sqRing{};
+    void* cqRing{};
+    io_uring_sqe* sqes{};
+    uint32_t* sqHead{};
+    uint32_t* sqTail{};
+    uint32_t sqMask{};
+    uint32_t* sqArray{};
+    uint32_t* cqHead{};
+    uint32_t* cqTail{};
+    uint32_t cqMask{};
+    io_uring_cqe* cqes{};
+};
+
+bool UringStream::available() noexcept
+{
+    static const auto isAvailable = []()
+    {
+        io_uring_params params{};
+        const auto ringFd = uringSetup(1u, params);
+        if(ringFd < 0)
+        {
+            return false;
+        }
+        ::close(ringFd);
+        return true;
+    }();
+    return isAvailable;
+}
+
+#else
+
+/// io_uring support left out of the build
+class UringStream::Ring
+{
+public:
+    Ring(int, bool)
+    {
+        throw std::runtime_error{"UringStream : built without io_uring support"};
+    }
+
+    unsigned int read(uint8_t*, unsigned int, std::chrono::milliseconds, bool)
+    {
+        return 0u;
+    }
+
+    Statistics stats{};
+};
+
+bool UringStream::available() noexcept
+{
+    return false;
+}
+
+#endif
+
+UringStream::UringStream(const std::string& deviceName, unsigned int baudRate)
+: fallback{}
+, ring{}
+, ownedFd{-1}
+{
+    auto serialPort = std::make_unique<SerialPort>(deviceName, baudRate);
+    const auto fd = serialPort->getFd();
+    fallback = std::move(serialPort);
+    setupRing(fd, false);
+}
+
+UringStream::UringStream(const std::string& fileName)
+: fallback{}
+, ring{}
+, ownedFd{::open(fileName.c_str(), O_RDONLY | O_CLOEXEC)}
+{
+    if(ownedFd < 0)
+    {
+        throw std::runtime_error{"Unable to open file : " + fileName};
+    }
+    setupRing(ownedFd, true);
+    if(!ring)
+    {
+        ::close(ownedFd);
+        ownedFd = -1;
+        fallback = std::make_unique<BinaryFile>(fileName);
+    }
+}
+
+UringStream::~UringStream() noexcept
+{
+    ring.reset();
+    if(ownedFd >= 0)
+    {
+        ::close(ownedFd);
+    }
+}
+
+void UringStream::setupRing(int fd, bool seekable)
+{
+    try
+    {
+        ring = std::make_unique<Ring>(fd, seekable);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << ", falling back to plain reads\n";
+        ring.reset();
+    }
+}
+
+void UringStream::open()
+{
+    if(fallback)
+    {
+        fallback->open();
+    }
+}
+
+unsigned int UringStream::read(void* ptr, unsigned int size, const std::chrono::milliseconds millis) const noexcept(false)
+{
+    if(!ring)
+    {
+        return fallback->read(ptr, size, millis);
+    }
+    return ring->read(reinterpret_cast<uint8_t*>(ptr), size, millis, false);
+}
+
+unsigned int UringStream::readSome(void* ptr, unsigned int size, const std::chrono::milliseconds millis) const noexcept(false)
+{
+    if(!ring)
+    {
+        return fallback->readSome(ptr, size, millis);
+    }
+    return ring->read(reinterpret_cast<uint8_t*>(ptr), size, millis, true);
+}
+
+void UringStream::write(const void* ptr, unsigned int size, bool discardOutput) const
+{
+    // a file opened for the ring is read only
+    if(fallback)
+    {
+        fallback->write(ptr, size, discardOutput);
+    }
+}
+
+void UringStream::close() const noexcept
+{
+    if(fallback)
+    {
+        fallback->close();
+    }
+}
+
+bool UringStream::usingUring() const noexcept
+{
+    return ring != nullptr;
+}
+
+UringStream::Statistics UringStream::statistics() const noexcept
+{
+    return ring ? ring->stats : Statistics{};
+}
+
+} // namespace lidar_viewer::dev
@@ -3,9 +3,13 @@
 
 #include "lidar_viewer/geometry/types/Point.h"
 #include "lidar_viewer/geometry/types/PointCloud.h"
+#include "lidar_viewer/geometry/types/PointCloudSoA.h"
+#include "Utilities.h"
 
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <type_traits>
 #include <vector>
 
 namespace lidar_viewer::geometry::functions
@@ -83,6 +87,74 @@ types::PointCloud3D<CoordType> downSample(const types::PointCloud3D<CoordType>&
     return ret;
 }
 
+/// @brief averages the points of every voxel, voxels ordered the way downSample of points stored one after another
+/// orders them, coordinates are walked channel by channel
+template <typename CoordType>
+types::PointCloud3DSoA<CoordType> downSample(const types::PointCloud3DSoA<CoordType>& pointCloud, float voxelSize)
+{
+    if (pointCloud.size() < 7)
+    {
+        return {};
+    }
+    const auto bounds = calculateBoundingBoxFromPointCloud(pointCloud.view());
+    const auto voxelsSizeX = std::ceil(std::abs(bounds.hi[0] - bounds.lo[0]) / voxelSize);
+    const auto voxelsSizeY = std::ceil(std::abs(bounds.hi[1] - bounds.lo[1]) / voxelSize);
+    const auto voxelsSizeZ = std::ceil(std::abs(bounds.hi[2] - bounds.lo[2]) / voxelSize);
+    const auto voxelsSize = voxelsSizeX * voxelsSizeY * voxelsSizeZ;
+
+    const auto xs = pointCloud.channel(0u);
+    const auto ys = pointCloud.channel(1u);
+    const auto zs = pointCloud.channel(2u);
+    // voxel of every point computed in one pass over the channels
+    types::AlignedChannel<std::remove_const_t<decltype(voxelsSize)>> ids(pointCloud.size());
+    for (std::size_t i = 0u; i < ids.size(); ++i)
+    {
+        const auto xFloored = std::floor((xs[i] - bounds.lo[0]) / voxelSize);
+        const auto yFloored = std::floor((ys[i] - bounds.lo[1]) / voxelSize);
+        const auto zFloored = std::floor((zs[i] - bounds.lo[2]) / voxelSize);
+        ids[i] = xFloored + voxelsSizeX * (yFloored + voxelsSizeY * zFloored);
+    }
+
+    const auto voxelsCount = static_cast<std::size_t>(voxelsSize);
+    std::array<std::vector<CoordType>, 3u> sums;
+    for (auto& sum : sums)
+    {
+        sum.resize(voxelsCount);
+    }
+    std::vector<size_t> voxelsCounts(voxelsCount);
+    for (std::size_t i = 0u; i < ids.size(); ++i)
+    {
+        if (ids[i] >= voxelsSize)
+        {
+            continue;
+        }
+        const auto id = static_cast<std::size_t>(ids[i]);
+        sums[0u][id] += xs[i];
+        sums[1u][id] += ys[i];
+        sums[2u][id] += zs[i];
+        voxelsCounts[id] += 1u;
+    }
+
+    types::PointCloud3DSoA<CoordType> ret{};
+    for (auto i = 0u; i < voxelsSizeX; ++i)
+    {
+        for (auto j = 0u; j < voxelsSizeY; ++j)
+        {
+            for (auto k = 0u; k < voxelsSizeZ; ++k)
+            {
+                const auto id = static_cast<std::size_t>(i + voxelsSizeX * (j + voxelsSizeY * k));
+                if (id >= voxelsCount || voxelsCounts[id] == 0)
+                {
+                    continue;
+                }
+                types::Point3D<CoordType> point{{sums[0u][id], sums[1u][id], sums[2u][id]}};
+                ret.emplace_back(point / voxelsCounts[id]);
+            }
+        }
+    }
+    return ret;
+}
+
 } // namespace lidar_viewer::geometry::functions
 
 
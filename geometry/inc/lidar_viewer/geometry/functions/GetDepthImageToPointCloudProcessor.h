@@ -1,74 +1,248 @@
 #ifndef LIDAR_VIEWER_GETDEPTHIMAGETOPOINTCLOUDPROCESSOR_H
 #define LIDAR_VIEWER_GETDEPTHIMAGETOPOINTCLOUDPROCESSOR_H
 
+#include "lidar_viewer/geometry/types/Point.h"
 #include "lidar_viewer/geometry/types/PointCloud.h"
 #include "lidar_viewer/geometry/types/DepthFrameAttributes.h"
+#include "lidar_viewer/geometry/types/DepthRays.h"
 #include "lidar_viewer/geometry/types/ScreenRanges.h"
 #include "Utilities.h"
+#include <algorithm>
+#include <bit>
+#include <cstdint>
 #include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <vector>
 
 namespace lidar_viewer::geometry::functions
 {
 
-/// returns a function which will later process an input depth image to convert it to point cloud
-template <typename FrameType>
-std::function<void(const FrameType &, types::PointCloud3D<float>& )>
-getDepthImageToPointCloudProcessor( const types::DepthFrameAttributes& depthAtributes, const types::ScreenRanges& screenRange)
+/// @brief computes the ray through every pixel of depth images, angles depend on the pixel position only
+/// @param depthAtributes resolution, depth range and field of view of the images
+/// @param screenRange ranges the point clouds are mapped into
+/// @returns rays of every pixel
+inline types::DepthRays makeDepthRays(const types::DepthFrameAttributes& depthAtributes,
+                                      const types::ScreenRanges& screenRange)
+{
+    types::DepthRays rays{depthAtributes, screenRange.fullRangeX(), screenRange.fullRangeY(),
+                          screenRange.fullRangeZ(), .0f, {}, {}, {}};
+
+    const auto width = depthAtributes.frameResolution.first;
+    const auto height = depthAtributes.frameResolution.second;
+    const auto xUpperNormScalar = (rays.screenRangeX.second - rays.screenRangeX.first) / static_cast<float>(width);
+    const auto yUpperNormScalar = (rays.screenRangeY.second - rays.screenRangeY.first) / static_cast<float>(height);
+    rays.depthScale = (rays.screenRangeZ.second - rays.screenRangeZ.first)
+                      / (static_cast<float>(depthAtributes.depthRange.second)
+                         - static_cast<float>(depthAtributes.depthRange.first));
+
+    const auto size = static_cast<std::size_t>(width) * height;
+    rays.x.resize(size);
+    rays.y.resize(size);
+    rays.z.resize(size);
+    for (auto y = 0u; y < height; ++y)
+    {
+        const auto yRotationPrecalc = mapValue(.0f, rays.screenRangeY.first, yUpperNormScalar, static_cast<float>(y));
+        const auto rotationValueX = yRotationPrecalc * depthAtributes.rotationY * M_PIf / 180.f;
+        for (auto x = 0u; x < width; ++x)
+        {
+            const auto xRotationPrecalc = mapValue(.0f, rays.screenRangeX.first, xUpperNormScalar,
+                                                   static_cast<float>(x));
+            const auto rotationValueY = xRotationPrecalc * depthAtributes.rotationX * M_PIf / 180.f;
+            const auto ray = sphericalToEuclidean(1.f, rotationValueX, rotationValueY);
+            const auto index = static_cast<std::size_t>(y) * width + x;
+            rays.x[index] = ray[0u];
+            rays.y[index] = ray[1u];
+            rays.z[index] = ray[2u];
+        }
+    }
+    return rays;
+}
+
+/// @brief rays of depth images, computed on first use and shared by every later caller
+/// @param depthAtributes resolution, depth range and field of view of the images
+/// @param screenRange ranges the point clouds are mapped into
+/// @returns rays of every pixel, kept alive by the handle even if dropped from the cache
+inline std::shared_ptr<const types::DepthRays> depthRays(const types::DepthFrameAttributes& depthAtributes,
+                                                         const types::ScreenRanges& screenRange)
+{
+    // a few sensors and screens at a time, the oldest rays make room for new ones
+    static constexpr std::size_t cacheSize = 8u;
+    static std::mutex mutex;
+    static std::vector<std::shared_ptr<const types::DepthRays>> cache;
+
+    std::lock_guard lGuard{mutex};
+    const auto cached = std::find_if(cache.begin(), cache.end(), [&](const auto& rays)
+    {
+        return rays->matches(depthAtributes, screenRange);
+    });
+    if (cached != cache.end())
+    {
+        return *cached;
+    }
+    if (cache.size() == cacheSize)
+    {
+        cache.erase(cache.begin());
+    }
+    return cache.emplace_back(std::make_shared<const types::DepthRays>(makeDepthRays(depthAtributes, screenRange)));
+}
+
+/// @brief visits the points of a depth image, depths out of range are omitted,
+/// every point is the ray of its pixel scaled by its depth
+/// @param frame3d depth image, if it carries a validity mask only the depths marked valid are visited
+/// @param rays rays of the pixels of the image
+/// @param emit called with the coordinates of every point, in the order of the pixels
+/// @param first index of the first pixel visited
+/// @param last index past the last pixel visited, the whole image by default
+template <typename FrameType, typename EmitType>
+void visitDepthImagePoints(const FrameType& frame3d, const types::DepthRays& rays, EmitType&& emit,
+                           std::size_t first = 0u, std::size_t last = std::numeric_limits<std::size_t>::max())
 {
-    return [&depthAtributes, &screenRange](const FrameType& frame3d, types::PointCloud3D<float>& pointCloudV)
+    if(frame3d.empty())
     {
-        using lidar_viewer::geometry::functions::mapValue;
-        using lidar_viewer::geometry::functions::sphericalToEuclidean;
+        return ;
+    }
+    const auto& depthRange = rays.attributes.depthRange;
+    const auto depthFirst = static_cast<float>(depthRange.first);
+    const auto screenFirst = rays.screenRangeZ.first;
+    const auto depthScale = rays.depthScale;
+    const auto* rayX = rays.x.data();
+    const auto* rayY = rays.y.data();
+    const auto* rayZ = rays.z.data();
 
-        if(frame3d.empty())
+    const auto convert = [&](std::size_t index)
+    {
+        auto elementOfFrame = frame3d[index];
+        // omit every point not fitting in range, even error frames
+        if ((elementOfFrame > depthRange.second) || (elementOfFrame < depthRange.first))
         {
             return ;
         }
-        const auto bUpperNormGlFullScreenRangeX = screenRange.fullRangeX().second - screenRange.fullRangeX().first;
-        const auto bUpperNormGlFullScreenRangeY = screenRange.fullRangeY().second - screenRange.fullRangeY().first;
-        const auto bUpperNormGlFullScreenRangeZ = screenRange.fullRangeZ().second - screenRange.fullRangeZ().first;
-
-        const std::pair<float, float> glRangeX {.0f, static_cast<float>(depthAtributes.frameResolution.first)};
-        const auto aUpperNormGlFullScreenRangeX = glRangeX.second - glRangeX.first;
-        const std::pair<float, float> glRangeY {.0f, static_cast<float>(depthAtributes.frameResolution.second)};
-        const auto aUpperNormGlFullScreenRangeY = glRangeY.second - glRangeY.first;
-        const std::pair<float, float> glRangeZ {static_cast<float>(depthAtributes.depthRange.first),
-                                                static_cast<float>(depthAtributes.depthRange.second)};
-        const auto aUpperNormGlFullScreenRangeZ = glRangeZ.second - glRangeZ.first;
-
-        const auto xUpperNormScalar = bUpperNormGlFullScreenRangeX / aUpperNormGlFullScreenRangeX;
-        const auto yUpperNormScalar = bUpperNormGlFullScreenRangeY / aUpperNormGlFullScreenRangeY;
-        const auto zUpperNormScalar = bUpperNormGlFullScreenRangeZ / aUpperNormGlFullScreenRangeZ;
-
-        for (auto y = 0u; y < depthAtributes.frameResolution.second; ++y)
+        const auto zDepthPrecalc = mapValue(depthFirst, screenFirst, depthScale, static_cast<float>(elementOfFrame));
+        emit(rayX[index] * zDepthPrecalc, rayY[index] * zDepthPrecalc, rayZ[index] * zDepthPrecalc);
+    };
+
+    last = std::min(last, rays.x.size());
+    if (first >= last)
+    {
+        return ;
+    }
+    if constexpr (requires { frame3d.validity.mask; })
+    {
+        // frames classified on arrival, only the valid depths are visited
+        for (auto word = first / 64u; word < frame3d.validity.mask.size(); ++word)
         {
-            for (auto x = 0u; x < depthAtributes.frameResolution.first; ++x)
+            auto bits = frame3d.validity.mask[word];
+            if (word == first / 64u)
             {
-                auto elementOfFrame = frame3d[y * depthAtributes.frameResolution.first + x];
-                // omit every point not fitting in range, even error frames
-                if ((elementOfFrame > depthAtributes.depthRange.second)
-                    || (elementOfFrame < depthAtributes.depthRange.first))
+                bits &= ~uint64_t{0u} << (first % 64u);
+            }
+            for (; bits != 0u; bits &= bits - 1u)
+            {
+                const auto index = word * 64u + static_cast<std::size_t>(std::countr_zero(bits));
+                if (index >= last)
                 {
-                    continue;
-
+                    return ;
                 }
-                const auto xRotationPrecalc = mapValue(glRangeX.first, screenRange.fullRangeX().first,
-                                                       xUpperNormScalar, static_cast<float>(x));
-                const auto yRotationPrecalc = mapValue(glRangeY.first, screenRange.fullRangeY().first,
-                                                       yUpperNormScalar, static_cast<float>(y));
-                const auto zDepthPrecalc = mapValue(glRangeZ.first, screenRange.fullRangeZ().first,
-                                                    zUpperNormScalar,static_cast<float>(elementOfFrame));
-                const auto rotationValueX = yRotationPrecalc * depthAtributes.rotationY * M_PIf / 180.f;
-                const auto rotationValueY = xRotationPrecalc * depthAtributes.rotationX * M_PIf / 180.f;
-                auto rawPoint = sphericalToEuclidean(zDepthPrecalc, rotationValueX,
-                                                     rotationValueY);
-
-                pointCloudV.emplace_back(rawPoint);
+                convert(index);
             }
         }
+        return ;
+    }
+
+    for (auto index = first; index < last; ++index)
+    {
+        convert(index);
+    }
+}
+
+/// @brief converts a depth image to a point cloud, depths out of range are omitted.
+/// Room for a point per pixel is reserved up front, a point cloud cleared and reused for every frame
+/// is not reallocated once it held a frame
+/// @param frame3d depth image, if it carries a validity mask only the depths marked valid are visited
+/// @param rays rays of the pixels of the image
+/// @param pointCloudV point cloud points are appended to, PointCloud3D or PointCloud3DSoA
+template <typename FrameType, typename PointCloudType>
+void depthImageToPointCloud(const FrameType& frame3d, const types::DepthRays& rays, PointCloudType& pointCloudV)
+{
+    if(frame3d.empty())
+    {
+        return ;
+    }
+    pointCloudV.reserve(pointCloudV.size() + rays.x.size());
+    visitDepthImagePoints(frame3d, rays, [&pointCloudV](auto x, auto y, auto z)
+    {
+        pointCloudV.emplace_back(typename PointCloudType::value_type{{x, y, z}});
+    });
+}
+
+/// @brief converts a depth image into a buffer owned by the caller, never allocates
+/// @param frame3d depth image, if it carries a validity mask only the depths marked valid are visited
+/// @param rays rays of the pixels of the image
+/// @param points buffer holding a point per pixel at least
+/// @returns number of points written to the front of the buffer
+/// @throws std::runtime_error if the buffer cannot hold a point per pixel
+template <typename FrameType, typename CoordType>
+std::size_t depthImageToPointCloud(const FrameType& frame3d, const types::DepthRays& rays,
+                                   std::span<types::Point3D<CoordType>> points)
+{
+    if(points.size() < rays.x.size())
+    {
+        throw std::runtime_error{"Point buffer smaller than the depth image"};
+    }
+    std::size_t count = 0u;
+    visitDepthImagePoints(frame3d, rays, [&points, &count](auto x, auto y, auto z)
+    {
+        auto& point = points[count++];
+        point[0u] = x;
+        point[1u] = y;
+        point[2u] = z;
+    });
+    return count;
+}
+
+/// @brief converts a depth image to a point cloud, depths out of range are omitted
+/// @param frame3d depth image, if it carries a validity mask only the depths marked valid are visited
+/// @param depthAtributes resolution, depth range and field of view of the image
+/// @param screenRange ranges the point cloud is mapped into
+/// @param pointCloudV point cloud points are appended to, PointCloud3D or PointCloud3DSoA
+template <typename FrameType, typename PointCloudType>
+void depthImageToPointCloud(const FrameType& frame3d, const types::DepthFrameAttributes& depthAtributes,
+                            const types::ScreenRanges& screenRange, PointCloudType& pointCloudV)
+{
+    if(frame3d.empty())
+    {
+        return ;
+    }
+    depthImageToPointCloud(frame3d, *depthRays(depthAtributes, screenRange), pointCloudV);
+}
+
+/// returns a function which will later process an input depth image to convert it to point cloud,
+/// rays of the pixels are computed once, when the function is created
+template <typename FrameType, typename PointCloudType = types::PointCloud3D<float>>
+std::function<void(const FrameType &, PointCloudType& )>
+getDepthImageToPointCloudProcessor( const types::DepthFrameAttributes& depthAtributes, const types::ScreenRanges& screenRange)
+{
+    return [rays = depthRays(depthAtributes, screenRange)](const FrameType& frame3d, PointCloudType& pointCloudV)
+    {
+        depthImageToPointCloud(frame3d, *rays, pointCloudV);
     };
 }
 
+/// returns a function which will later process depth images of a sensor to convert them to point clouds,
+/// resolution and field of view are taken from the sensor descriptor
+/// @tparam Sensor descriptor of the sensor, see dev::SensorDescriptor
+template <typename Sensor, typename FrameType, typename PointCloudType = types::PointCloud3D<float>>
+std::function<void(const FrameType &, PointCloudType& )>
+getDepthImageToPointCloudProcessor( const types::UintRange& depthRange, const types::ScreenRanges& screenRange)
+{
+    return getDepthImageToPointCloudProcessor<FrameType, PointCloudType>(
+            types::sensorDepthFrameAttributes<Sensor>(depthRange), screenRange);
+}
+
 } // namespace lidar_viewer::geometry::functions
 
 #endif //LIDAR_VIEWER_GETDEPTHIMAGETOPOINTCLOUDPROCESSOR_H
@@ -0,0 +1,123 @@
+#ifndef LIDAR_VIEWER_GETPARALLELDEPTHIMAGETOPOINTCLOUDPROCESSOR_H
+#define LIDAR_VIEWER_GETPARALLELDEPTHIMAGETOPOINTCLOUDPROCESSOR_H
+
+#include "GetDepthImageToPointCloudProcessor.h"
+#include "lidar_viewer/geometry/types/WorkerPool.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+
+namespace lidar_viewer::geometry::functions
+{
+
+/// number of tiles a depth image is split into at most
+constexpr std::size_t MAX_DEPTH_IMAGE_TILES = 64u;
+
+/// @brief converts a depth image to a point cloud on the threads of a pool, depths out of range are omitted.
+/// Rows of the image are split into tiles converted each into the points of its own pixels,
+/// the points of the tiles are then moved next to each other in order, so the point cloud is the same
+/// as converted by a single thread
+/// @param frame3d depth image, if it carries a validity mask only the depths marked valid are visited
+/// @param rays rays of the pixels of the image
+/// @param pointCloudV point cloud points are appended to, PointCloud3D or PointCloud3DSoA
+/// @param pool threads converting the tiles
+/// @param tiles number of tiles, clamped to the number of rows and MAX_DEPTH_IMAGE_TILES
+template <typename FrameType, typename PointCloudType>
+void depthImageToPointCloud(const FrameType& frame3d, const types::DepthRays& rays, PointCloudType& pointCloudV,
+                            types::WorkerPool& pool, std::size_t tiles)
+{
+    const auto width = static_cast<std::size_t>(rays.attributes.frameResolution.first);
+    const auto rows = static_cast<std::size_t>(rays.attributes.frameResolution.second);
+    if(frame3d.empty() || rows == 0u)
+    {
+        return ;
+    }
+    tiles = std::clamp<std::size_t>(tiles, 1u, std::min(rows, MAX_DEPTH_IMAGE_TILES));
+    const auto tileFirst = [width, rows, tiles](std::size_t tile)
+    {
+        return tile * rows / tiles * width;
+    };
+
+    const auto base = pointCloudV.size();
+    pointCloudV.resize(base + rays.x.size());
+    const auto store = [&pointCloudV]()
+    {
+        if constexpr (requires { pointCloudV.channel(0u); })
+        {
+            return [channels = std::array{pointCloudV.channel(0u), pointCloudV.channel(1u), pointCloudV.channel(2u)}]
+                    (std::size_t index, auto x, auto y, auto z)
+            {
+                channels[0u][index] = x;
+                channels[1u][index] = y;
+                channels[2u][index] = z;
+            };
+        }
+        else
+        {
+            return [points = pointCloudV.data()](std::size_t index, auto x, auto y, auto z)
+            {
+                points[index][0u] = x;
+                points[index][1u] = y;
+                points[index][2u] = z;
+            };
+        }
+    }();
+
+    // every tile writes the points of its own pixels, counted to merge the tiles afterwards
+    std::array<std::size_t, MAX_DEPTH_IMAGE_TILES> counts{};
+    pool.run(tiles, [&](std::size_t tile)
+    {
+        const auto first = tileFirst(tile);
+        auto index = base + first;
+        visitDepthImagePoints(frame3d, rays, [&store, &index](auto x, auto y, auto z)
+        {
+            store(index++, x, y, z);
+        }, first, tileFirst(tile + 1u));
+        counts[tile] = index - base - first;
+    });
+
+    // the first tile is in place already, the others are moved behind it
+    auto end = base + counts[0u];
+    for(std::size_t tile = 1u; tile < tiles; ++tile)
+    {
+        const auto first = base + tileFirst(tile);
+        if constexpr (requires { pointCloudV.channel(0u); })
+        {
+            for(std::size_t axis = 0u; axis < 3u; ++axis)
+            {
+                const auto channel = pointCloudV.channel(axis);
+                std::copy(channel.begin() + first, channel.begin() + first + counts[tile], channel.begin() + end);
+            }
+        }
+        else
+        {
+            std::move(pointCloudV.begin() + first, pointCloudV.begin() + first + counts[tile],
+                      pointCloudV.begin() + end);
+        }
+        end += counts[tile];
+    }
+    pointCloudV.resize(end);
+}
+
+/// returns a function which will later convert depth images to point clouds on the threads of a pool,
+/// rays of the pixels are computed once, when the function is created
+/// @param pool threads converting the tiles, has to outlive the function
+/// @param tiles number of tiles rows of an image are split into, a tile per thread of the pool by default
+template <typename FrameType, typename PointCloudType = types::PointCloud3D<float>>
+std::function<void(const FrameType &, PointCloudType& )>
+getParallelDepthImageToPointCloudProcessor(const types::DepthFrameAttributes& depthAtributes,
+                                           const types::ScreenRanges& screenRange,
+                                           types::WorkerPool& pool, std::size_t tiles = 0u)
+{
+    return [rays = depthRays(depthAtributes, screenRange), &pool, tiles = tiles == 0u ? pool.size() : tiles]
+            (const FrameType& frame3d, PointCloudType& pointCloudV)
+    {
+        depthImageToPointCloud(frame3d, *rays, pointCloudV, pool, tiles);
+    };
+}
+
+} // namespace lidar_viewer::geometry::functions
+
+#endif //LIDAR_VIEWER_GETPARALLELDEPTHIMAGETOPOINTCLOUDPROCESSOR_H
@@ -3,9 +3,14 @@
 
 #include "lidar_viewer/geometry/types/Box.h"
 #include "lidar_viewer/geometry/types/PointCloud.h"
+#include "lidar_viewer/geometry/types/PointCloudSoA.h"
 
+#include <algorithm>
+#include <array>
 #include <cmath>
 #include <functional>
+#include <span>
+#include <utility>
 
 namespace lidar_viewer::geometry::functions
 {
@@ -58,6 +63,59 @@ types::Box<PointT> calculateBoundingBoxFromPointCloud(const types::PointCloud<Po
     return {PointT{ {{(*xMax)[0],(*yMax)[1],(*zMax)[2]}} },PointT{ {{(*xMin)[0],(*yMin)[1],(*zMin)[2]}} }};
 }
 
+/// @returns lowest and highest value of a channel, zeros if it is empty,
+/// kept apart in lanes so the loop is vectorized without relaxing floating point semantics
+template <typename T>
+std::pair<T, T> channelMinMax(std::span<const T> channel) noexcept
+{
+    if(channel.empty())
+    {
+        return {};
+    }
+    constexpr std::size_t lanes = 8u;
+    std::array<T, lanes> lo;
+    std::array<T, lanes> hi;
+    lo.fill(channel[0u]);
+    hi.fill(channel[0u]);
+    std::size_t i = 0u;
+    for( ; i + lanes <= channel.size(); i += lanes)
+    {
+        for(std::size_t lane = 0u; lane < lanes; ++lane)
+        {
+            const auto value = channel[i + lane];
+            lo[lane] = value < lo[lane] ? value : lo[lane];
+            hi[lane] = hi[lane] < value ? value : hi[lane];
+        }
+    }
+    for( ; i < channel.size(); ++i)
+    {
+        lo[0u] = channel[i] < lo[0u] ? channel[i] : lo[0u];
+        hi[0u] = hi[0u] < channel[i] ? channel[i] : hi[0u];
+    }
+    return {*std::min_element(lo.begin(), lo.end()), *std::max_element(hi.begin(), hi.end())};
+}
+
+/// @returns box bounding a point cloud of coordinate channels, every channel walked once
+template <typename CoordType, std::size_t Dim>
+types::Box<types::Point<CoordType, Dim>>
+calculateBoundingBoxFromPointCloud(const types::PointCloudSoAView<CoordType, Dim>& pointCloud)
+{
+    types::Point<CoordType, Dim> hi;
+    types::Point<CoordType, Dim> lo;
+    for(std::size_t i = 0u; i < Dim; ++i)
+    {
+        std::tie(lo[i], hi[i]) = channelMinMax(pointCloud.channel(i));
+    }
+    return {hi, lo};
+}
+
+template <typename CoordType, std::size_t Dim>
+types::Box<types::Point<CoordType, Dim>>
+calculateBoundingBoxFromPointCloud(const types::PointCloudSoA<CoordType, Dim>& pointCloud)
+{
+    return calculateBoundingBoxFromPointCloud(pointCloud.view());
+}
+
 template <typename PointT>
 PointT::value_type midOf(const types::Box<PointT>& box, size_t i)
 {
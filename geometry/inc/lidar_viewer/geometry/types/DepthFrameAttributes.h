@@ -22,6 +22,14 @@ struct DepthFrameAttributes
     float rotationY;
 };
 
+/// @returns attributes of the depth frames of a sensor, rotated by half of its field of view each way
+/// @tparam Sensor descriptor of the sensor, see dev::SensorDescriptor
+template <typename Sensor>
+constexpr DepthFrameAttributes sensorDepthFrameAttributes(UintRange depthRange) noexcept
+{
+    return {Sensor::window3d(), depthRange, Sensor::HORIZONTAL_FOV / 2.f, Sensor::VERTICAL_FOV / 2.f};
+}
+
 } // namespace lidar_viewer::geometry::types
 
 #endif //LIDAR_VIEWER_DEPTHFRAMEATTRIBUTES_H
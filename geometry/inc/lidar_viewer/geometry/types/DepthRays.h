@@ -0,0 +1,39 @@
+#ifndef LIDAR_VIEWER_DEPTHRAYS_H
+#define LIDAR_VIEWER_DEPTHRAYS_H
+
+#include "DepthFrameAttributes.h"
+#include "PointCloudSoA.h"
+#include "ScreenRanges.h"
+
+namespace lidar_viewer::geometry::types
+{
+
+/// @brief rays through every pixel of depth images of the same attributes, mapped into screen ranges,
+/// a point is its ray scaled by the mapped depth
+struct DepthRays
+{
+    DepthFrameAttributes attributes;
+    FloatRange screenRangeX;
+    FloatRange screenRangeY;
+    FloatRange screenRangeZ;
+    /// depth mapped into the z screen range, screenRangeZ.first + (depth - depthRange.first) * depthScale
+    float depthScale;
+    /// coordinates of the ray of every pixel, row after row
+    AlignedChannel<float> x;
+    AlignedChannel<float> y;
+    AlignedChannel<float> z;
+
+    /// @returns true if the rays were computed for the attributes and ranges
+    [[nodiscard]] bool matches(const DepthFrameAttributes& attributes_, const ScreenRanges& screenRange) const
+    {
+        return attributes.frameResolution == attributes_.frameResolution
+               && attributes.depthRange == attributes_.depthRange
+               && attributes.rotationX == attributes_.rotationX && attributes.rotationY == attributes_.rotationY
+               && screenRangeX == screenRange.fullRangeX() && screenRangeY == screenRange.fullRangeY()
+               && screenRangeZ == screenRange.fullRangeZ();
+    }
+};
+
+} // namespace lidar_viewer::geometry::types
+
+#endif //LIDAR_VIEWER_DEPTHRAYS_H
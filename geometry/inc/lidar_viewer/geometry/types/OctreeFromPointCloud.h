@@ -12,17 +12,19 @@ namespace lidar_viewer::geometry::types
 template <typename T>
 using ErrorOr = std::optional<T>; // temporary
 
-template <typename PointType>
+/// @tparam PointType type of a point
+/// @tparam PointCloudType point cloud indexed, points stored one after another or PointCloudSoA
+template <typename PointType, typename PointCloudType = PointCloud<PointType>>
 struct OctreeFromPointCloud
         : public Octree<Indices, Box<PointType>>
 {
     using Base = Octree<Indices, Box<PointType>>;
-    explicit OctreeFromPointCloud(const PointCloud<PointType>& pointCloud_)
+    explicit OctreeFromPointCloud(const PointCloudType& pointCloud_)
     : Base(functions::calculateBoundingBoxFromPointCloud(pointCloud_))
     , pointCloud{pointCloud_}
     { }
 
-    OctreeFromPointCloud(const PointCloud<PointType>& pointCloud_, const size_t depth, bool prefill = true)
+    OctreeFromPointCloud(const PointCloudType& pointCloud_, const size_t depth, bool prefill = true)
     : Base(functions::calculateBoundingBoxFromPointCloud(pointCloud_), depth)
     , pointCloud{pointCloud_}
     {
@@ -46,7 +48,7 @@ struct OctreeFromPointCloud
             // comparison against the nodes
             return dividedBox;
         };
-        auto retNode = createNodesRecursivelyAt<decltype(comparisonFunction)>(this->root, comparisonFunction, this->getKey(), this->depth);
+        auto retNode = this->template createNodesRecursivelyAt<decltype(comparisonFunction)>(this->root, comparisonFunction, this->getKey(), this->depth);
         retNode->getContainer().emplace_back(index);
         return retNode;
     }
@@ -60,7 +62,7 @@ struct OctreeFromPointCloud
         }
     }
 private:
-    const PointCloud<PointType>& pointCloud;
+    const PointCloudType& pointCloud;
 };
 
 } // namespace lidar_viewer::geometry::types
@@ -0,0 +1,267 @@
+#ifndef LIDAR_VIEWER_POINTCLOUDSOA_H
+#define LIDAR_VIEWER_POINTCLOUDSOA_H
+
+#include "Point.h"
+#include "PointCloud.h"
+
+#include <array>
+#include <cstddef>
+#include <new>
+#include <span>
+#include <vector>
+
+namespace lidar_viewer::geometry::types
+{
+
+/// allocator of storage aligned for vector loads
+template <typename T, std::size_t Alignment = 64u>
+struct AlignedAllocator
+{
+    using value_type = T;
+
+    template <typename U>
+    struct rebind
+    {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() noexcept = default;
+
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept
+    { }
+
+    T* allocate(std::size_t n)
+    {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{Alignment}));
+    }
+
+    void deallocate(T* ptr, std::size_t) noexcept
+    {
+        ::operator delete(ptr, std::align_val_t{Alignment});
+    }
+
+    template <typename U>
+    bool operator == (const AlignedAllocator<U, Alignment>&) const noexcept
+    {
+        return true;
+    }
+};
+
+/// coordinates or attributes of every point of a point cloud, one after another
+template <typename ValueType>
+using AlignedChannel = std::vector<ValueType, AlignedAllocator<ValueType>>;
+
+/// read only view of the coordinate channels of a point cloud, cheap to copy
+template <typename CoordType, std::size_t Dimension>
+struct PointCloudSoAView
+{
+    static constexpr auto Dim = Dimension;
+
+    using value_type = Point<CoordType, Dimension>;
+
+    std::array<std::span<const CoordType>, Dimension> channels{};
+
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        return channels[0u].size();
+    }
+
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return channels[0u].empty();
+    }
+
+    [[nodiscard]] std::span<const CoordType> channel(std::size_t i) const noexcept
+    {
+        return channels[i];
+    }
+
+    /// @returns point gathered from the channels
+    value_type operator [] (std::size_t index) const
+    {
+        value_type point;
+        for (std::size_t i = 0u; i < Dimension; ++i)
+        {
+            point[i] = channels[i][index];
+        }
+        return point;
+    }
+
+    /// @returns view of count points starting at offset
+    [[nodiscard]] PointCloudSoAView subview(std::size_t offset, std::size_t count) const noexcept
+    {
+        PointCloudSoAView view;
+        for (std::size_t i = 0u; i < Dimension; ++i)
+        {
+            view.channels[i] = channels[i].subspan(offset, count);
+        }
+        return view;
+    }
+};
+
+/// @brief point cloud keeping every coordinate in a channel of its own, aligned for vector loads,
+/// along with optional attribute channels, so loops over a coordinate are vectorized
+/// @tparam CoordType type of a coordinate
+/// @tparam Dimension number of coordinates of a point
+template <typename CoordType, std::size_t Dimension = 3u>
+class PointCloudSoA
+{
+public:
+    static constexpr auto Dim = Dimension;
+
+    using value_type = Point<CoordType, Dimension>;
+    using Channel = AlignedChannel<CoordType>;
+    using View = PointCloudSoAView<CoordType, Dimension>;
+
+    PointCloudSoA() = default;
+
+    /// @brief converts a point cloud of points stored one after another
+    /// @param pointCloud point cloud to convert
+    explicit PointCloudSoA(const PointCloud<value_type>& pointCloud)
+    {
+        reserve(pointCloud.size());
+        for (const auto& point : pointCloud)
+        {
+            emplace_back(point);
+        }
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        return coordinates[0u].size();
+    }
+
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return coordinates[0u].empty();
+    }
+
+    void reserve(std::size_t capacity)
+    {
+        for (auto& channel : coordinates)
+        {
+            channel.reserve(capacity);
+        }
+        for (auto& channel : attributes)
+        {
+            channel.reserve(capacity);
+        }
+    }
+
+    /// @brief resizes every channel, new points and attributes are zeroed
+    void resize(std::size_t size)
+    {
+        for (auto& channel : coordinates)
+        {
+            channel.resize(size);
+        }
+        for (auto& channel : attributes)
+        {
+            channel.resize(size);
+        }
+    }
+
+    /// @brief removes every point, attribute channels are kept
+    void clear() noexcept
+    {
+        resize(0u);
+    }
+
+    /// @brief appends a point, its attributes are zeroed
+    void emplace_back(const value_type& point)
+    {
+        for (std::size_t i = 0u; i < Dimension; ++i)
+        {
+            coordinates[i].push_back(point[i]);
+        }
+        for (auto& channel : attributes)
+        {
+            channel.push_back(CoordType{});
+        }
+    }
+
+    void push_back(const value_type& point)
+    {
+        emplace_back(point);
+    }
+
+    /// @returns point gathered from the channels
+    value_type operator [] (std::size_t index) const
+    {
+        value_type point;
+        for (std::size_t i = 0u; i < Dimension; ++i)
+        {
+            point[i] = coordinates[i][index];
+        }
+        return point;
+    }
+
+    /// @returns coordinates of every point along an axis
+    [[nodiscard]] std::span<CoordType> channel(std::size_t i) noexcept
+    {
+        return coordinates[i];
+    }
+
+    [[nodiscard]] std::span<const CoordType> channel(std::size_t i) const noexcept
+    {
+        return coordinates[i];
+    }
+
+    /// @brief adds an attribute channel, zeroed for the points already held
+    /// @returns index of the attribute channel
+    std::size_t addAttribute()
+    {
+        attributes.emplace_back(size());
+        return attributes.size() - 1u;
+    }
+
+    [[nodiscard]] std::size_t attributeCount() const noexcept
+    {
+        return attributes.size();
+    }
+
+    /// @returns values of an attribute of every point
+    [[nodiscard]] std::span<CoordType> attribute(std::size_t i) noexcept
+    {
+        return attributes[i];
+    }
+
+    [[nodiscard]] std::span<const CoordType> attribute(std::size_t i) const noexcept
+    {
+        return attributes[i];
+    }
+
+    [[nodiscard]] View view() const noexcept
+    {
+        View view;
+        for (std::size_t i = 0u; i < Dimension; ++i)
+        {
+            view.channels[i] = coordinates[i];
+        }
+        return view;
+    }
+
+    /// @returns point cloud of points stored one after another
+    [[nodiscard]] PointCloud<value_type> toPointCloud() const
+    {
+        PointCloud<value_type> pointCloud;
+        pointCloud.reserve(size());
+        for (std::size_t index = 0u; index < size(); ++index)
+        {
+            pointCloud.emplace_back((*this)[index]);
+        }
+        return pointCloud;
+    }
+
+private:
+    std::array<Channel, Dimension> coordinates{};
+    std::vector<Channel> attributes{};
+};
+
+template <typename CoordType>
+using PointCloud3DSoA = PointCloudSoA<CoordType, 3u>;
+
+} // namespace lidar_viewer::geometry::types
+
+#endif //LIDAR_VIEWER_POINTCLOUDSOA_H
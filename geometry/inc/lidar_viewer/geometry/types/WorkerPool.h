@@ -0,0 +1,194 @@
+#ifndef LIDAR_VIEWER_WORKERPOOL_H
+#define LIDAR_VIEWER_WORKERPOOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <future>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+namespace lidar_viewer::geometry::types
+{
+
+/// @brief threads running the tasks of one job at a time, the thread starting a job runs its tasks as well.
+/// Tasks are taken in order by whichever thread is free, running a job never allocates
+class WorkerPool
+{
+public:
+    /// @brief ctor
+    /// @param threads_ number of threads running tasks, the thread starting a job included, 1 at least
+    explicit WorkerPool(std::size_t threads_)
+    : threads{std::max<std::size_t>(threads_, 1u)}
+    , stopThread{false}
+    , runMutex{}
+    , mutex{}
+    , started{}
+    , finished{}
+    , job{}
+    , generation{0u}
+    , busy{0u}
+    , nextTask{0u}
+    , doneTasks{0u}
+    , workerFutures{}
+    {
+        workerFutures.reserve(threads - 1u);
+        for(std::size_t i = 1u; i < threads; ++i)
+        {
+            workerFutures.emplace_back(std::async(std::launch::async, [this]()
+            {
+                work();
+            }));
+        }
+    }
+
+    /// @brief dtor, waits for the workers to stop
+    ~WorkerPool() noexcept
+    {
+        {
+            std::lock_guard lGuard{mutex};
+            stopThread.store(true);
+        }
+        started.notify_all();
+        for(auto& workerFuture : workerFutures)
+        {
+            workerFuture.wait();
+        }
+    }
+
+    /// @returns number of threads running tasks, the thread starting a job included
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        return threads;
+    }
+
+    /// @brief runs task(index) for every index below tasks and waits for all of them to finish,
+    /// jobs started by several threads at once run one after another
+    /// @param tasks number of tasks
+    /// @param task function taking the index of a task, called from several threads at once
+    /// @throws first exception thrown by a task, the remaining tasks still run
+    template <typename TaskType>
+    void run(std::size_t tasks, TaskType&& task)
+    {
+        if(tasks == 0u)
+        {
+            return ;
+        }
+        std::lock_guard runGuard{runMutex};
+        std::unique_lock lock{mutex};
+        // workers late for the previous job leave before the next one is set up
+        finished.wait(lock, [this]() { return busy == 0u; });
+        const Job current{&invoke<std::remove_reference_t<TaskType>>, &task, tasks, nullptr};
+        job = current;
+        nextTask.store(0u);
+        doneTasks.store(0u);
+        ++generation;
+        lock.unlock();
+        started.notify_all();
+
+        runTasks(current);
+
+        lock.lock();
+        finished.wait(lock, [this, tasks]() { return doneTasks.load() == tasks && busy == 0u; });
+        const auto failure = job.failure;
+        job = Job{};
+        lock.unlock();
+        if(failure)
+        {
+            std::rethrow_exception(failure);
+        }
+    }
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator = (const WorkerPool&) = delete;
+    WorkerPool(WorkerPool&&) = delete;
+    WorkerPool& operator = (WorkerPool&&) = delete;
+
+private:
+    struct Job
+    {
+        void (*function)(void*, std::size_t){nullptr};
+        void* task{nullptr};
+        std::size_t tasks{0u};
+        std::exception_ptr failure{};
+    };
+
+    template <typename TaskType>
+    static void invoke(void* task, std::size_t index)
+    {
+        (*static_cast<TaskType*>(task))(index);
+    }
+
+    /// @brief runs tasks of a job until none is left
+    void runTasks(const Job& current)
+    {
+        for(auto index = nextTask.fetch_add(1u); index < current.tasks; index = nextTask.fetch_add(1u))
+        {
+            try
+            {
+                current.function(current.task, index);
+            }
+            catch (...)
+            {
+                std::lock_guard lGuard{mutex};
+                if(!job.failure)
+                {
+                    job.failure = std::current_exception();
+                }
+            }
+            if(doneTasks.fetch_add(1u) + 1u == current.tasks)
+            {
+                std::lock_guard lGuard{mutex};
+                finished.notify_all();
+            }
+        }
+    }
+
+    void work()
+    {
+        uint64_t seen{0u};
+        std::unique_lock lock{mutex};
+        while(!stopThread.load())
+        {
+            started.wait(lock, [this, &seen]() { return stopThread.load() || generation != seen; });
+            if(stopThread.load())
+            {
+                break ;
+            }
+            seen = generation;
+            const Job current{job.function, job.task, job.tasks, nullptr};
+            ++busy;
+            lock.unlock();
+            runTasks(current);
+            lock.lock();
+            if(--busy == 0u)
+            {
+                finished.notify_all();
+            }
+        }
+    }
+
+    const std::size_t threads;
+    std::atomic<bool> stopThread;
+    /// held while a job runs
+    std::mutex runMutex;
+    std::mutex mutex;
+    std::condition_variable started;
+    std::condition_variable finished;
+    /// job being run, mutex held
+    Job job;
+    uint64_t generation;
+    /// workers running tasks of the job, mutex held
+    std::size_t busy;
+    std::atomic<std::size_t> nextTask;
+    std::atomic<std::size_t> doneTasks;
+    std::vector<std::future<void>> workerFutures;
+};
+
+} // namespace lidar_viewer::geometry::types
+
+#endif //LIDAR_VIEWER_WORKERPOOL_H
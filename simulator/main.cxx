@@ -0,0 +1,158 @@
+#include "lidar_viewer/dev/CygLidarD1.h"
+#include "lidar_viewer/dev/CygLidarD1Simulator.h"
+#include "lidar_viewer/dev/PointCloudReader.h"
+#include "lidar_viewer/dev/SerialPort.h"
+
+#include <atomic>
+#include <csignal>
+#include <iostream>
+#include <memory>
+#include <thread>
+
+#include <termios.h>
+#include <unistd.h>
+
+namespace
+{
+
+std::atomic<bool> stopRequested{false};
+
+void signalHandler(int )
+{
+    stopRequested.store(true);
+}
+
+std::string usageString()
+{
+    using namespace std::string_literals;
+    auto usageStr = "Usage: \n\t./lidar_simulator"
+            "\n\t\t-r frameRate [frames per second] "
+            "\n\t\t-b baudRate the frames are paced at { 0 - as fast as possible, N - N baud } "
+            "\n\t\t-t duration [in s] { 0 - until interrupted } "
+            "\n\t\t-x benchmark, read the simulated lidar through SerialPort, CygLidarD1 and PointCloudReader "
+            "\n\t\t-m lidarMode for benchmark { 2D,3D,Dual } "s;
+    return usageStr;
+}
+
+void printStatistics(const lidar_viewer::dev::CygLidarD1Simulator& simulator)
+{
+    const auto statistics = simulator.statistics();
+    std::cout << "requests: " << statistics.requests
+              << ", 2D frames: " << statistics.frames2d
+              << ", 3D frames: " << statistics.frames3d
+              << ", bytes written: " << statistics.bytesWritten
+              << ", bytes dropped: " << statistics.bytesDropped
+              << ", periods missed: " << statistics.periodsMissed << "\n";
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    using namespace lidar_viewer::dev;
+    using namespace std::chrono_literals;
+    using namespace std::string_literals;
+    using Mode = CygLidarD1::Mode;
+
+    ::signal(SIGTERM, signalHandler);
+    ::signal(SIGINT, signalHandler); // Ctrl-C...
+
+    int opt;
+    CygLidarD1Simulator::Config config{};
+    double duration{0.};
+    auto benchmark{false};
+    auto mode{Mode::Mode3D};
+
+    while( ( opt = ::getopt(argc, argv, "r:b:t:m:xh")) != -1 )
+    {
+        switch ( opt )
+        {
+            case 'r':
+            {
+                char* endptr = nullptr;
+                config.frameRate = ::strtod(optarg, &endptr);
+                if(endptr == optarg || config.frameRate <= 0.)
+                {
+                    std::cerr << "Failed to parse the option for frame rate\n" << usageString() << "\n";
+                    return EXIT_FAILURE;
+                }
+                break;
+            }
+            case 'b':
+                config.baudRate = static_cast<unsigned int>(::strtoul(optarg, nullptr, 10));
+                break;
+            case 't':
+                duration = ::strtod(optarg, nullptr);
+                break;
+            case 'm':
+            {
+                const std::string lMode{optarg};
+                mode =
+                    lMode == "2D"s? Mode::Mode2D :
+                    lMode == "3D"s? Mode::Mode3D :
+                    lMode == "Dual"s? Mode::Dual :
+                    Mode::Mode3D;
+                break;
+            }
+            case 'x':
+                benchmark = true;
+                break;
+            case 'h':
+                std::cout << usageString() << "\n";
+                return 0;
+            default:
+                std::cerr << usageString() << "\n";
+                return EXIT_FAILURE;
+        }
+    }
+
+    try
+    {
+        CygLidarD1Simulator simulator{config};
+        simulator.start();
+        std::cout << "Simulated lidar: " << simulator.deviceName() << "\n";
+
+        std::unique_ptr<IoStream> input{};
+        std::unique_ptr<CygLidarD1> lidar{};
+        std::unique_ptr<PointCloudReader<CygLidarD1>> pointCloudReader{};
+        if(benchmark)
+        {
+            input = std::make_unique<IoStream>(std::make_unique<SerialPort>(simulator.deviceName(), B3000000));
+            lidar = std::make_unique<CygLidarD1>(*input);
+            lidar->run(mode);
+            pointCloudReader = std::make_unique<PointCloudReader<CygLidarD1>>(*lidar);
+            pointCloudReader->start(mode);
+        }
+
+        const auto begin = std::chrono::steady_clock::now();
+        const auto end = begin + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<double>(duration));
+        for(auto nextReport = begin + 1s; !stopRequested.load(); nextReport += 1s)
+        {
+            std::this_thread::sleep_until(nextReport);
+            printStatistics(simulator);
+            if(duration > 0. && std::chrono::steady_clock::now() >= end)
+            {
+                break;
+            }
+        }
+
+        if(benchmark)
+        {
+            pointCloudReader->stop();
+            const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+            const auto statistics = lidar->parserStatistics();
+            std::cout << "Parsed frames: " << statistics.framesParsed
+                      << " (" << static_cast<double>(statistics.framesParsed) / elapsed << " frames/s)"
+                      << ", bytes skipped: " << statistics.bytesSkipped
+                      << ", frames recovered: " << statistics.framesRecovered
+                      << ", checksum errors: " << statistics.checksumErrors << "\n";
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << e.what() << "\n";
+        return EXIT_FAILURE;
+    }
+    return 0;
+}
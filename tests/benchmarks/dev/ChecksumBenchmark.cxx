@@ -0,0 +1,54 @@
+#include "lidar_viewer/dev/Checksum.h"
+#include "lidar_viewer/dev/CygLidarD1.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+namespace lidar_viewer::tests::benchmarks
+{
+
+namespace
+{
+
+uint8_t referenceChecksum(std::span<const uint8_t> data)
+{
+    uint8_t checksum{0u};
+    for(const auto value : data)
+    {
+        checksum ^= value;
+    }
+    return checksum;
+}
+
+} // namespace
+
+TEST(ChecksumBenchmark, Throughput3d)
+{
+    constexpr auto frames = 2000u;
+    std::vector<uint8_t> data(dev::CygLidarD1::FRAME_SIZE_3D + 2u);
+    for(auto i = 0u; i < data.size(); ++i)
+    {
+        data[i] = static_cast<uint8_t>(i * 31u);
+    }
+    const auto measure = [&data](const char* name, auto&& checksumFunction)
+    {
+        uint8_t checksum{0u};
+        const auto begin = std::chrono::steady_clock::now();
+        for(auto i = 0u; i < frames; ++i)
+        {
+            data[i % data.size()] ^= checksum;
+            checksum = checksumFunction(std::span<const uint8_t>{data});
+        }
+        const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+        std::cout << name << ": " << frames / elapsed << " frames/s\n";
+        return checksum;
+    };
+    const auto bytewise = measure("bytewise XOR", referenceChecksum);
+    const auto vectorized = measure("xorChecksum", dev::xorChecksum);
+    ASSERT_EQ(bytewise, vectorized);
+}
+
+} // namespace lidar_viewer::tests::benchmarks
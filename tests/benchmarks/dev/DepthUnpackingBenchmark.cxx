@@ -0,0 +1,52 @@
+#include "lidar_viewer/dev/DepthUnpacking.h"
+#include "lidar_viewer/dev/CygLidarD1.h"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <chrono>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <vector>
+
+namespace lidar_viewer::tests::benchmarks
+{
+
+namespace
+{
+
+constexpr std::array<dev::UnpackKernel, 3u> kernels{dev::UnpackKernel::Scalar, dev::UnpackKernel::Ssse3,
+                                                    dev::UnpackKernel::Avx2};
+
+std::string kernelName(dev::UnpackKernel kernel)
+{
+    return kernel == dev::UnpackKernel::Avx2 ? "AVX2" : kernel == dev::UnpackKernel::Ssse3 ? "SSSE3" : "scalar";
+}
+
+} // namespace
+
+TEST(DepthUnpackingBenchmark, Throughput3d)
+{
+    constexpr auto frames = 200u;
+    std::vector<uint8_t> packed(dev::CygLidarD1::FRAME_SIZE_3D - 1u);
+    std::iota(packed.begin(), packed.end(), 0u);
+    dev::CygLidarD1::PointCloud3D depths{};
+    for(const auto kernel : kernels)
+    {
+        if(!dev::unpackKernelSupported(kernel))
+        {
+            continue;
+        }
+        const auto begin = std::chrono::steady_clock::now();
+        for(auto i = 0u; i < frames; ++i)
+        {
+            dev::unpack3dDepths(packed, depths, kernel);
+        }
+        const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+        std::cout << "unpack3dDepths " << kernelName(kernel) << ": " << frames / elapsed << " frames/s\n";
+        RecordProperty(kernelName(kernel) + "FramesPerSecond", std::to_string(static_cast<uint64_t>(frames / elapsed)));
+    }
+}
+
+} // namespace lidar_viewer::tests::benchmarks
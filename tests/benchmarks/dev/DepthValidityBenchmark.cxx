@@ -0,0 +1,48 @@
+#include "lidar_viewer/dev/DepthValidity.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace lidar_viewer::tests::benchmarks
+{
+
+namespace
+{
+
+/// depths of every kind, error codes included
+std::vector<uint16_t> randomDepths(std::size_t count, unsigned int seed)
+{
+    std::mt19937 generator{seed};
+    std::uniform_int_distribution<unsigned int> distribution{0u, 4095u};
+    std::vector<uint16_t> depths(count);
+    for(auto& depth : depths)
+    {
+        const auto value = distribution(generator);
+        depth = value % 7u == 0u ? static_cast<uint16_t>(4081u + value % 3u) : static_cast<uint16_t>(value);
+    }
+    return depths;
+}
+
+} // namespace
+
+TEST(DepthValidityBenchmark, Throughput3d)
+{
+    constexpr auto frames = 2000u;
+    const auto depths = randomDepths(9600u, 5u);
+    std::vector<uint64_t> mask(150u);
+    uint32_t valid{0u};
+    const auto begin = std::chrono::steady_clock::now();
+    for(auto i = 0u; i < frames; ++i)
+    {
+        valid += dev::classify3dDepths(depths, 51u, 3000u, mask).valid;
+    }
+    const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    std::cout << "classify3dDepths: " << frames / elapsed << " frames/s\n";
+    ASSERT_GT(valid, 0u);
+}
+
+} // namespace lidar_viewer::tests::benchmarks
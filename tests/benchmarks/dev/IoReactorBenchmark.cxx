@@ -0,0 +1,166 @@
+#include "lidar_viewer/dev/IoReactor.h"
+#include "lidar_viewer/dev/CygLidarD1.h"
+
+#include <gtest/gtest.h>
+
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace lidar_viewer::tests::benchmarks
+{
+
+namespace
+{
+
+/// pseudo terminal standing in for the lidar
+class PseudoTerminal
+{
+public:
+    PseudoTerminal()
+    : master{::posix_openpt(O_RDWR | O_NOCTTY)}
+    {
+        if(master < 0 || ::grantpt(master) != 0 || ::unlockpt(master) != 0)
+        {
+            throw std::runtime_error{"Unable to open a pseudo terminal"};
+        }
+    }
+
+    ~PseudoTerminal() noexcept
+    {
+        ::close(master);
+    }
+
+    [[nodiscard]] std::string slaveName() const
+    {
+        return ::ptsname(master);
+    }
+
+    [[nodiscard]] bool write(const void* ptr, std::size_t size) const
+    {
+        auto uptr = reinterpret_cast<const uint8_t*>(ptr);
+        while(size > 0u)
+        {
+            const auto wret = ::write(master, uptr, size);
+            if(wret <= 0)
+            {
+                return false;
+            }
+            uptr += wret;
+            size -= static_cast<std::size_t>(wret);
+        }
+        return true;
+    }
+
+private:
+    int master;
+};
+
+/// simulated lidar, the device side of a pseudo terminal and the lidar parsing what the port receives
+struct SimulatedDevice
+{
+    PseudoTerminal terminal{};
+    std::unique_ptr<dev::IoStream> ioStream{};
+    const dev::SerialPort* port{};
+    std::unique_ptr<dev::CygLidarD1> lidar{};
+
+    SimulatedDevice()
+    {
+        auto serialPort = std::make_unique<dev::SerialPort>(terminal.slaveName(), B3000000);
+        port = serialPort.get();
+        ioStream = std::make_unique<dev::IoStream>(std::move(serialPort));
+        lidar = std::make_unique<dev::CygLidarD1>(*ioStream);
+    }
+};
+
+std::vector<uint8_t> make3dFrames(std::size_t count)
+{
+    dev::CygLidarD1::Frame3D::Payload payload{};
+    payload[0u] = 0x08u;
+    payload[1u] = 0x23u;
+    payload[2u] = 0x61u;
+    payload[3u] = 0x45u;
+    const auto frame3d = std::make_unique<dev::CygLidarD1::Frame3D>(payload);
+    std::vector<uint8_t> stream;
+    stream.reserve(count * frame3d->rawSize());
+    for(auto i = 0u; i < count; ++i)
+    {
+        stream.insert(stream.end(), frame3d->raw(), frame3d->raw() + frame3d->rawSize());
+    }
+    return stream;
+}
+
+} // namespace
+
+TEST(IoReactorBenchmark, ManyDevicesOnSingleThread)
+{
+    using namespace std::chrono_literals;
+    constexpr auto deviceCount = 8u;
+    constexpr auto framesPerDevice = 100u;
+
+    std::vector<std::unique_ptr<SimulatedDevice>> devices;
+    for(auto i = 0u; i < deviceCount; ++i)
+    {
+        devices.emplace_back(std::make_unique<SimulatedDevice>());
+    }
+
+    dev::IoReactor reactor{};
+    for(const auto& device : devices)
+    {
+        reactor.add(*device->port, *device->lidar);
+    }
+    ASSERT_EQ(reactor.devices(), deviceCount);
+
+    const auto stream = make3dFrames(framesPerDevice);
+    const auto begin = std::chrono::steady_clock::now();
+    reactor.start();
+    std::vector<std::future<bool>> writers;
+    for(const auto& device : devices)
+    {
+        writers.emplace_back(std::async(std::launch::async, [&stream, &terminal = device->terminal]()
+        {
+            return terminal.write(stream.data(), stream.size());
+        }));
+    }
+    for(auto& writer : writers)
+    {
+        ASSERT_TRUE(writer.get());
+    }
+
+    const auto allParsed = [&devices]()
+    {
+        return std::all_of(devices.begin(), devices.end(), [](const auto& device)
+        {
+            return device->lidar->parserStatistics().framesParsed == framesPerDevice;
+        });
+    };
+    const auto deadline = begin + 10s;
+    while(!allParsed() && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(1ms);
+    }
+    const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    reactor.stop();
+
+    for(const auto& device : devices)
+    {
+        ASSERT_EQ(device->lidar->parserStatistics().framesParsed, framesPerDevice);
+    }
+    const auto statistics = reactor.statistics();
+    const auto frames = static_cast<double>(deviceCount * framesPerDevice);
+    std::cout << "IoReactor : " << deviceCount << " devices, " << frames / elapsed << " frames/s, "
+              << statistics.wakeups << " wakeups, " << statistics.reads << " reads\n";
+    RecordProperty("framesPerSecond", std::to_string(static_cast<uint64_t>(frames / elapsed)));
+}
+
+} // namespace lidar_viewer::tests::benchmarks
@@ -0,0 +1,161 @@
+#include "lidar_viewer/dev/PointCloudReader.h"
+#include "lidar_viewer/dev/SerialPort.h"
+
+#include <gtest/gtest.h>
+
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace lidar_viewer::tests::benchmarks
+{
+
+namespace
+{
+
+/// pseudo terminal standing in for the lidar
+class PseudoTerminal
+{
+public:
+    PseudoTerminal()
+    : master{::posix_openpt(O_RDWR | O_NOCTTY)}
+    {
+        if(master < 0 || ::grantpt(master) != 0 || ::unlockpt(master) != 0)
+        {
+            throw std::runtime_error{"Unable to open a pseudo terminal"};
+        }
+    }
+
+    ~PseudoTerminal() noexcept
+    {
+        ::close(master);
+    }
+
+    [[nodiscard]] std::string slaveName() const
+    {
+        return ::ptsname(master);
+    }
+
+    [[nodiscard]] bool write(const void* ptr, std::size_t size) const
+    {
+        auto uptr = reinterpret_cast<const uint8_t*>(ptr);
+        while(size > 0u)
+        {
+            const auto wret = ::write(master, uptr, size);
+            if(wret <= 0)
+            {
+                return false;
+            }
+            uptr += wret;
+            size -= static_cast<std::size_t>(wret);
+        }
+        return true;
+    }
+
+private:
+    int master;
+};
+
+/// cpu time the process spent so far
+std::chrono::microseconds cpuTime()
+{
+    rusage usage{};
+    ::getrusage(RUSAGE_SELF, &usage);
+    return std::chrono::seconds{usage.ru_utime.tv_sec + usage.ru_stime.tv_sec}
+         + std::chrono::microseconds{usage.ru_utime.tv_usec + usage.ru_stime.tv_usec};
+}
+
+} // namespace
+
+// Frames are published as soon as they are received, compared with the loop sleeping between reads
+TEST(PointCloudReaderBenchmark, EventDrivenAgainstSleepPolling)
+{
+    using namespace std::chrono_literals;
+    using dev::CygLidarD1;
+    PseudoTerminal terminal{};
+    dev::IoStream ioStream{std::make_unique<dev::SerialPort>(terminal.slaveName(), B3000000)};
+    CygLidarD1 lidar{ioStream};
+
+    auto payload = std::make_unique<CygLidarD1::Frame3D::Payload>();
+    (*payload)[0u] = 0x08u;
+    const auto frame = std::make_unique<CygLidarD1::Frame3D>(*payload);
+
+    constexpr auto frames = 100u;
+    struct Measurement
+    {
+        std::chrono::microseconds medianLatency;
+        std::chrono::microseconds maxLatency;
+        std::chrono::microseconds cpuTime;
+    };
+    uint64_t sequence{0u};
+    const auto measure = [&]()
+    {
+        std::vector<std::chrono::microseconds> latencies;
+        const auto cpuBefore = cpuTime();
+        for(auto i = 0u; i < frames; ++i)
+        {
+            // frames land in every phase of a polling period
+            std::this_thread::sleep_for(std::chrono::microseconds{1000u + 97u * i % 2000u});
+            EXPECT_TRUE(terminal.write(frame->raw(), frame->rawSize()));
+            const auto written = std::chrono::steady_clock::now();
+            const auto pointCloud = lidar.waitFor3dPointCloud(sequence, 1s);
+            EXPECT_TRUE(pointCloud);
+            if(!pointCloud)
+            {
+                break;
+            }
+            sequence = pointCloud->stamp.sequence;
+            latencies.emplace_back(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - written));
+        }
+        const auto spent = cpuTime() - cpuBefore;
+        std::sort(latencies.begin(), latencies.end());
+        return latencies.empty() ? Measurement{} : Measurement{latencies[latencies.size() / 2u], latencies.back(), spent};
+    };
+
+    Measurement eventDriven{};
+    {
+        dev::PointCloudReader<CygLidarD1> reader{lidar};
+        reader.start(CygLidarD1::Mode::Mode3D);
+        eventDriven = measure();
+        reader.stop();
+    }
+    Measurement sleepPolling{};
+    {
+        std::atomic<bool> stopThread{false};
+        auto loop = std::async(std::launch::async, [&lidar, &stopThread]()
+        {
+            for( ; !stopThread.load() ; )
+            {
+                lidar.readAndParse();
+                std::this_thread::sleep_for(2ms);
+            }
+        });
+        sleepPolling = measure();
+        stopThread = true;
+        loop.wait();
+    }
+    ASSERT_EQ(sequence, 2u * frames);
+
+    const auto print = [](const char* name, const Measurement& measurement)
+    {
+        std::cout << name << ": median latency " << measurement.medianLatency.count() << "us, max latency "
+                  << measurement.maxLatency.count() << "us, cpu time " << measurement.cpuTime.count() << "us for "
+                  << frames << " frames\n";
+    };
+    print("event driven reader", eventDriven);
+    print("reader sleeping 2ms between reads", sleepPolling);
+}
+
+} // namespace lidar_viewer::tests::benchmarks
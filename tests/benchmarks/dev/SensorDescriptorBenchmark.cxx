@@ -0,0 +1,172 @@
+#include "lidar_viewer/dev/SensorDescriptor.h"
+#include "lidar_viewer/dev/CygLidarD1.h"
+#include "lidar_viewer/dev/DepthPacking.h"
+#include "lidar_viewer/dev/IoStreamBase.h"
+#include "lidar_viewer/geometry/functions/GetDepthImageToPointCloudProcessor.h"
+#include "lidar_viewer/geometry/functions/GetParallelDepthImageToPointCloudProcessor.h"
+#include "lidar_viewer/geometry/types/ScreenRanges.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace lidar_viewer::tests::benchmarks
+{
+
+namespace
+{
+
+/// sensors of 4 and 16 times the pixels of CygLidar D1, frames of the latter do not fit the 16 bit length field
+using Sensor4x = dev::SensorDescriptor<320u, 120u, 320u, 12u, 120u, 65u>;
+using Sensor16x = dev::SensorDescriptor<640u, 240u, 640u, 12u, 120u, 65u>;
+
+struct NullStream
+        : dev::IoStreamBase
+{
+    void open() override {}
+    unsigned int read(void*, unsigned int, const std::chrono::milliseconds) const override { return 0u; }
+    void write(const void*, unsigned int, bool) const override {}
+    void close() const override {}
+};
+
+/// depths of a slanted wall
+template <typename Sensor>
+std::vector<uint16_t> wall()
+{
+    std::vector<uint16_t> depths(Sensor::DEPTHS_3D);
+    for(std::size_t i = 0u; i < depths.size(); ++i)
+    {
+        depths[i] = static_cast<uint16_t>(40u + (i % Sensor::WIDTH_3D) * 7u % 3100u + i / Sensor::WIDTH_3D);
+    }
+    return depths;
+}
+
+template <typename Lidar>
+std::vector<uint8_t> raw3dFrame(const std::vector<uint16_t>& depths)
+{
+    auto payload = std::make_unique<typename Lidar::Frame3D::Payload>();
+    (*payload)[0u] = static_cast<uint8_t>(Lidar::Mode::Mode3D);
+    dev::pack12(depths, std::span{*payload}.subspan(1u));
+    const auto frame = std::make_unique<typename Lidar::Frame3D>(*payload);
+    return {frame->raw(), frame->raw() + frame->rawSize()};
+}
+
+/// depth image classified the way lidar point clouds are, for sensors no lidar can be instantiated for
+template <typename Sensor>
+struct ClassifiedDepths
+        : std::array<uint16_t, Sensor::DEPTHS_3D>
+{
+    dev::DepthValidity<Sensor::DEPTHS_3D> validity{};
+};
+
+template <typename Sensor>
+void benchmarkFeed(const std::string& name)
+{
+    using Lidar = dev::BasicCygLidar<Sensor>;
+    constexpr auto frames = 100u;
+    dev::IoStream ioStream{std::make_unique<NullStream>()};
+    Lidar lidar{ioStream};
+    const auto raw = raw3dFrame<Lidar>(wall<Sensor>());
+    const auto begin = std::chrono::steady_clock::now();
+    for(auto i = 0u; i < frames; ++i)
+    {
+        lidar.feed(raw);
+    }
+    const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    ASSERT_EQ(lidar.demuxStatistics().frames3d, frames);
+    std::cout << "feed " << name << ": " << frames / elapsed << " frames/s, "
+              << frames * Sensor::DEPTHS_3D / elapsed / 1e6 << " Mpx/s\n";
+}
+
+template <typename Sensor>
+void benchmarkConversion(const std::string& name)
+{
+    constexpr auto frames = 5u;
+    constexpr geometry::types::UintRange depthRange{51u, 3000u};
+    const auto depths = wall<Sensor>();
+    auto image = std::make_unique<ClassifiedDepths<Sensor>>();
+    std::copy(depths.begin(), depths.end(), image->begin());
+    image->validity.counts = dev::classify3dDepths(*image, depthRange.first, depthRange.second, image->validity.mask);
+
+    geometry::types::ScreenRangeGl screenRange{};
+    const auto processor = geometry::functions::getDepthImageToPointCloudProcessor<Sensor, ClassifiedDepths<Sensor>>(
+            depthRange, screenRange);
+    geometry::types::PointCloud3D<float> pointCloud;
+    pointCloud.reserve(Sensor::DEPTHS_3D);
+    const auto begin = std::chrono::steady_clock::now();
+    for(auto i = 0u; i < frames; ++i)
+    {
+        pointCloud.clear();
+        processor(*image, pointCloud);
+    }
+    const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    ASSERT_EQ(pointCloud.size(), image->validity.counts.valid);
+    std::cout << "conversion " << name << ": " << frames / elapsed << " frames/s, "
+              << frames * Sensor::DEPTHS_3D / elapsed / 1e6 << " Mpx/s\n";
+}
+
+/// conversion on 1 to all cores, tiles of rows spread over the threads of a pool
+template <typename Sensor>
+void benchmarkParallelConversion(const std::string& name)
+{
+    constexpr auto frames = 50u;
+    constexpr geometry::types::UintRange depthRange{51u, 3000u};
+    const auto depths = wall<Sensor>();
+    auto image = std::make_unique<ClassifiedDepths<Sensor>>();
+    std::copy(depths.begin(), depths.end(), image->begin());
+    image->validity.counts = dev::classify3dDepths(*image, depthRange.first, depthRange.second, image->validity.mask);
+
+    geometry::types::ScreenRangeGl screenRange{};
+    const auto depthAttributes = geometry::types::sensorDepthFrameAttributes<Sensor>(depthRange);
+    geometry::types::PointCloud3D<float> pointCloud;
+    pointCloud.reserve(Sensor::DEPTHS_3D);
+    const auto cores = std::max(std::thread::hardware_concurrency(), 1u);
+    double singleThreaded{};
+    for(auto threads = 1u; ; threads = std::min(threads * 2u, cores))
+    {
+        geometry::types::WorkerPool pool{threads};
+        const auto processor = geometry::functions::getParallelDepthImageToPointCloudProcessor<
+                ClassifiedDepths<Sensor>>(depthAttributes, screenRange, pool);
+        const auto begin = std::chrono::steady_clock::now();
+        for(auto i = 0u; i < frames; ++i)
+        {
+            pointCloud.clear();
+            processor(*image, pointCloud);
+        }
+        const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+        ASSERT_EQ(pointCloud.size(), image->validity.counts.valid);
+        singleThreaded = threads == 1u ? elapsed : singleThreaded;
+        std::cout << "parallel conversion " << name << " " << threads << " threads: " << frames / elapsed
+                  << " frames/s, " << frames * Sensor::DEPTHS_3D / elapsed / 1e6 << " Mpx/s, speedup "
+                  << singleThreaded / elapsed << "\n";
+        if(threads == cores)
+        {
+            break ;
+        }
+    }
+}
+
+} // namespace
+
+TEST(SensorDescriptorBenchmark, ThroughputByResolution)
+{
+    benchmarkFeed<dev::CygLidarD1Sensor>("1x");
+    benchmarkFeed<Sensor4x>("4x");
+    benchmarkConversion<dev::CygLidarD1Sensor>("1x");
+    benchmarkConversion<Sensor4x>("4x");
+    benchmarkConversion<Sensor16x>("16x");
+}
+
+TEST(SensorDescriptorBenchmark, ParallelConversionScaling)
+{
+    benchmarkParallelConversion<dev::CygLidarD1Sensor>("1x");
+    benchmarkParallelConversion<Sensor16x>("16x");
+}
+
+} // namespace lidar_viewer::tests::benchmarks
@@ -0,0 +1,55 @@
+#include "lidar_viewer/geometry/types/PointCloudSoA.h"
+#include "lidar_viewer/geometry/functions/Utilities.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+#include <random>
+
+namespace lidar_viewer::tests::benchmarks
+{
+
+using namespace geometry::types;
+using namespace geometry::functions;
+
+namespace
+{
+
+PointCloud3D<float> randomPointCloud(std::size_t size)
+{
+    std::mt19937 generator{42u};
+    std::uniform_real_distribution<float> distribution{-1.f, 1.f};
+    PointCloud3D<float> pointCloud;
+    for(std::size_t i = 0u; i < size; ++i)
+    {
+        pointCloud.emplace_back(Point3D<float>{{distribution(generator), distribution(generator),
+                                                distribution(generator)}});
+    }
+    return pointCloud;
+}
+
+} // namespace
+
+TEST(PointCloudSoABenchmark, BoundingBoxThroughput)
+{
+    constexpr auto runs = 20u;
+    const auto pointCloud = randomPointCloud(9600u);
+    const PointCloud3DSoA<float> soa{pointCloud};
+    const auto measure = [](const auto& cloud)
+    {
+        float sink{0.f};
+        const auto begin = std::chrono::steady_clock::now();
+        for(auto i = 0u; i < runs; ++i)
+        {
+            sink += calculateBoundingBoxFromPointCloud(cloud).hi[0];
+        }
+        const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+        EXPECT_GT(sink, 0.f);
+        return runs * cloud.size() / elapsed / 1e6;
+    };
+    std::cout << "bounding box, points stored one after another: " << measure(pointCloud) << " Mpoints/s, "
+              << "coordinate channels: " << measure(soa) << " Mpoints/s\n";
+}
+
+} // namespace lidar_viewer::tests::benchmarks
@@ -0,0 +1,60 @@
+#include "lidar_viewer/dev/Checksum.h"
+#include "lidar_viewer/dev/CygLidarD1.h"
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+namespace lidar_viewer::tests::units
+{
+
+namespace
+{
+
+uint8_t referenceChecksum(std::span<const uint8_t> data)
+{
+    uint8_t checksum{0u};
+    for(const auto value : data)
+    {
+        checksum ^= value;
+    }
+    return checksum;
+}
+
+} // namespace
+
+TEST(ChecksumTest, MatchesBytewiseXor)
+{
+    std::mt19937 generator{7u};
+    std::uniform_int_distribution<unsigned int> distribution{0u, 255u};
+    std::vector<uint8_t> data(300u);
+    for(auto& value : data)
+    {
+        value = static_cast<uint8_t>(distribution(generator));
+    }
+    // every length and alignment runs through other parts of the kernels
+    for(auto offset = 0u; offset < 8u; ++offset)
+    {
+        for(auto size = 0u; offset + size <= data.size(); ++size)
+        {
+            const auto span = std::span{data}.subspan(offset, size);
+            ASSERT_EQ(dev::xorChecksum(span), referenceChecksum(span)) << "offset " << offset << ", size " << size;
+        }
+    }
+}
+
+TEST(ChecksumTest, SingleBitFlipDetected)
+{
+    std::vector<uint8_t> data(dev::CygLidarD1::FRAME_SIZE_3D, 0xa5u);
+    const auto checksum = dev::xorChecksum(data);
+    for(auto position = 0u; position < data.size(); position += 97u)
+    {
+        data[position] ^= 0x10u;
+        ASSERT_NE(dev::xorChecksum(data), checksum) << "position " << position;
+        data[position] ^= 0x10u;
+    }
+}
+
+} // namespace lidar_viewer::tests::units
@@ -0,0 +1,199 @@
+#include "lidar_viewer/dev/CommandChannel.h"
+#include "lidar_viewer/dev/CygLidarD1.h"
+#include "lidar_viewer/dev/IoStreamBase.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace lidar_viewer::tests::units
+{
+
+namespace
+{
+
+/// stream keeping the requests written to it
+struct RecordingStream
+        : dev::IoStreamBase
+{
+    explicit RecordingStream(std::vector<std::vector<uint8_t>>& written_)
+    : written{written_}
+    { }
+
+    void open() override {}
+    unsigned int read(void*, unsigned int, const std::chrono::milliseconds) const override { return 0u; }
+    void write(const void* ptr, unsigned int size, bool) const override
+    {
+        const auto* bytes = static_cast<const uint8_t*>(ptr);
+        written.emplace_back(bytes, bytes + size);
+    }
+    void close() const override {}
+
+    std::vector<std::vector<uint8_t>>& written;
+};
+
+std::vector<uint8_t> raw(const dev::Req2& frame)
+{
+    return {frame.raw(), frame.raw() + frame.rawSize()};
+}
+
+} // namespace
+
+TEST(CommandChannelTest, RepliesAcknowledgeRequestsOfTheirType)
+{
+    using namespace std::chrono_literals;
+    std::vector<std::vector<uint8_t>> written;
+    dev::IoStream ioStream{std::make_unique<RecordingStream>(written)};
+    dev::CommandChannel commands{ioStream, 1s};
+
+    // requests are written at once, none waits for a reply
+    auto channel = commands.send(raw(dev::Req2({0x0Fu, 3u})));
+    auto sensitivity = commands.send(raw(dev::Req2({0x11u, 9u})));
+    auto secondChannel = commands.send(raw(dev::Req2({0x0Fu, 4u})));
+    ASSERT_EQ(written.size(), 3u);
+    ASSERT_EQ(commands.inFlight(), 3u);
+    // a frame follows the requests, their effect
+    commands.frameReceived();
+
+    // replies of different types arrive in any order
+    ASSERT_TRUE(commands.reply(raw(dev::Req2({0x11u, 0u}))));
+    ASSERT_EQ(sensitivity.wait_for(0s), std::future_status::ready);
+    ASSERT_EQ(channel.wait_for(0s), std::future_status::timeout);
+    ASSERT_TRUE(commands.reply(raw(dev::Req2({0x0Fu, 0u}))));
+    const auto acknowledged = channel.get();
+    ASSERT_EQ(acknowledged.status, dev::CommandChannel::Status::Acknowledged);
+    ASSERT_TRUE(acknowledged.effectLatency);
+    ASSERT_LE(*acknowledged.effectLatency, acknowledged.latency);
+    ASSERT_EQ(secondChannel.wait_for(0s), std::future_status::timeout);
+    ASSERT_TRUE(commands.reply(raw(dev::Req2({0x0Fu, 0u}))));
+    ASSERT_EQ(secondChannel.get().status, dev::CommandChannel::Status::Acknowledged);
+
+    // nothing waits for another reply
+    ASSERT_FALSE(commands.reply(raw(dev::Req2({0x0Fu, 0u}))));
+    const auto statistics = commands.statistics();
+    ASSERT_EQ(statistics.sent, 3u);
+    ASSERT_EQ(statistics.acknowledged, 3u);
+    ASSERT_EQ(statistics.unmatchedReplies, 1u);
+    ASSERT_GE(statistics.maxLatency, statistics.lastLatency);
+    ASSERT_GE(statistics.maxEffectLatency, statistics.lastEffectLatency);
+    ASSERT_EQ(commands.inFlight(), 0u);
+}
+
+TEST(CommandChannelTest, AcknowledgedRequestsAwaitTheirEffect)
+{
+    using namespace std::chrono_literals;
+    std::vector<std::vector<uint8_t>> written;
+    dev::IoStream ioStream{std::make_unique<RecordingStream>(written)};
+    dev::CommandChannel commands{ioStream, 10ms};
+
+    auto result = commands.send(raw(dev::Req2({0x11u, 9u})));
+    ASSERT_TRUE(commands.reply(raw(dev::Req2({0x11u, 0u}))));
+    ASSERT_EQ(result.wait_for(0s), std::future_status::timeout);
+    // the reply was matched, a second one of the type waits for another request
+    ASSERT_FALSE(commands.reply(raw(dev::Req2({0x11u, 0u}))));
+    std::this_thread::sleep_for(1ms);
+    commands.frameReceived();
+    const auto acknowledged = result.get();
+    ASSERT_EQ(acknowledged.status, dev::CommandChannel::Status::Acknowledged);
+    ASSERT_TRUE(acknowledged.effectLatency);
+    ASSERT_GT(*acknowledged.effectLatency, acknowledged.latency);
+    ASSERT_EQ(commands.statistics().lastEffectLatency, *acknowledged.effectLatency);
+
+    // acknowledged without a frame following, the request completes once it times out
+    result = commands.send(raw(dev::Req2({0x11u, 9u})));
+    ASSERT_TRUE(commands.reply(raw(dev::Req2({0x11u, 0u}))));
+    std::this_thread::sleep_for(20ms);
+    commands.expire();
+    const auto withoutEffect = result.get();
+    ASSERT_EQ(withoutEffect.status, dev::CommandChannel::Status::Acknowledged);
+    ASSERT_FALSE(withoutEffect.effectLatency);
+    ASSERT_LT(withoutEffect.latency, 10ms);
+    ASSERT_EQ(commands.statistics().acknowledged, 2u);
+}
+
+TEST(CommandChannelTest, UnansweredRequestsUnconfirmed)
+{
+    using namespace std::chrono_literals;
+    std::vector<std::vector<uint8_t>> written;
+    dev::IoStream ioStream{std::make_unique<RecordingStream>(written)};
+    dev::CommandChannel commands{ioStream, 10ms};
+
+    auto result = commands.send(raw(dev::Req2({0x11u, 9u})));
+    commands.expire();
+    ASSERT_EQ(result.wait_for(0s), std::future_status::timeout);
+    // frames keep coming, the effect is measured without a reply
+    commands.frameReceived();
+    ASSERT_EQ(result.wait_for(0s), std::future_status::timeout);
+    std::this_thread::sleep_for(20ms);
+    commands.frameReceived();
+    commands.expire();
+    const auto unconfirmed = result.get();
+    ASSERT_EQ(unconfirmed.status, dev::CommandChannel::Status::Unconfirmed);
+    ASSERT_GE(unconfirmed.latency, 10ms);
+    ASSERT_TRUE(unconfirmed.effectLatency);
+    ASSERT_LT(*unconfirmed.effectLatency, 10ms);
+    ASSERT_EQ(commands.statistics().unconfirmed, 1u);
+}
+
+TEST(CommandChannelTest, RequestsInFlightLimited)
+{
+    using namespace std::chrono_literals;
+    std::vector<std::vector<uint8_t>> written;
+    dev::IoStream ioStream{std::make_unique<RecordingStream>(written)};
+    std::vector<std::future<dev::CommandChannel::Result>> results;
+    {
+        dev::CommandChannel commands{ioStream, 1s};
+        for(auto i = 0u; i < dev::CommandChannel::MAX_IN_FLIGHT; ++i)
+        {
+            results.push_back(commands.send(raw(dev::Req2({0x11u, 0u}))));
+        }
+        ASSERT_THROW(commands.send(raw(dev::Req2({0x11u, 0u}))), std::runtime_error);
+        ASSERT_EQ(written.size(), dev::CommandChannel::MAX_IN_FLIGHT);
+    }
+    // requests still in flight are cancelled with the channel
+    for(auto& result : results)
+    {
+        ASSERT_EQ(result.get().status, dev::CommandChannel::Status::Cancelled);
+    }
+}
+
+TEST(CommandChannelTest, LidarMatchesRepliesInStream)
+{
+    using namespace std::chrono_literals;
+    using dev::CygLidarD1;
+    std::vector<std::vector<uint8_t>> written;
+    dev::IoStream ioStream{std::make_unique<RecordingStream>(written)};
+    CygLidarD1 lidar{ioStream};
+
+    auto results = lidar.reconfigure({CygLidarD1::BaudRate::B3M, 5u,
+                                      CygLidarD1::PulseDuration{CygLidarD1::PulseDuration::PulseMode::Fixed3D, 900u},
+                                      40u});
+    ASSERT_EQ(written.size(), 3u);
+
+    // replies come in between frames
+    auto payload = std::make_unique<CygLidarD1::Frame3D::Payload>();
+    (*payload)[0u] = static_cast<uint8_t>(CygLidarD1::Mode::Mode3D);
+    const auto frame = std::make_unique<CygLidarD1::Frame3D>(*payload);
+    std::vector<uint8_t> stream{frame->raw(), frame->raw() + frame->rawSize()};
+    for(const auto type : {0x0Cu, 0x0Fu, 0x11u})
+    {
+        const auto reply = raw(dev::Req2({static_cast<uint8_t>(type), 0u}));
+        stream.insert(stream.end(), reply.begin(), reply.end());
+        stream.insert(stream.end(), frame->raw(), frame->raw() + frame->rawSize());
+    }
+    lidar.feed(stream);
+
+    for(auto& result : results)
+    {
+        ASSERT_EQ(result.wait_for(0s), std::future_status::ready);
+        ASSERT_EQ(result.get().status, dev::CommandChannel::Status::Acknowledged);
+    }
+    ASSERT_EQ(lidar.demuxStatistics().frames3d, 4u);
+    ASSERT_EQ(lidar.demuxStatistics().framesIgnored, 0u);
+    ASSERT_EQ(lidar.commandStatistics().acknowledged, 3u);
+}
+
+} // namespace lidar_viewer::tests::units
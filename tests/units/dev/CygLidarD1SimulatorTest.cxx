@@ -0,0 +1,254 @@
+#include "lidar_viewer/dev/CygLidarD1Simulator.h"
+#include "lidar_viewer/dev/PointCloudReader.h"
+#include "lidar_viewer/dev/SerialPort.h"
+
+#include <gtest/gtest.h>
+
+#include <termios.h>
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <thread>
+
+namespace lidar_viewer::tests::units
+{
+
+namespace
+{
+
+/// host side of the simulated lidar
+struct Host
+{
+    std::unique_ptr<dev::IoStream> ioStream{};
+    std::unique_ptr<dev::CygLidarD1> lidar{};
+
+    explicit Host(const dev::CygLidarD1Simulator& simulator)
+    {
+        ioStream = std::make_unique<dev::IoStream>(std::make_unique<dev::SerialPort>(simulator.deviceName(), B3000000));
+        lidar = std::make_unique<dev::CygLidarD1>(*ioStream);
+    }
+};
+
+bool waitFor(const std::function<bool()>& condition, std::chrono::milliseconds timeout)
+{
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while(!condition())
+    {
+        if(std::chrono::steady_clock::now() > deadline)
+        {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+    return true;
+}
+
+} // namespace
+
+TEST(CygLidarD1SimulatorTest, DeviceInfoAnswered)
+{
+    using namespace std::chrono_literals;
+    dev::CygLidarD1Simulator simulator{};
+    simulator.start();
+    Host host{simulator};
+
+    dev::write(dev::Req2({0x10u, 0x00u}), *host.ioStream);
+    const auto response = dev::read<dev::Frame<7u>>(*host.ioStream);
+    ASSERT_TRUE(response.ok());
+    ASSERT_EQ(*response.value().payload(), dev::CygLidarD1Simulator::Config{}.deviceInfo);
+}
+
+TEST(CygLidarD1SimulatorTest, ConfigurationTaken)
+{
+    using namespace std::chrono_literals;
+    using dev::CygLidarD1;
+    dev::CygLidarD1Simulator simulator{};
+    simulator.start();
+    Host host{simulator};
+
+    const CygLidarD1::Config config{CygLidarD1::BaudRate::B3M, 7u,
+                                    CygLidarD1::PulseDuration{CygLidarD1::PulseDuration::PulseMode::Fixed3D, 1000u},
+                                    42u};
+    host.lidar->configure(config);
+    ASSERT_TRUE(waitFor([&simulator]() { return simulator.statistics().requests == 4u; }, 1s));
+
+    const auto settings = simulator.settings();
+    ASSERT_EQ(settings.baudRate, static_cast<uint8_t>(CygLidarD1::BaudRate::B3M));
+    ASSERT_EQ(settings.frequencyChannel, 7u);
+    ASSERT_EQ(settings.pulseDuration, config.pulseDuration.get());
+    ASSERT_EQ(settings.sensitivity, 42u);
+    ASSERT_FALSE(settings.mode.has_value());
+}
+
+TEST(CygLidarD1SimulatorTest, StartUpRepliesMatched)
+{
+    using namespace std::chrono_literals;
+    using dev::CygLidarD1;
+    dev::CygLidarD1Simulator simulator{{.frameRate = 50.0, .baudRate = 3000000u}};
+    simulator.start();
+    Host host{simulator};
+
+    auto results = host.lidar->configure({});
+    host.lidar->run(CygLidarD1::Mode::Mode3D);
+    dev::PointCloudReader<CygLidarD1> reader{*host.lidar};
+    reader.start(CygLidarD1::Mode::Mode3D);
+    ASSERT_EQ(results.size(), 4u);
+    for(auto& result : results)
+    {
+        ASSERT_EQ(result.wait_for(1s), std::future_status::ready);
+        ASSERT_EQ(result.get().status, dev::CommandChannel::Status::Acknowledged);
+    }
+    ASSERT_TRUE(waitFor([&host]() { return host.lidar->demuxStatistics().frames3d >= 3u; }, 2s));
+    reader.stop();
+
+    const auto statistics = host.lidar->commandStatistics();
+    ASSERT_EQ(statistics.acknowledged, 4u);
+    ASSERT_EQ(statistics.unmatchedReplies, 0u);
+    ASSERT_EQ(host.lidar->demuxStatistics().framesIgnored, 0u);
+}
+
+TEST(CygLidarD1SimulatorTest, StreamsBetweenRunAndStop)
+{
+    using namespace std::chrono_literals;
+    using dev::CygLidarD1;
+    dev::CygLidarD1Simulator simulator{{.frameRate = 100.0, .baudRate = 3000000u}};
+    simulator.start();
+    Host host{simulator};
+
+    host.lidar->run(CygLidarD1::Mode::Dual);
+    ASSERT_TRUE(waitFor([&host]()
+    {
+        host.lidar->readAndParse();
+        return host.lidar->parserStatistics().framesParsed >= 10u;
+    }, 2s));
+    host.lidar->stop();
+    ASSERT_TRUE(waitFor([&simulator]() { return !simulator.settings().mode.has_value(); }, 1s));
+
+    const auto statistics = simulator.statistics();
+    ASSERT_GT(statistics.frames2d, 0u);
+    ASSERT_GT(statistics.frames3d, 0u);
+    ASSERT_EQ(statistics.bytesDropped, 0u);
+    ASSERT_EQ(host.lidar->parserStatistics().checksumErrors, 0u);
+    host.lidar->use2dPointCloud([](const auto& pointCloud)
+    {
+        ASSERT_EQ(pointCloud[0u], 2000u);
+        ASSERT_EQ(pointCloud[1u], 2008u);
+    });
+    host.lidar->use3dPointCloud([](const auto& pointCloud)
+    {
+        ASSERT_EQ(pointCloud[159u], 2000u + 159u * 8u);
+    });
+}
+
+TEST(CygLidarD1SimulatorTest, PointCloudReaderEndToEnd)
+{
+    using namespace std::chrono_literals;
+    using dev::CygLidarD1;
+    constexpr auto frameRate = 20.0;
+    dev::CygLidarD1Simulator simulator{{.frameRate = frameRate, .baudRate = 3000000u}};
+    simulator.start();
+    Host host{simulator};
+
+    host.lidar->run(CygLidarD1::Mode::Mode3D);
+    dev::PointCloudReader<CygLidarD1> reader{*host.lidar};
+    reader.start(CygLidarD1::Mode::Mode3D);
+    std::this_thread::sleep_for(500ms);
+    reader.stop();
+
+    const auto sent = simulator.statistics().frames3d;
+    const auto parsed = host.lidar->parserStatistics().framesParsed;
+    ASSERT_GE(sent, static_cast<uint64_t>(frameRate * 0.5 * 0.6));
+    // a frame may still be on the line when reader stops
+    ASSERT_GE(parsed + 1u, sent);
+    ASSERT_EQ(host.lidar->parserStatistics().bytesSkipped, 0u);
+}
+
+TEST(CygLidarD1SimulatorTest, ReconfiguredWhileStreaming)
+{
+    using namespace std::chrono_literals;
+    using dev::CygLidarD1;
+    dev::CygLidarD1Simulator simulator{{.frameRate = 50.0, .baudRate = 3000000u}};
+    simulator.start();
+    Host host{simulator};
+
+    host.lidar->run(CygLidarD1::Mode::Mode3D);
+    dev::PointCloudReader<CygLidarD1> reader{*host.lidar};
+    reader.start(CygLidarD1::Mode::Mode3D);
+    ASSERT_TRUE(waitFor([&host]() { return host.lidar->demuxStatistics().frames3d >= 3u; }, 2s));
+
+    auto results = host.lidar->reconfigure({CygLidarD1::BaudRate::B3M, 9u,
+                                            CygLidarD1::PulseDuration{CygLidarD1::PulseDuration::PulseMode::Fixed3D,
+                                                                      700u},
+                                            33u});
+    for(auto& result : results)
+    {
+        ASSERT_EQ(result.wait_for(1s), std::future_status::ready);
+        const auto acknowledged = result.get();
+        ASSERT_EQ(acknowledged.status, dev::CommandChannel::Status::Acknowledged);
+        ASSERT_LT(acknowledged.latency, CygLidarD1::COMMAND_TIMEOUT);
+        // streaming, a frame follows every request
+        ASSERT_TRUE(acknowledged.effectLatency);
+    }
+    // acquisition goes on
+    const auto framesBefore = host.lidar->demuxStatistics().frames3d;
+    ASSERT_TRUE(waitFor([&]() { return host.lidar->demuxStatistics().frames3d >= framesBefore + 3u; }, 2s));
+    reader.stop();
+
+    const auto settings = simulator.settings();
+    ASSERT_EQ(settings.frequencyChannel, 9u);
+    ASSERT_EQ(settings.sensitivity, 33u);
+    ASSERT_EQ(settings.mode, CygLidarD1::Mode::Mode3D);
+    ASSERT_EQ(host.lidar->commandStatistics().acknowledged, 3u);
+    ASSERT_EQ(host.lidar->demuxStatistics().framesIgnored, 0u);
+}
+
+TEST(CygLidarD1SimulatorTest, OverloadDropsBytes)
+{
+    using namespace std::chrono_literals;
+    using dev::CygLidarD1;
+    dev::CygLidarD1Simulator simulator{{.frameRate = 1000.0, .baudRate = 0u}};
+    simulator.start();
+    Host host{simulator};
+
+    // host does not read, the line overflows
+    host.lidar->run(CygLidarD1::Mode::Mode3D);
+    ASSERT_TRUE(waitFor([&simulator]() { return simulator.statistics().bytesDropped > 0u; }, 2s));
+
+    // whatever reached the host is resynchronized on
+    for(auto i = 0u; i < 10u; ++i)
+    {
+        host.lidar->readAndParse();
+    }
+    ASSERT_GT(host.lidar->parserStatistics().framesParsed, 0u);
+}
+
+TEST(CygLidarD1SimulatorTest, DualModeDemultiplexed)
+{
+    using namespace std::chrono_literals;
+    using dev::CygLidarD1;
+    constexpr auto frameRate = 20.0;
+    dev::CygLidarD1Simulator simulator{{.frameRate = frameRate, .baudRate = 3000000u}};
+    simulator.start();
+    Host host{simulator};
+
+    host.lidar->run(CygLidarD1::Mode::Dual);
+    dev::PointCloudReader<CygLidarD1> reader{*host.lidar};
+    reader.start(CygLidarD1::Mode::Dual);
+    // both point clouds are published from the one stream
+    ASSERT_TRUE(host.lidar->waitFor3dPointCloud(0u, 2s));
+    ASSERT_TRUE(host.lidar->waitFor2dPointCloud(0u, 2s));
+    std::this_thread::sleep_for(300ms);
+    reader.stop();
+
+    const auto statistics = host.lidar->demuxStatistics();
+    const auto simulated = simulator.statistics();
+    ASSERT_GE(statistics.frames3d + 1u, simulated.frames3d);
+    ASSERT_GE(statistics.frames2d + 1u, simulated.frames2d);
+    ASSERT_EQ(statistics.framesIgnored, 0u);
+    ASSERT_EQ(host.lidar->latest3dPointCloud()->stamp.sequence, statistics.frames3d);
+    ASSERT_EQ(host.lidar->latest2dPointCloud()->stamp.sequence, statistics.frames2d);
+    ASSERT_EQ(host.lidar->parserStatistics().bytesSkipped, 0u);
+}
+
+} // namespace lidar_viewer::tests::units
@@ -6,6 +6,9 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <future>
+#include <thread>
+
 namespace lidar_viewer::tests::units
 {
 
@@ -264,4 +267,248 @@ TEST(CygLidarD1Test, CygLidarD1PrintDeviceInfo)
     ASSERT_EQ(output, "Device info: 16.0.3.5.0.2.2.\n");
 }
 
+TEST(CygLidarD1Test, CygLidarD1StreamParsingResynchronizes)
+{
+    using namespace lidar_viewer::dev;
+    using testing::_;
+    using testing::Invoke;
+
+    CygLidarD1::Frame3D::Payload payload{};
+    payload[0u] = 0x08u;
+    // first depth 0x123, second 0x456
+    payload[1u] = 0x23u;
+    payload[2u] = 0x61u;
+    payload[3u] = 0x45u;
+    const auto frame3d = std::make_unique<CygLidarD1::Frame3D>(payload);
+
+    std::vector<uint8_t> stream{0x5au, 0x77u, 0xffu, 0x10u};
+    stream.insert(stream.end(), frame3d->raw(), frame3d->raw() + frame3d->rawSize());
+    const auto half = stream.size() / 2u;
+    std::vector<std::vector<uint8_t>> chunks{{stream.begin(), stream.begin() + static_cast<std::ptrdiff_t>(half)},
+                                             {stream.begin() + static_cast<std::ptrdiff_t>(half), stream.end()}};
+
+    auto call = 0u;
+    auto dummyStream = std::make_unique<IoStreamMock>();
+    EXPECT_CALL(*dummyStream, write(_, _, _));
+    EXPECT_CALL(*dummyStream, close());
+    EXPECT_CALL(*dummyStream, read(_, _, _)).Times(2)
+            .WillRepeatedly(Invoke([&chunks, &call] (void* ptr, unsigned int size, std::chrono::milliseconds )
+            {
+                const auto& chunk = chunks[call++];
+                EXPECT_GE(size, chunk.size());
+                std::copy(chunk.begin(), chunk.end(), reinterpret_cast<uint8_t*>(ptr));
+                return static_cast<unsigned int>(chunk.size());
+            }));
+
+    IoStream ioStream{std::move(dummyStream)};
+    CygLidarD1 lidar{ioStream};
+    lidar.readAndParse();
+    ASSERT_EQ(lidar.parserStatistics().framesParsed, 0u);
+    lidar.readAndParse();
+
+    const auto statistics = lidar.parserStatistics();
+    ASSERT_EQ(statistics.framesParsed, 1u);
+    ASSERT_EQ(statistics.framesRecovered, 1u);
+    ASSERT_GE(statistics.bytesSkipped, 4u);
+    lidar.use3dPointCloud([](const CygLidarD1::PointCloud3D& pointCloud)
+    {
+        ASSERT_EQ(pointCloud[0u], 0x123u);
+        ASSERT_EQ(pointCloud[1u], 0x456u);
+    });
+}
+
+TEST(CygLidarD1Test, CygLidarD1FramesStampedAndAwaited)
+{
+    using namespace lidar_viewer::dev;
+    using namespace std::chrono_literals;
+    auto dummyStream = std::make_unique<testing::NiceMock<IoStreamMock>>();
+    IoStream ioStream{std::move(dummyStream)};
+    CygLidarD1 lidar{ioStream};
+
+    CygLidarD1::Frame3D::Payload payload{};
+    payload[0u] = 0x08u;
+    const auto frame3d = std::make_unique<CygLidarD1::Frame3D>(payload);
+    const std::vector<uint8_t> raw{frame3d->raw(), frame3d->raw() + frame3d->rawSize()};
+
+    ASSERT_EQ(lidar.latest3dFrame()->stamp.sequence, 0u);
+    ASSERT_FALSE(lidar.waitFor3dFrame(0u, 0ms));
+    ASSERT_FALSE(lidar.waitFor3dPointCloud(0u, 10ms));
+
+    auto waiter = std::async(std::launch::async, [&lidar]()
+    {
+        return lidar.waitFor3dPointCloud(0u, 5s);
+    });
+    std::this_thread::sleep_for(10ms);
+    const auto before = std::chrono::steady_clock::now();
+    lidar.feed(raw);
+    const auto after = std::chrono::steady_clock::now();
+    const auto pointCloud = waiter.get();
+    ASSERT_TRUE(pointCloud);
+    ASSERT_EQ(pointCloud->stamp.sequence, 1u);
+    ASSERT_GE(pointCloud->stamp.captureTime, before);
+    ASSERT_LE(pointCloud->stamp.captureTime, after);
+    ASSERT_EQ(lidar.latest3dFrame()->stamp.sequence, 1u);
+    ASSERT_EQ(lidar.latest3dFrame()->stamp.captureTime, pointCloud->stamp.captureTime);
+
+    // frames superseded before being fetched are skipped, the latest one is returned
+    lidar.feed(raw);
+    lidar.feed(raw);
+    const auto latest = lidar.waitFor3dFrame(1u, 0ms);
+    ASSERT_TRUE(latest);
+    ASSERT_EQ(latest->stamp.sequence, 3u);
+    ASSERT_FALSE(lidar.waitFor3dFrame(3u, 0ms));
+    // 2D frames are counted on their own
+    ASSERT_EQ(lidar.latest2dPointCloud()->stamp.sequence, 0u);
+}
+
+TEST(CygLidarD1Test, CygLidarD1DualStreamDemultiplexed)
+{
+    using namespace lidar_viewer::dev;
+    IoStream ioStream{std::make_unique<testing::NiceMock<IoStreamMock>>()};
+    CygLidarD1 lidar{ioStream};
+
+    std::vector<uint8_t> stream;
+    const auto append = [&stream](const auto& frame)
+    {
+        stream.insert(stream.end(), frame.raw(), frame.raw() + frame.rawSize());
+    };
+    const auto make3d = [](uint8_t depth)
+    {
+        CygLidarD1::Frame3D::Payload payload{};
+        payload[0u] = 0x08u;
+        payload[1u] = depth;
+        return std::make_unique<CygLidarD1::Frame3D>(payload);
+    };
+    const auto make2d = [](uint8_t depth)
+    {
+        CygLidarD1::Frame2D::Payload payload{};
+        payload[0u] = 0x01u;
+        payload[1u] = depth;
+        return CygLidarD1::Frame2D{payload};
+    };
+    append(*make3d(1u));
+    append(make2d(10u));
+    append(make2d(11u));
+    // response to a request, neither 2D nor 3D
+    append(Frame<7u>{Frame<7u>::Payload{0x10u}});
+    append(make2d(12u));
+    append(*make3d(2u));
+    lidar.feed(stream);
+
+    const auto statistics = lidar.demuxStatistics();
+    ASSERT_EQ(statistics.frames3d, 2u);
+    ASSERT_EQ(statistics.frames2d, 3u);
+    ASSERT_EQ(statistics.framesIgnored, 1u);
+    ASSERT_EQ((*lidar.latest3dPointCloud())[0u], 2u);
+    ASSERT_EQ(lidar.latest3dPointCloud()->stamp.sequence, 2u);
+    ASSERT_EQ((*lidar.latest2dPointCloud())[0u], 12u);
+    ASSERT_EQ(lidar.latest2dPointCloud()->stamp.sequence, 3u);
+}
+
+TEST(CygLidarD1Test, CygLidarD1ReadDropsCorruptedFrames)
+{
+    using namespace lidar_viewer::dev;
+    using testing::_;
+    using testing::Invoke;
+
+    std::vector<uint8_t> stream;
+    const auto append = [&stream](uint8_t depth)
+    {
+        CygLidarD1::Frame3D::Payload payload{};
+        payload[0u] = 0x08u;
+        payload[1u] = depth;
+        const auto frame = std::make_unique<CygLidarD1::Frame3D>(payload);
+        stream.insert(stream.end(), frame->raw(), frame->raw() + frame->rawSize());
+        return stream.size() - frame->rawSize();
+    };
+    append(1u);
+    // payload byte corrupted on the line
+    stream[append(2u) + 100u] ^= 0x04u;
+    // length field of a 2D frame, size of a 3D one
+    const auto wrongLength = append(3u);
+    stream[wrongLength + 3u] = static_cast<uint8_t>(CygLidarD1::FRAME_SIZE_2D);
+    stream[wrongLength + 4u] = static_cast<uint8_t>(CygLidarD1::FRAME_SIZE_2D >> 8u);
+    append(4u);
+
+    std::size_t position{0u};
+    auto dummyStream = std::make_unique<testing::NiceMock<IoStreamMock>>();
+    ON_CALL(*dummyStream, read(_, _, _))
+            .WillByDefault(Invoke([&stream, &position](void* ptr, unsigned int size, std::chrono::milliseconds)
+            {
+                const auto readBytes = std::min<std::size_t>(size, stream.size() - position);
+                std::copy_n(stream.begin() + static_cast<std::ptrdiff_t>(position), readBytes, reinterpret_cast<uint8_t*>(ptr));
+                position += readBytes;
+                return static_cast<unsigned int>(readBytes);
+            }));
+    IoStream ioStream{std::move(dummyStream)};
+    CygLidarD1 lidar{ioStream};
+
+    const std::vector<std::pair<uint16_t, uint64_t>> expected{{1u, 1u}, {1u, 1u}, {1u, 1u}, {4u, 2u}};
+    for(const auto& [depth, sequence] : expected)
+    {
+        testing::internal::CaptureStderr();
+        lidar.readAndParse3dFrame();
+        testing::internal::GetCapturedStderr();
+        ASSERT_EQ((*lidar.latest3dPointCloud())[0u], depth);
+        ASSERT_EQ(lidar.latest3dPointCloud()->stamp.sequence, sequence);
+    }
+    ASSERT_EQ(position, stream.size());
+    const auto statistics = lidar.readStatistics();
+    ASSERT_EQ(statistics.checksumErrors, 1u);
+    ASSERT_EQ(statistics.lengthErrors, 1u);
+}
+
+TEST(CygLidarD1Test, CygLidarD1ReadDiscardsFramesWhileBuffersHeld)
+{
+    using namespace lidar_viewer::dev;
+    using testing::_;
+    using testing::Invoke;
+
+    std::vector<uint8_t> stream;
+    const auto append = [&stream](uint8_t depth)
+    {
+        CygLidarD1::Frame3D::Payload payload{};
+        payload[0u] = 0x08u;
+        payload[1u] = depth;
+        const auto frame = std::make_unique<CygLidarD1::Frame3D>(payload);
+        stream.insert(stream.end(), frame->raw(), frame->raw() + frame->rawSize());
+    };
+    constexpr auto frames = 2u * CygLidarD1::FRAME_POOL_SIZE;
+    for(auto depth = 1u; depth <= frames; ++depth)
+    {
+        append(static_cast<uint8_t>(depth));
+    }
+
+    std::size_t position{0u};
+    auto dummyStream = std::make_unique<testing::NiceMock<IoStreamMock>>();
+    ON_CALL(*dummyStream, read(_, _, _))
+            .WillByDefault(Invoke([&stream, &position](void* ptr, unsigned int size, std::chrono::milliseconds)
+            {
+                const auto readBytes = std::min<std::size_t>(size, stream.size() - position);
+                std::copy_n(stream.begin() + static_cast<std::ptrdiff_t>(position), readBytes, reinterpret_cast<uint8_t*>(ptr));
+                position += readBytes;
+                return static_cast<unsigned int>(readBytes);
+            }));
+    IoStream ioStream{std::move(dummyStream)};
+    CygLidarD1 lidar{ioStream};
+
+    // consumers hold every point cloud, frames read meanwhile are dropped but not left in the stream
+    std::vector<CygLidarD1::PointCloud3DHandle> held;
+    for(auto i = 0u; i < frames; ++i)
+    {
+        lidar.readAndParse3dFrame();
+        held.push_back(lidar.latest3dPointCloud());
+        ASSERT_EQ(position, (i + 1u) * stream.size() / frames);
+    }
+    ASSERT_GT(lidar.framesDropped(), 0u);
+    ASSERT_LT(lidar.framesDropped(), frames);
+
+    // sequence numbers of dropped frames are skipped
+    held.clear();
+    append(static_cast<uint8_t>(frames + 1u));
+    lidar.readAndParse3dFrame();
+    ASSERT_EQ((*lidar.latest3dPointCloud())[0u], frames + 1u);
+    ASSERT_EQ(lidar.latest3dPointCloud()->stamp.sequence, frames + 1u);
+}
+
 } // namespace lidar_viewer::tests::units
@@ -8,7 +8,7 @@
 namespace lidar_viewer::tests::units
 {
 
-static constexpr std::array<uint8_t, 4u + 6u> expected{0x5au, 0x77u, 0xffu, 0x04u, 0x00u, 0x02, 0x01, 0x03, 0x07, 0x04};
+static constexpr std::array<uint8_t, 4u + 6u> expected{0x5au, 0x77u, 0xffu, 0x04u, 0x00u, 0x02, 0x01, 0x03, 0x07, 0x03};
 
 using namespace std::string_literals;
 
@@ -0,0 +1,166 @@
+#include "lidar_viewer/dev/DepthCodec.h"
+#include "lidar_viewer/dev/DepthPacking.h"
+#include "lidar_viewer/dev/CygLidarD1.h"
+
+#include <gtest/gtest.h>
+
+#include <numeric>
+#include <random>
+
+namespace lidar_viewer::tests::units
+{
+
+namespace
+{
+
+dev::CygLidarD1::PointCloud3D makeScene(unsigned int seed)
+{
+    dev::CygLidarD1::PointCloud3D depths{};
+    std::mt19937 generator{seed};
+    std::uniform_int_distribution<uint16_t> noise{0u, 3u};
+    const auto [width, height] = dev::CygLidarD1::get3dFrameWindow();
+    for(auto row = 0u; row < height; ++row)
+    {
+        for(auto column = 0u; column < width; ++column)
+        {
+            // slanted floor, an object in the middle and some invalid pixels
+            auto& depth = depths[row * width + column];
+            depth = static_cast<uint16_t>(500u + row * 40u + noise(generator));
+            if(column > 60u && column < 100u && row > 20u && row < 40u)
+            {
+                depth = static_cast<uint16_t>(800u + noise(generator));
+            }
+            if(column % 37u == 0u)
+            {
+                depth = static_cast<uint16_t>(dev::CygLidarD1::ErrorCodes3D::LowAmplitude);
+            }
+        }
+    }
+    return depths;
+}
+
+} // namespace
+
+TEST(DepthCodecTest, PackingRoundTrip)
+{
+    std::array<uint8_t, 6u> packed{0x01u, 0x23u, 0x45u, 0xffu, 0x0fu, 0xf0u};
+    std::array<uint16_t, 4u> depths{};
+    dev::unpack12(packed, depths);
+    ASSERT_EQ(depths[0u], 0x301u);
+    ASSERT_EQ(depths[1u], 0x452u);
+    ASSERT_EQ(depths[2u], 0xfffu);
+    ASSERT_EQ(depths[3u], 0xf00u);
+
+    std::array<uint8_t, 6u> repacked{};
+    dev::pack12(depths, repacked);
+    ASSERT_EQ(repacked, packed);
+}
+
+TEST(DepthCodecTest, CodecsAreLossless)
+{
+    using namespace dev::codec;
+    for(const auto id : {CodecId::Raw, CodecId::Rvl, CodecId::TemporalRvl})
+    {
+        auto encoder = makeDepthCodec(id);
+        auto decoder = makeDepthCodec(id);
+        ASSERT_EQ(encoder->id(), id);
+        for(auto seed = 0u; seed < 5u; ++seed)
+        {
+            const auto depths = makeScene(seed);
+            std::vector<uint8_t> encoded;
+            encoder->encode(depths, encoded);
+
+            dev::CygLidarD1::PointCloud3D decoded{};
+            ASSERT_EQ(decoder->decode(encoded, decoded), encoded.size());
+            ASSERT_EQ(decoded, depths);
+        }
+    }
+}
+
+TEST(DepthCodecTest, ExtremeValuesAreLossless)
+{
+    using namespace dev::codec;
+    dev::CygLidarD1::PointCloud3D depths{};
+    for(auto i = 0u; i < depths.size(); ++i)
+    {
+        depths[i] = (i % 2u == 0u) ? 0xfffu : 0u;
+    }
+    for(const auto id : {CodecId::Rvl, CodecId::TemporalRvl})
+    {
+        auto codec = makeDepthCodec(id);
+        std::vector<uint8_t> encoded;
+        codec->encode(depths, encoded);
+        codec->reset();
+        dev::CygLidarD1::PointCloud3D decoded{};
+        codec->decode(encoded, decoded);
+        ASSERT_EQ(decoded, depths);
+    }
+}
+
+TEST(DepthCodecTest, StaticSceneCompresses)
+{
+    using namespace dev::codec;
+    const auto depths = makeScene(0u);
+    const auto rawSize = depths.size() * 3u / 2u;
+
+    RvlCodec rvl{};
+    std::vector<uint8_t> encoded;
+    rvl.encode(depths, encoded);
+    ASSERT_LT(encoded.size(), rawSize);
+
+    TemporalRvlCodec temporal{};
+    std::vector<uint8_t> keyframe;
+    temporal.encode(depths, keyframe);
+    std::vector<uint8_t> delta;
+    temporal.encode(depths, delta);
+    ASSERT_TRUE(temporal.keyframe(keyframe));
+    ASSERT_FALSE(temporal.keyframe(delta));
+    // unchanged frame is a single zero run
+    ASSERT_LT(delta.size(), 16u);
+}
+
+TEST(DepthCodecTest, TemporalKeyframesArePeriodic)
+{
+    using namespace dev::codec;
+    TemporalRvlCodec codec{4u};
+    std::vector<bool> keyframes;
+    for(auto seed = 0u; seed < 9u; ++seed)
+    {
+        std::vector<uint8_t> encoded;
+        codec.encode(makeScene(seed), encoded);
+        keyframes.push_back(codec.keyframe(encoded));
+    }
+    ASSERT_EQ(keyframes, (std::vector<bool>{true, false, false, false, true, false, false, false, true}));
+}
+
+TEST(DepthCodecTest, DeltaWithoutKeyframeThrows)
+{
+    using namespace dev::codec;
+    TemporalRvlCodec encoder{};
+    std::vector<uint8_t> keyframe;
+    std::vector<uint8_t> delta;
+    encoder.encode(makeScene(0u), keyframe);
+    encoder.encode(makeScene(1u), delta);
+
+    TemporalRvlCodec decoder{};
+    dev::CygLidarD1::PointCloud3D decoded{};
+    ASSERT_THROW(decoder.decode(delta, decoded), std::runtime_error);
+    decoder.decode(keyframe, decoded);
+    decoder.decode(delta, decoded);
+    ASSERT_EQ(decoded, makeScene(1u));
+}
+
+TEST(DepthCodecTest, TruncatedDataThrows)
+{
+    using namespace dev::codec;
+    RvlCodec codec{};
+    std::vector<uint8_t> encoded;
+    codec.encode(makeScene(0u), encoded);
+    encoded.resize(encoded.size() / 2u);
+    dev::CygLidarD1::PointCloud3D decoded{};
+    ASSERT_THROW(codec.decode(encoded, decoded), std::runtime_error);
+    ASSERT_THROW(codecIdFromName("zip"), std::runtime_error);
+    ASSERT_EQ(codecIdFromName("delta"), CodecId::TemporalRvl);
+}
+
+} // namespace lidar_viewer::tests::units
@@ -0,0 +1,125 @@
+#include "lidar_viewer/dev/DepthUnpacking.h"
+#include "lidar_viewer/dev/DepthPacking.h"
+#include "lidar_viewer/dev/CygLidarD1.h"
+
+#include <gtest/gtest.h>
+
+#include <numeric>
+#include <string>
+#include <vector>
+
+namespace lidar_viewer::tests::units
+{
+
+namespace
+{
+
+constexpr std::array<dev::UnpackKernel, 3u> kernels{dev::UnpackKernel::Scalar, dev::UnpackKernel::Ssse3,
+                                                    dev::UnpackKernel::Avx2};
+
+std::string kernelName(dev::UnpackKernel kernel)
+{
+    return kernel == dev::UnpackKernel::Avx2 ? "AVX2" : kernel == dev::UnpackKernel::Ssse3 ? "SSSE3" : "scalar";
+}
+
+std::vector<uint16_t> reference2d(std::span<const uint8_t> packed, std::size_t count)
+{
+    std::vector<uint16_t> depths(count);
+    for(auto i = 0u; i < count; ++i)
+    {
+        depths[i] = static_cast<uint16_t>(packed[2u * i] | ((packed[2u * i + 1u] & 0xfu) << 8u));
+    }
+    return depths;
+}
+
+} // namespace
+
+TEST(DepthUnpackingTest, ScalarAlwaysSupported)
+{
+    ASSERT_TRUE(dev::unpackKernelSupported(dev::UnpackKernel::Scalar));
+    ASSERT_TRUE(dev::unpackKernelSupported(dev::bestUnpackKernel()));
+}
+
+TEST(DepthUnpackingTest, EveryTripleMatchesScalar3d)
+{
+    // all 2^24 byte triples, in chunks
+    constexpr auto triplesPerChunk = 1u << 14u;
+    std::vector<uint8_t> packed(triplesPerChunk * 3u);
+    std::vector<uint16_t> expected(triplesPerChunk * 2u);
+    std::vector<uint16_t> depths(triplesPerChunk * 2u);
+    for(uint32_t first = 0u; first < (1u << 24u); first += triplesPerChunk)
+    {
+        for(auto i = 0u; i < triplesPerChunk; ++i)
+        {
+            const auto triple = first + i;
+            packed[3u * i] = static_cast<uint8_t>(triple);
+            packed[3u * i + 1u] = static_cast<uint8_t>(triple >> 8u);
+            packed[3u * i + 2u] = static_cast<uint8_t>(triple >> 16u);
+        }
+        dev::unpack12(packed, expected);
+        for(const auto kernel : kernels)
+        {
+            if(!dev::unpackKernelSupported(kernel))
+            {
+                continue;
+            }
+            dev::unpack3dDepths(packed, depths, kernel);
+            ASSERT_EQ(depths, expected) << kernelName(kernel) << " at triple " << first;
+        }
+    }
+}
+
+TEST(DepthUnpackingTest, EveryPairMatchesScalar2d)
+{
+    std::vector<uint8_t> packed(2u << 16u);
+    for(uint32_t pair = 0u; pair < (1u << 16u); ++pair)
+    {
+        packed[2u * pair] = static_cast<uint8_t>(pair);
+        packed[2u * pair + 1u] = static_cast<uint8_t>(pair >> 8u);
+    }
+    const auto expected = reference2d(packed, 1u << 16u);
+    for(const auto kernel : kernels)
+    {
+        if(!dev::unpackKernelSupported(kernel))
+        {
+            continue;
+        }
+        std::vector<uint16_t> depths(1u << 16u);
+        dev::unpack2dDepths(packed, depths, kernel);
+        ASSERT_EQ(depths, expected) << kernelName(kernel);
+    }
+}
+
+TEST(DepthUnpackingTest, TailsAndShortSpans)
+{
+    std::vector<uint8_t> packed(100u);
+    std::iota(packed.begin(), packed.end(), 7u);
+    for(const auto kernel : kernels)
+    {
+        if(!dev::unpackKernelSupported(kernel))
+        {
+            continue;
+        }
+        for(auto packedSize = 0u; packedSize <= packed.size(); ++packedSize)
+        {
+            for(const auto depthCount : {packedSize / 3u * 2u, packedSize / 3u * 2u + 1u, packedSize / 2u})
+            {
+                const auto input = std::span{packed}.first(packedSize);
+                // guard value marks depths that must not be written
+                std::vector<uint16_t> expected(depthCount + 1u, 0xffffu);
+                std::vector<uint16_t> depths(depthCount + 1u, 0xffffu);
+                dev::unpack12(input, std::span{expected}.first(depthCount));
+                dev::unpack3dDepths(input, std::span{depths}.first(depthCount), kernel);
+                ASSERT_EQ(depths, expected) << kernelName(kernel) << " 3D, " << packedSize << " bytes";
+
+                std::fill(depths.begin(), depths.end(), 0xffffu);
+                expected = reference2d(input, std::min<std::size_t>(packedSize / 2u, depthCount));
+                expected.resize(depthCount + 1u, 0xffffu);
+                dev::unpack2dDepths(input, std::span{depths}.first(depthCount), kernel);
+                ASSERT_EQ(depths, expected) << kernelName(kernel) << " 2D, " << packedSize << " bytes";
+            }
+        }
+    }
+}
+
+} // namespace lidar_viewer::tests::units
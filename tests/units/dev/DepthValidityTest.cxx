@@ -0,0 +1,166 @@
+#include "lidar_viewer/dev/DepthValidity.h"
+#include "lidar_viewer/dev/DepthUnpacking.h"
+#include "lidar_viewer/dev/CygLidarD1.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <random>
+#include <vector>
+
+namespace lidar_viewer::tests::units
+{
+
+namespace
+{
+
+using ErrorCodes3D = dev::CygLidarD1::ErrorCodes3D;
+using ErrorCodes2D = dev::CygLidarD1::ErrorCodes2D;
+
+/// depths of every kind, error codes included
+std::vector<uint16_t> randomDepths(std::size_t count, unsigned int seed)
+{
+    std::mt19937 generator{seed};
+    std::uniform_int_distribution<unsigned int> distribution{0u, 4095u};
+    std::vector<uint16_t> depths(count);
+    for(auto& depth : depths)
+    {
+        const auto value = distribution(generator);
+        depth = value % 7u == 0u ? static_cast<uint16_t>(4081u + value % 3u) : static_cast<uint16_t>(value);
+    }
+    return depths;
+}
+
+} // namespace
+
+TEST(DepthValidityTest, MatchesPerDepthClassification)
+{
+    constexpr uint16_t minDepth = 51u;
+    constexpr uint16_t maxDepth = 3000u;
+    const auto all = randomDepths(9600u, 3u);
+    // whole frame and tails of every length
+    for(const auto count : {0u, 1u, 31u, 32u, 63u, 64u, 65u, 100u, 127u, 128u, 200u, 9600u})
+    {
+        const auto depths = std::span{all}.first(count);
+        std::vector<uint64_t> mask((count + 63u) / 64u, ~uint64_t{0u});
+        const auto counts = dev::classify3dDepths(depths, minDepth, maxDepth, mask);
+
+        dev::Depth3DCounts expected{};
+        for(auto i = 0u; i < count; ++i)
+        {
+            const auto depth = depths[i];
+            const auto valid = depth >= minDepth && depth <= maxDepth;
+            ASSERT_EQ(((mask[i / 64u] >> (i % 64u)) & 1u) != 0u, valid) << "depth " << i << " of " << count;
+            expected.valid += valid;
+            expected.lowAmplitude += depth == static_cast<uint16_t>(ErrorCodes3D::LowAmplitude);
+            expected.adcOverflow += depth == static_cast<uint16_t>(ErrorCodes3D::AdcOverflow);
+            expected.saturation += depth == static_cast<uint16_t>(ErrorCodes3D::Saturation);
+        }
+        expected.outOfRange = count - expected.valid - expected.lowAmplitude - expected.adcOverflow - expected.saturation;
+        // bits past the last depth stay clear
+        if(count % 64u != 0u)
+        {
+            ASSERT_EQ(mask.back() >> (count % 64u), 0u);
+        }
+        ASSERT_EQ(counts.valid, expected.valid) << count;
+        ASSERT_EQ(counts.outOfRange, expected.outOfRange) << count;
+        ASSERT_EQ(counts.lowAmplitude, expected.lowAmplitude) << count;
+        ASSERT_EQ(counts.adcOverflow, expected.adcOverflow) << count;
+        ASSERT_EQ(counts.saturation, expected.saturation) << count;
+    }
+}
+
+TEST(DepthValidityTest, ErrorCodesNeverValid)
+{
+    std::vector<uint16_t> depths{4080u, 4081u, 4082u, 4083u, 4095u};
+    std::vector<uint64_t> mask(1u);
+    const auto counts = dev::classify3dDepths(depths, 0u, 0xffffu, mask);
+    ASSERT_EQ(mask[0u], 0b00001u);
+    ASSERT_EQ(counts.valid, 1u);
+    ASSERT_EQ(counts.lowAmplitude, 1u);
+    ASSERT_EQ(counts.adcOverflow, 1u);
+    ASSERT_EQ(counts.saturation, 1u);
+    ASSERT_EQ(counts.outOfRange, 1u);
+}
+
+TEST(DepthValidityTest, LidarClassifiesParsedFrames)
+{
+    using dev::CygLidarD1;
+    struct NullStream
+            : dev::IoStreamBase
+    {
+        void open() override {}
+        unsigned int read(void*, unsigned int, const std::chrono::milliseconds) const override { return 0u; }
+        void write(const void*, unsigned int, bool) const override {}
+        void close() const override {}
+    };
+    dev::IoStream ioStream{std::make_unique<NullStream>()};
+    CygLidarD1 lidar{ioStream};
+
+    // first pair 100 and LowAmplitude, second pair Saturation and 0
+    auto payload = std::make_unique<CygLidarD1::Frame3D::Payload>();
+    (*payload)[0u] = 0x08u;
+    (*payload)[1u] = 100u;
+    (*payload)[2u] = 0x10u;
+    (*payload)[3u] = 0xffu;
+    (*payload)[4u] = 0xf3u;
+    (*payload)[5u] = 0x0fu;
+    const auto frame = std::make_unique<CygLidarD1::Frame3D>(*payload);
+    lidar.feed({frame->raw(), frame->rawSize()});
+
+    const auto pointCloud = lidar.latest3dPointCloud();
+    ASSERT_EQ((*pointCloud)[0u], 100u);
+    ASSERT_EQ((*pointCloud)[1u], static_cast<uint16_t>(ErrorCodes3D::LowAmplitude));
+    ASSERT_EQ((*pointCloud)[2u], static_cast<uint16_t>(ErrorCodes3D::Saturation));
+    const auto& validity = pointCloud->validity;
+    ASSERT_TRUE(validity.valid(0u));
+    ASSERT_FALSE(validity.valid(1u));
+    ASSERT_FALSE(validity.valid(2u));
+    ASSERT_FALSE(validity.valid(3u));
+    ASSERT_EQ(validity.counts.valid, 1u);
+    ASSERT_EQ(validity.counts.lowAmplitude, 1u);
+    ASSERT_EQ(validity.counts.saturation, 1u);
+    ASSERT_EQ(validity.counts.outOfRange, 160u * 60u - 3u);
+}
+
+TEST(DepthValidityTest, ErrorCodes2dRestored)
+{
+    // 16001 and 16004 would be 3713 and 3716 once masked, 16005 is no error code
+    const std::vector<uint8_t> packed{0x81u, 0x3eu, 100u, 0x00u, 0x84u, 0x3eu, 0x85u, 0x3eu};
+    std::vector<uint16_t> depths(4u);
+    dev::unpack2dDepths(packed, depths);
+    ASSERT_EQ(dev::restore2dErrorCodes(packed, depths), 2u);
+    ASSERT_EQ(depths, (std::vector<uint16_t>{static_cast<uint16_t>(ErrorCodes2D::LowAmplitude), 100u,
+                                             static_cast<uint16_t>(ErrorCodes2D::BadPixel), 0xe85u}));
+}
+
+TEST(DepthValidityTest, LidarKeeps2dErrorCodes)
+{
+    using dev::CygLidarD1;
+    struct NullStream
+            : dev::IoStreamBase
+    {
+        void open() override {}
+        unsigned int read(void*, unsigned int, const std::chrono::milliseconds) const override { return 0u; }
+        void write(const void*, unsigned int, bool) const override {}
+        void close() const override {}
+    };
+    dev::IoStream ioStream{std::make_unique<NullStream>()};
+    CygLidarD1 lidar{ioStream};
+
+    // first depth 1000, second one Saturation
+    CygLidarD1::Frame2D::Payload payload{};
+    payload[0u] = 0x01u;
+    payload[1u] = 0xe8u;
+    payload[2u] = 0x03u;
+    payload[3u] = 0x83u;
+    payload[4u] = 0x3eu;
+    const auto frame = std::make_unique<CygLidarD1::Frame2D>(payload);
+    lidar.feed({frame->raw(), frame->rawSize()});
+
+    const auto pointCloud = lidar.latest2dPointCloud();
+    ASSERT_EQ((*pointCloud)[0u], 1000u);
+    ASSERT_EQ((*pointCloud)[1u], static_cast<uint16_t>(ErrorCodes2D::Saturation));
+}
+
+} // namespace lidar_viewer::tests::units
@@ -0,0 +1,211 @@
+#include "lidar_viewer/dev/FrameBroadcast.h"
+#include "lidar_viewer/dev/CygLidarD1.h"
+#include "lidar_viewer/dev/IoStreamBase.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace lidar_viewer::tests::units
+{
+
+namespace
+{
+
+using Pool = dev::FramePool<uint64_t, 16u>;
+using Broadcast = dev::FrameBroadcast<uint64_t, 16u, 4u>;
+
+struct NullStream
+        : dev::IoStreamBase
+{
+    void open() override {}
+    unsigned int read(void*, unsigned int, const std::chrono::milliseconds) const override { return 0u; }
+    void write(const void*, unsigned int, bool) const override {}
+    void close() const override {}
+};
+
+bool publish(Pool& pool, Broadcast& broadcast, uint64_t value)
+{
+    auto handle = pool.acquire();
+    if(!handle)
+    {
+        return false;
+    }
+    *handle = value;
+    broadcast.publish(std::move(handle));
+    return true;
+}
+
+} // namespace
+
+TEST(FrameBroadcastTest, EverySubscriberGetsEveryBuffer)
+{
+    Pool pool;
+    Broadcast broadcast{pool};
+    // buffers published before subscribing are not received
+    ASSERT_TRUE(publish(pool, broadcast, 0u));
+    auto first = broadcast.subscribe();
+    auto second = broadcast.subscribe();
+    ASSERT_FALSE(first.next());
+
+    for(uint64_t value = 1u; value <= 3u; ++value)
+    {
+        ASSERT_TRUE(publish(pool, broadcast, value));
+        ASSERT_EQ(*first.next(), value);
+    }
+    ASSERT_FALSE(first.next());
+    ASSERT_EQ(second.statistics().lag, 3u);
+    for(uint64_t value = 1u; value <= 3u; ++value)
+    {
+        ASSERT_EQ(*second.next(), value);
+    }
+    ASSERT_EQ(second.statistics().lag, 0u);
+    ASSERT_EQ(second.statistics().received, 3u);
+    ASSERT_EQ(broadcast.published(), 4u);
+}
+
+TEST(FrameBroadcastTest, SlowSubscriberMissesOverwrittenBuffers)
+{
+    Pool pool;
+    Broadcast broadcast{pool};
+    auto fast = broadcast.subscribe();
+    auto slow = broadcast.subscribe();
+    for(uint64_t value = 0u; value < 10u; ++value)
+    {
+        // the producer never runs out of buffers because of a subscriber lagging behind
+        ASSERT_TRUE(publish(pool, broadcast, value));
+        ASSERT_EQ(*fast.next(), value);
+    }
+    const auto statistics = broadcast.statistics();
+    ASSERT_EQ(statistics.size(), 2u);
+    ASSERT_EQ(statistics[0u].lag, 0u);
+    ASSERT_EQ(statistics[1u].lag, 10u);
+
+    // the last 4 buffers are kept
+    for(uint64_t value = 6u; value < 10u; ++value)
+    {
+        ASSERT_EQ(*slow.next(), value);
+    }
+    ASSERT_FALSE(slow.next());
+    ASSERT_EQ(slow.statistics().missed, 6u);
+    ASSERT_EQ(slow.statistics().received, 4u);
+    ASSERT_EQ(pool.available(), Pool::capacity() - 4u);
+}
+
+TEST(FrameBroadcastTest, SubscribersLimited)
+{
+    Pool pool;
+    Broadcast broadcast{pool};
+    std::vector<Broadcast::Subscriber> subscribers;
+    for(auto i = 0u; i < Broadcast::MAX_SUBSCRIBERS; ++i)
+    {
+        subscribers.push_back(broadcast.subscribe());
+    }
+    ASSERT_THROW((void)broadcast.subscribe(), std::runtime_error);
+    subscribers.pop_back();
+    ASSERT_NO_THROW((void)broadcast.subscribe());
+    ASSERT_EQ(broadcast.statistics().size(), Broadcast::MAX_SUBSCRIBERS - 1u);
+}
+
+TEST(FrameBroadcastTest, WaitNextTimesOut)
+{
+    Pool pool;
+    Broadcast broadcast{pool};
+    auto subscriber = broadcast.subscribe();
+    ASSERT_FALSE(subscriber.waitNext(std::chrono::milliseconds{5}));
+    auto waiting = std::async(std::launch::async, [&subscriber]()
+    {
+        return subscriber.waitNext(std::chrono::milliseconds{1000});
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds{5});
+    ASSERT_TRUE(publish(pool, broadcast, 7u));
+    const auto handle = waiting.get();
+    ASSERT_TRUE(handle);
+    ASSERT_EQ(*handle, 7u);
+}
+
+TEST(FrameBroadcastTest, ConcurrentSubscribersKeepOrder)
+{
+    constexpr uint64_t buffers = 20000u;
+    Pool pool;
+    Broadcast broadcast{pool};
+    std::atomic<bool> done{false};
+
+    const auto consume = [&broadcast, &done](std::chrono::microseconds pause)
+    {
+        auto subscriber = broadcast.subscribe();
+        std::vector<uint64_t> received;
+        for(;;)
+        {
+            const auto finished = done.load();
+            while(auto handle = subscriber.next())
+            {
+                received.push_back(*handle);
+                std::this_thread::sleep_for(pause);
+            }
+            if(finished)
+            {
+                break;
+            }
+            std::this_thread::yield();
+        }
+        return std::make_pair(received, subscriber.statistics());
+    };
+    auto fast = std::async(std::launch::async, consume, std::chrono::microseconds{0});
+    auto slow = std::async(std::launch::async, consume, std::chrono::microseconds{50});
+    std::this_thread::sleep_for(std::chrono::milliseconds{10});
+
+    uint64_t dropped{0u};
+    for(uint64_t value = 0u; value < buffers; ++value)
+    {
+        dropped += !publish(pool, broadcast, value);
+    }
+    done = true;
+    // the subscribers hold one buffer at most, the producer never runs dry
+    ASSERT_EQ(dropped, 0u);
+
+    for(auto* consumer : {&fast, &slow})
+    {
+        const auto [received, statistics] = consumer->get();
+        ASSERT_FALSE(received.empty());
+        for(std::size_t i = 1u; i < received.size(); ++i)
+        {
+            ASSERT_LT(received[i - 1u], received[i]);
+        }
+        ASSERT_EQ(received.back(), buffers - 1u);
+        ASSERT_EQ(statistics.received, received.size());
+        ASSERT_EQ(statistics.received + statistics.missed, buffers);
+    }
+}
+
+TEST(FrameBroadcastTest, LidarBroadcastsEveryFrame)
+{
+    using dev::CygLidarD1;
+    dev::IoStream ioStream{std::make_unique<NullStream>()};
+    CygLidarD1 lidar{ioStream};
+    auto frames = lidar.frame3dBroadcast().subscribe();
+    auto pointClouds = lidar.pointCloud3dBroadcast().subscribe();
+
+    auto payload = std::make_unique<CygLidarD1::Frame3D::Payload>();
+    (*payload)[0u] = static_cast<uint8_t>(CygLidarD1::Mode::Mode3D);
+    const auto frame = std::make_unique<CygLidarD1::Frame3D>(*payload);
+    const std::vector<uint8_t> raw{frame->raw(), frame->raw() + frame->rawSize()};
+    for(auto i = 0u; i < 3u; ++i)
+    {
+        lidar.feed(raw);
+    }
+
+    for(uint64_t sequence = 1u; sequence <= 3u; ++sequence)
+    {
+        ASSERT_EQ(frames.next()->stamp.sequence, sequence);
+        ASSERT_EQ(pointClouds.next()->stamp.sequence, sequence);
+    }
+    ASSERT_FALSE(frames.next());
+    ASSERT_EQ(lidar.frame2dBroadcast().statistics().size(), 0u);
+}
+
+} // namespace lidar_viewer::tests::units
@@ -0,0 +1,123 @@
+#include "lidar_viewer/dev/FrameParser.h"
+#include "lidar_viewer/dev/CygLidarFrame.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace lidar_viewer::tests::units
+{
+
+namespace
+{
+
+std::vector<uint8_t> rawFrame(uint8_t first)
+{
+    dev::Frame<4u> frame{{first, 0x01, 0x03, 0x07}};
+    return {frame.raw(), frame.raw() + frame.rawSize()};
+}
+
+void append(std::vector<uint8_t>& stream, const std::vector<uint8_t>& data)
+{
+    stream.insert(stream.end(), data.begin(), data.end());
+}
+
+} // namespace
+
+TEST(FrameParserTest, FramesSplitAcrossCalls)
+{
+    dev::FrameParser parser{16u};
+    std::vector<uint8_t> stream;
+    for(auto i = 0u; i < 3u; ++i)
+    {
+        append(stream, rawFrame(static_cast<uint8_t>(i)));
+    }
+
+    std::vector<uint8_t> firstBytes;
+    for(const auto byte : stream)
+    {
+        parser.feed({&byte, 1u}, [&firstBytes](std::span<const uint8_t> frame)
+        {
+            ASSERT_EQ(frame.size(), dev::Frame<4u>{}.rawSize());
+            firstBytes.push_back(frame[5u]);
+        });
+    }
+    ASSERT_EQ(firstBytes, (std::vector<uint8_t>{0u, 1u, 2u}));
+    ASSERT_EQ(parser.statistics().framesParsed, 3u);
+    ASSERT_EQ(parser.statistics().bytesSkipped, 0u);
+    ASSERT_EQ(parser.pendingBytes(), 0u);
+}
+
+TEST(FrameParserTest, ResynchronizesAfterGarbage)
+{
+    dev::FrameParser parser{16u};
+    std::vector<uint8_t> stream{0x01u, 0x5au, 0x77u};
+    append(stream, rawFrame(1u));
+    // truncated frame followed immediately by a valid one
+    auto truncated = rawFrame(2u);
+    truncated.resize(7u);
+    append(stream, truncated);
+    append(stream, rawFrame(3u));
+
+    std::vector<uint8_t> firstBytes;
+    parser.feed(stream, [&firstBytes](std::span<const uint8_t> frame) { firstBytes.push_back(frame[5u]); });
+    ASSERT_EQ(firstBytes, (std::vector<uint8_t>{1u, 3u}));
+    ASSERT_EQ(parser.statistics().bytesSkipped, 3u + truncated.size());
+    ASSERT_EQ(parser.statistics().framesRecovered, 2u);
+    ASSERT_GE(parser.statistics().checksumErrors + parser.statistics().lengthErrors, 1u);
+}
+
+TEST(FrameParserTest, RejectsLengthOutOfRange)
+{
+    dev::FrameParser parser{2u};
+    const auto stream = rawFrame(1u);
+    auto frames = 0u;
+    parser.feed(stream, [&frames](std::span<const uint8_t> ) { ++frames; });
+    ASSERT_EQ(frames, 0u);
+    ASSERT_EQ(parser.statistics().lengthErrors, 1u);
+    ASSERT_EQ(parser.statistics().bytesSkipped, stream.size());
+}
+
+TEST(FrameParserTest, RejectsChecksumMismatch)
+{
+    dev::FrameParser parser{16u};
+    auto corrupted = rawFrame(1u);
+    corrupted[6u] ^= 0x10u;
+    auto frames = 0u;
+    parser.feed(corrupted, [&frames](std::span<const uint8_t> ) { ++frames; });
+    parser.feed(rawFrame(2u), [&frames](std::span<const uint8_t> ) { ++frames; });
+    ASSERT_EQ(frames, 1u);
+    ASSERT_EQ(parser.statistics().checksumErrors, 1u);
+    ASSERT_EQ(parser.statistics().framesRecovered, 1u);
+}
+
+TEST(FrameParserTest, ChecksumCoversWholePayload)
+{
+    const auto frame = rawFrame(1u);
+    ASSERT_TRUE(dev::FrameParser::checksumValid(frame));
+    // XOR leaving out the last payload byte
+    auto shortChecksum = frame;
+    shortChecksum.back() ^= shortChecksum[shortChecksum.size() - 2u];
+    ASSERT_FALSE(dev::FrameParser::checksumValid(shortChecksum));
+    auto corrupted = frame;
+    corrupted[corrupted.size() - 2u] ^= 0x01u;
+    ASSERT_FALSE(dev::FrameParser::checksumValid(corrupted));
+}
+
+TEST(FrameParserTest, HeaderSplitAcrossCalls)
+{
+    dev::FrameParser parser{16u};
+    const auto frame = rawFrame(1u);
+    std::vector<uint8_t> firstPart{0x00u, 0x00u};
+    firstPart.insert(firstPart.end(), frame.begin(), frame.begin() + 2);
+    auto frames = 0u;
+    parser.feed(firstPart, [&frames](std::span<const uint8_t> ) { ++frames; });
+    ASSERT_EQ(parser.pendingBytes(), 2u);
+    parser.feed({frame.data() + 2, frame.size() - 2u}, [&frames](std::span<const uint8_t> ) { ++frames; });
+    ASSERT_EQ(frames, 1u);
+    ASSERT_EQ(parser.statistics().bytesSkipped, 2u);
+    parser.reset();
+    ASSERT_EQ(parser.pendingBytes(), 0u);
+}
+
+} // namespace lidar_viewer::tests::units
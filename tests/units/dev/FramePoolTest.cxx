@@ -0,0 +1,193 @@
+#include "lidar_viewer/dev/FramePool.h"
+#include "lidar_viewer/dev/CygLidarD1.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <future>
+#include <vector>
+
+namespace lidar_viewer::tests::units
+{
+
+namespace
+{
+
+/// stream the lidar is fed from directly
+struct NullStream
+        : dev::IoStreamBase
+{
+    void open() override {}
+    unsigned int read(void*, unsigned int, const std::chrono::milliseconds) const override { return 0u; }
+    void write(const void*, unsigned int, bool) const override {}
+    void close() const override {}
+};
+
+} // namespace
+
+TEST(FramePoolTest, ExhaustedAndRefilled)
+{
+    dev::FramePool<int, 3u> pool{};
+    ASSERT_EQ(pool.available(), 3u);
+
+    std::vector<dev::FramePool<int, 3u>::Handle> handles;
+    for(auto i = 0; i < 3; ++i)
+    {
+        handles.emplace_back(pool.acquire());
+        ASSERT_TRUE(handles.back());
+        *handles.back() = i;
+    }
+    ASSERT_EQ(pool.available(), 0u);
+    ASSERT_FALSE(pool.acquire());
+
+    handles.erase(handles.begin());
+    ASSERT_EQ(pool.available(), 1u);
+    const auto handle = pool.acquire();
+    ASSERT_TRUE(handle);
+    // buffer keeps contents it was released with
+    ASSERT_EQ(*handle, 0);
+}
+
+TEST(FramePoolTest, SharedUntilLastHandleGone)
+{
+    dev::FramePool<int, 2u> pool{};
+    auto handle = pool.acquire();
+    *handle = 42;
+    {
+        const auto copy = handle;
+        ASSERT_EQ(copy.useCount(), 2u);
+        ASSERT_EQ(copy.get(), handle.get());
+
+        dev::FramePool<int, 2u>::ConstHandle readOnly{std::move(handle)};
+        ASSERT_FALSE(handle);
+        ASSERT_EQ(*readOnly, 42);
+        ASSERT_EQ(pool.available(), 1u);
+    }
+    ASSERT_EQ(pool.available(), 2u);
+}
+
+TEST(FramePoolTest, ConcurrentAcquireRelease)
+{
+    dev::FramePool<uint64_t, 64u> pool{};
+    constexpr auto iterations = 20000u;
+    const auto worker = [&pool]()
+    {
+        for(auto i = 0u; i < iterations; ++i)
+        {
+            auto handle = pool.acquire();
+            if(!handle)
+            {
+                continue;
+            }
+            // nobody else holds the buffer
+            *handle = i;
+            const auto copy = handle;
+            EXPECT_EQ(*copy, i);
+        }
+    };
+    std::vector<std::future<void>> workers;
+    for(auto i = 0u; i < 4u; ++i)
+    {
+        workers.emplace_back(std::async(std::launch::async, worker));
+    }
+    for(auto& w : workers)
+    {
+        w.get();
+    }
+    ASSERT_EQ(pool.available(), 64u);
+}
+
+TEST(FramePoolTest, LatestPublishedWhileRead)
+{
+    using Buffer = std::array<uint64_t, 64u>;
+    using Pool = dev::FramePool<Buffer, 4u>;
+    Pool pool{};
+    {
+        Pool::Latest latest{pool};
+        ASSERT_FALSE(latest.load());
+
+        constexpr auto frames = 100000u;
+        std::atomic<bool> done{false};
+        const auto reader = [&latest, &done]()
+        {
+            uint64_t previous{0u};
+            uint64_t loads{0u};
+            while(!done.load())
+            {
+                const auto handle = latest.load();
+                if(!handle)
+                {
+                    continue;
+                }
+                // buffer is complete and newer buffers are never followed by older ones
+                const auto value = (*handle)[0u];
+                EXPECT_TRUE(std::all_of(handle->begin(), handle->end(), [value](auto v){ return v == value; }));
+                EXPECT_GE(value, previous);
+                previous = value;
+                ++loads;
+            }
+            return loads;
+        };
+        std::vector<std::future<uint64_t>> readers;
+        for(auto i = 0u; i < 3u; ++i)
+        {
+            readers.emplace_back(std::async(std::launch::async, reader));
+        }
+
+        uint64_t dropped{0u};
+        for(uint64_t frame = 1u; frame <= frames; ++frame)
+        {
+            auto handle = pool.acquire();
+            if(!handle)
+            {
+                // readers hold every buffer, the writer does not wait for them
+                ++dropped;
+                continue;
+            }
+            handle->fill(frame);
+            latest.publish(std::move(handle));
+        }
+        done = true;
+        for(auto& r : readers)
+        {
+            ASSERT_GT(r.get(), 0u);
+        }
+        ASSERT_LT(dropped, frames);
+        // the latest buffer stays published
+        ASSERT_EQ(pool.available(), Pool::capacity() - 1u);
+        ASSERT_TRUE(latest.load());
+    }
+    ASSERT_EQ(pool.available(), Pool::capacity());
+}
+
+TEST(FramePoolTest, LidarFrameHeldAcrossNewerFrames)
+{
+    using dev::CygLidarD1;
+    dev::IoStream ioStream{std::make_unique<NullStream>()};
+    CygLidarD1 lidar{ioStream};
+
+    const auto makeFrame = [](uint8_t depth)
+    {
+        auto payload = std::make_unique<CygLidarD1::Frame3D::Payload>();
+        (*payload)[0u] = 0x08u;
+        (*payload)[1u] = depth;
+        const auto frame = std::make_unique<CygLidarD1::Frame3D>(*payload);
+        return std::vector<uint8_t>{frame->raw(), frame->raw() + frame->rawSize()};
+    };
+
+    lidar.feed(makeFrame(1u));
+    const auto held = lidar.latest3dPointCloud();
+    ASSERT_EQ((*held)[0u], 1u);
+    for(auto depth = 2u; depth < 2u * CygLidarD1::FRAME_POOL_SIZE; ++depth)
+    {
+        lidar.feed(makeFrame(static_cast<uint8_t>(depth)));
+    }
+    // held point cloud is not reused, buffers are recycled among the rest
+    ASSERT_EQ((*held)[0u], 1u);
+    ASSERT_EQ((*lidar.latest3dPointCloud())[0u], 2u * CygLidarD1::FRAME_POOL_SIZE - 1u);
+    ASSERT_EQ(lidar.framesDropped(), 0u);
+}
+
+} // namespace lidar_viewer::tests::units
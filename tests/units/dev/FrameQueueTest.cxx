@@ -0,0 +1,230 @@
+#include "lidar_viewer/dev/FrameQueue.h"
+#include "lidar_viewer/dev/CygLidarD1.h"
+#include "lidar_viewer/dev/DepthPacking.h"
+#include "lidar_viewer/dev/IoStreamBase.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <future>
+#include <memory>
+#include <vector>
+
+namespace lidar_viewer::tests::units
+{
+
+namespace
+{
+
+using Queue = dev::FrameQueue<std::unique_ptr<uint32_t>>;
+
+struct NullStream
+        : dev::IoStreamBase
+{
+    void open() override {}
+    unsigned int read(void*, unsigned int, const std::chrono::milliseconds) const override { return 0u; }
+    void write(const void*, unsigned int, bool) const override {}
+    void close() const override {}
+};
+
+std::vector<uint8_t> raw3dFrame()
+{
+    using Lidar = dev::CygLidarD1;
+    std::vector<uint16_t> depths(Lidar::Sensor::DEPTHS_3D, 1000u);
+    auto payload = std::make_unique<Lidar::Frame3D::Payload>();
+    (*payload)[0u] = static_cast<uint8_t>(Lidar::Mode::Mode3D);
+    dev::pack12(depths, std::span{*payload}.subspan(1u));
+    const auto frame = std::make_unique<Lidar::Frame3D>(*payload);
+    return {frame->raw(), frame->raw() + frame->rawSize()};
+}
+
+} // namespace
+
+TEST(FrameQueueTest, CapacityRoundedUpToPowerOfTwo)
+{
+    ASSERT_EQ(Queue(5u, dev::OverflowPolicy::DropNewest).capacity(), 8u);
+    ASSERT_EQ(Queue(8u, dev::OverflowPolicy::DropNewest).capacity(), 8u);
+    ASSERT_EQ(Queue(0u, dev::OverflowPolicy::DropNewest).capacity(), 2u);
+    ASSERT_EQ(Queue(1u, dev::OverflowPolicy::DropNewest).capacity(), 2u);
+}
+
+TEST(FrameQueueTest, PopsInPushOrder)
+{
+    Queue queue{4u, dev::OverflowPolicy::Block};
+    ASSERT_FALSE(queue.tryPop().has_value());
+    for(uint32_t i = 0u; i < 3u; ++i)
+    {
+        ASSERT_TRUE(queue.push(std::make_unique<uint32_t>(i)));
+    }
+    ASSERT_EQ(queue.size(), 3u);
+    for(uint32_t i = 0u; i < 3u; ++i)
+    {
+        const auto element = queue.tryPop();
+        ASSERT_TRUE(element.has_value());
+        ASSERT_EQ(**element, i);
+    }
+    ASSERT_EQ(queue.size(), 0u);
+    ASSERT_FALSE(queue.pop(std::chrono::milliseconds{1}).has_value());
+    ASSERT_EQ(queue.statistics().pushed, 3u);
+    ASSERT_EQ(queue.statistics().popped, 3u);
+}
+
+TEST(FrameQueueTest, DropNewestKeepsQueuedElements)
+{
+    Queue queue{2u, dev::OverflowPolicy::DropNewest};
+    ASSERT_TRUE(queue.push(std::make_unique<uint32_t>(0u)));
+    ASSERT_TRUE(queue.push(std::make_unique<uint32_t>(1u)));
+    ASSERT_FALSE(queue.push(std::make_unique<uint32_t>(3u)));
+    ASSERT_EQ(queue.statistics().droppedNewest, 1u);
+    ASSERT_EQ(**queue.tryPop(), 0u);
+    ASSERT_EQ(**queue.tryPop(), 1u);
+    ASSERT_FALSE(queue.tryPop().has_value());
+}
+
+TEST(FrameQueueTest, DropOldestKeepsLatestElements)
+{
+    Queue queue{2u, dev::OverflowPolicy::DropOldest};
+    for(uint32_t i = 0u; i < 5u; ++i)
+    {
+        ASSERT_TRUE(queue.push(std::make_unique<uint32_t>(i)));
+    }
+    ASSERT_EQ(queue.statistics().droppedOldest, 3u);
+    ASSERT_EQ(queue.size(), 2u);
+    ASSERT_EQ(**queue.tryPop(), 3u);
+    ASSERT_EQ(**queue.tryPop(), 4u);
+    ASSERT_FALSE(queue.tryPop().has_value());
+}
+
+TEST(FrameQueueTest, BlockWaitsForRoom)
+{
+    Queue queue{2u, dev::OverflowPolicy::Block};
+    ASSERT_TRUE(queue.push(std::make_unique<uint32_t>(0u)));
+    ASSERT_TRUE(queue.push(std::make_unique<uint32_t>(1u)));
+    auto producer = std::async(std::launch::async, [&queue]()
+    {
+        return queue.push(std::make_unique<uint32_t>(2u));
+    });
+    ASSERT_EQ(producer.wait_for(std::chrono::milliseconds{20}), std::future_status::timeout);
+    ASSERT_EQ(**queue.tryPop(), 0u);
+    ASSERT_TRUE(producer.get());
+    ASSERT_EQ(queue.statistics().blocked, 1u);
+    ASSERT_EQ(**queue.pop(std::chrono::milliseconds{100}), 1u);
+    ASSERT_EQ(**queue.pop(std::chrono::milliseconds{100}), 2u);
+}
+
+TEST(FrameQueueTest, CloseReleasesBlockedProducer)
+{
+    Queue queue{2u, dev::OverflowPolicy::Block};
+    ASSERT_TRUE(queue.push(std::make_unique<uint32_t>(0u)));
+    ASSERT_TRUE(queue.push(std::make_unique<uint32_t>(1u)));
+    auto producer = std::async(std::launch::async, [&queue]()
+    {
+        return queue.push(std::make_unique<uint32_t>(2u));
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    queue.close();
+    ASSERT_FALSE(producer.get());
+    ASSERT_FALSE(queue.push(std::make_unique<uint32_t>(3u)));
+    // queued elements are still consumed
+    ASSERT_EQ(**queue.tryPop(), 0u);
+}
+
+TEST(FrameQueueTest, ConcurrentDropOldestKeepsOrder)
+{
+    constexpr uint32_t elements = 100000u;
+    Queue queue{8u, dev::OverflowPolicy::DropOldest};
+    auto producer = std::async(std::launch::async, [&queue]()
+    {
+        for(uint32_t i = 0u; i < elements; ++i)
+        {
+            queue.push(std::make_unique<uint32_t>(i));
+        }
+        queue.close();
+    });
+
+    std::vector<uint32_t> consumed;
+    for(;;)
+    {
+        auto element = queue.pop(std::chrono::milliseconds{100});
+        if(!element)
+        {
+            break;
+        }
+        consumed.push_back(**element);
+    }
+    producer.get();
+    while(auto element = queue.tryPop())
+    {
+        consumed.push_back(**element);
+    }
+
+    // every element is either consumed once, in order, or dropped
+    ASSERT_FALSE(consumed.empty());
+    ASSERT_EQ(consumed.back(), elements - 1u);
+    for(std::size_t i = 1u; i < consumed.size(); ++i)
+    {
+        ASSERT_LT(consumed[i - 1u], consumed[i]);
+    }
+    const auto statistics = queue.statistics();
+    ASSERT_EQ(statistics.pushed, elements);
+    ASSERT_EQ(statistics.popped, consumed.size());
+    ASSERT_EQ(statistics.popped + statistics.droppedOldest, elements);
+}
+
+TEST(FrameQueueTest, LidarQueuesEveryPointCloud)
+{
+    constexpr auto frames = 20u;
+    dev::IoStream ioStream{std::make_unique<NullStream>()};
+    dev::CygLidarD1 lidar{ioStream};
+    dev::CygLidarD1::PointCloud3DQueue queue{8u, dev::OverflowPolicy::DropOldest};
+    ASSERT_LE(queue.capacity(), dev::CygLidarD1::MAX_QUEUE_DEPTH);
+    lidar.queue3dPointClouds(&queue);
+
+    const auto raw = raw3dFrame();
+    for(auto i = 0u; i < frames; ++i)
+    {
+        lidar.feed(raw);
+    }
+    lidar.queue3dPointClouds(nullptr);
+
+    // the queue holds the latest point clouds, older ones were dropped and their buffers reused
+    const auto statistics = queue.statistics();
+    ASSERT_EQ(statistics.pushed, frames);
+    ASSERT_EQ(statistics.droppedOldest, frames - queue.capacity());
+    ASSERT_EQ(lidar.framesDropped(), 0u);
+    for(auto sequence = frames - queue.capacity() + 1u; sequence <= frames; ++sequence)
+    {
+        const auto pointCloud = queue.tryPop();
+        ASSERT_TRUE(pointCloud.has_value());
+        ASSERT_EQ((*pointCloud)->stamp.sequence, sequence);
+        ASSERT_EQ((*pointCloud)->validity.counts.valid, dev::CygLidarD1::Sensor::DEPTHS_3D);
+    }
+    ASSERT_FALSE(queue.tryPop().has_value());
+}
+
+TEST(FrameQueueTest, LidarQueueOfMaxDepthDropsNoFrame)
+{
+    constexpr auto frames = 4u * dev::CygLidarD1::FRAME_POOL_SIZE;
+    dev::IoStream ioStream{std::make_unique<NullStream>()};
+    dev::CygLidarD1 lidar{ioStream};
+    dev::CygLidarD1::PointCloud3DQueue queue{dev::CygLidarD1::MAX_QUEUE_DEPTH, dev::OverflowPolicy::DropOldest};
+    ASSERT_EQ(queue.capacity(), dev::CygLidarD1::MAX_QUEUE_DEPTH);
+    lidar.queue3dPointClouds(&queue);
+
+    // a full queue and point clouds held by two consumers still leave a buffer to parse into
+    const auto held = lidar.latest3dPointCloud();
+    const auto raw = raw3dFrame();
+    for(auto i = 0u; i < frames; ++i)
+    {
+        lidar.feed(raw);
+    }
+    const auto heldLater = lidar.latest3dPointCloud();
+    lidar.feed(raw);
+    lidar.queue3dPointClouds(nullptr);
+
+    ASSERT_EQ(lidar.framesDropped(), 0u);
+    ASSERT_EQ(queue.statistics().pushed, frames + 1u);
+    ASSERT_EQ(lidar.latest3dPointCloud()->stamp.sequence, frames + 1u);
+}
+
+} // namespace lidar_viewer::tests::units
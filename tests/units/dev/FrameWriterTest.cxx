@@ -4,8 +4,12 @@
 
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
+#include <condition_variable>
 #include <future>
 #include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
 
 namespace lidar_viewer::tests::units
 {
@@ -35,6 +39,47 @@ public:
     MOCK_METHOD(void, close, (),  (const, override));
 };
 
+/// keeps the capture times of the records written, the first write waits until released
+class CaptureTimeSink
+: public dev::IoStreamBase
+{
+public:
+    void open() override {}
+    unsigned int read(void*, unsigned int, const std::chrono::milliseconds) const override { return 0u; }
+    void write(const void*, unsigned int, bool) const override
+    {
+        throw std::runtime_error{"CaptureTimeSink::write : record written without its capture time"};
+    }
+    void writeRecord(const void*, unsigned int, std::chrono::nanoseconds captureTime) const override
+    {
+        std::unique_lock lock{mutex};
+        released.wait(lock, [this]() { return release; });
+        captureTimes.push_back(captureTime);
+    }
+    void close() const override {}
+
+    void releaseWrites()
+    {
+        {
+            std::lock_guard lGuard{mutex};
+            release = true;
+        }
+        released.notify_all();
+    }
+
+    std::vector<std::chrono::nanoseconds> written() const
+    {
+        std::lock_guard lGuard{mutex};
+        return captureTimes;
+    }
+
+private:
+    mutable std::mutex mutex{};
+    mutable std::condition_variable released{};
+    bool release{false};
+    mutable std::vector<std::chrono::nanoseconds> captureTimes{};
+};
+
 class FrameWriterTest : public ::testing::Test {
 protected:
     MockFrameProvider mockFrameProvider;
@@ -107,5 +152,87 @@ TEST_F(FrameWriterTest, HandlesExceptionsGracefully)
                     });
 }
 
+TEST(FrameWriterStandalone, WritesEveryLidarFrameOnce)
+{
+    using namespace ::testing;
+    using namespace std::chrono_literals;
+    dev::IoStream lidarStream{std::make_unique<NiceMock<MockIoStream>>()};
+    dev::CygLidarD1 lidar{lidarStream};
+
+    std::mutex writtenMutex;
+    std::vector<uint8_t> firstDepths;
+    auto mockIoStream = std::make_unique<MockIoStream>();
+    EXPECT_CALL(*mockIoStream, write(_, _, false))
+            .WillRepeatedly(Invoke([&](const void* ptr, unsigned int, bool)
+            {
+                std::lock_guard lGuard{writtenMutex};
+                firstDepths.push_back(reinterpret_cast<const uint8_t*>(ptr)[6u]);
+            }));
+    dev::IoStream ioStream{std::move(mockIoStream)};
+    dev::FrameWriter<dev::CygLidarD1> frameWriter{lidar, ioStream};
+    frameWriter.start();
+
+    const auto written = [&]()
+    {
+        std::lock_guard lGuard{writtenMutex};
+        return firstDepths.size();
+    };
+    constexpr auto frames = 5u;
+    for(auto i = 1u; i <= frames; ++i)
+    {
+        dev::CygLidarD1::Frame3D::Payload payload{};
+        payload[0u] = 0x08u;
+        payload[1u] = static_cast<uint8_t>(i);
+        const auto frame = std::make_unique<dev::CygLidarD1::Frame3D>(payload);
+        lidar.feed({frame->raw(), frame->rawSize()});
+        const auto deadline = std::chrono::steady_clock::now() + 2s;
+        while(written() < i && std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::sleep_for(1ms);
+        }
+    }
+    // no frame is repeated while no new one arrives
+    std::this_thread::sleep_for(30ms);
+    frameWriter.stop();
+    ASSERT_EQ(firstDepths, (std::vector<uint8_t>{1u, 2u, 3u, 4u, 5u}));
+}
+
+TEST(FrameWriterStandalone, FramesRecordedWithCaptureTime)
+{
+    using namespace ::testing;
+    using namespace std::chrono_literals;
+    dev::IoStream lidarStream{std::make_unique<NiceMock<MockIoStream>>()};
+    dev::CygLidarD1 lidar{lidarStream};
+
+    auto sink = std::make_unique<CaptureTimeSink>();
+    auto& captureTimeSink = *sink;
+    dev::IoStream ioStream{std::move(sink)};
+    dev::FrameWriter<dev::CygLidarD1> frameWriter{lidar, ioStream};
+    frameWriter.start();
+
+    // frames arrive while the writer is held, so it catches up with them later
+    std::vector<std::chrono::nanoseconds> captureTimes;
+    constexpr auto frames = 3u;
+    for(auto i = 1u; i <= frames; ++i)
+    {
+        dev::CygLidarD1::Frame3D::Payload payload{};
+        payload[0u] = 0x08u;
+        payload[1u] = static_cast<uint8_t>(i);
+        const auto frame = std::make_unique<dev::CygLidarD1::Frame3D>(payload);
+        lidar.feed({frame->raw(), frame->rawSize()});
+        captureTimes.push_back(lidar.latest3dFrame()->stamp.captureTime.time_since_epoch());
+        std::this_thread::sleep_for(10ms);
+    }
+    captureTimeSink.releaseWrites();
+
+    const auto deadline = std::chrono::steady_clock::now() + 2s;
+    while(captureTimeSink.written().size() < frames && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(1ms);
+    }
+    frameWriter.stop();
+    EXPECT_EQ(captureTimeSink.written(), captureTimes);
+}
+
 } // namespace lidar_viewer::tests::units
 
@@ -0,0 +1,287 @@
+#include "lidar_viewer/dev/IoReactor.h"
+#include "lidar_viewer/dev/CygLidarD1.h"
+
+#include <gtest/gtest.h>
+
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace lidar_viewer::tests::units
+{
+
+namespace
+{
+
+/// pseudo terminal standing in for the lidar
+class PseudoTerminal
+{
+public:
+    PseudoTerminal()
+    : master{::posix_openpt(O_RDWR | O_NOCTTY)}
+    {
+        if(master < 0 || ::grantpt(master) != 0 || ::unlockpt(master) != 0)
+        {
+            throw std::runtime_error{"Unable to open a pseudo terminal"};
+        }
+    }
+
+    ~PseudoTerminal() noexcept
+    {
+        ::close(master);
+    }
+
+    [[nodiscard]] std::string slaveName() const
+    {
+        return ::ptsname(master);
+    }
+
+    [[nodiscard]] bool write(const void* ptr, std::size_t size) const
+    {
+        auto uptr = reinterpret_cast<const uint8_t*>(ptr);
+        while(size > 0u)
+        {
+            const auto wret = ::write(master, uptr, size);
+            if(wret <= 0)
+            {
+                return false;
+            }
+            uptr += wret;
+            size -= static_cast<std::size_t>(wret);
+        }
+        return true;
+    }
+
+private:
+    int master;
+};
+
+/// simulated lidar, the device side of a pseudo terminal and the lidar parsing what the port receives
+struct SimulatedDevice
+{
+    PseudoTerminal terminal{};
+    std::unique_ptr<dev::IoStream> ioStream{};
+    const dev::SerialPort* port{};
+    std::unique_ptr<dev::CygLidarD1> lidar{};
+
+    SimulatedDevice()
+    {
+        auto serialPort = std::make_unique<dev::SerialPort>(terminal.slaveName(), B3000000);
+        port = serialPort.get();
+        ioStream = std::make_unique<dev::IoStream>(std::move(serialPort));
+        lidar = std::make_unique<dev::CygLidarD1>(*ioStream);
+    }
+};
+
+std::vector<uint8_t> make3dFrames(std::size_t count)
+{
+    dev::CygLidarD1::Frame3D::Payload payload{};
+    payload[0u] = 0x08u;
+    payload[1u] = 0x23u;
+    payload[2u] = 0x61u;
+    payload[3u] = 0x45u;
+    const auto frame3d = std::make_unique<dev::CygLidarD1::Frame3D>(payload);
+    std::vector<uint8_t> stream;
+    stream.reserve(count * frame3d->rawSize());
+    for(auto i = 0u; i < count; ++i)
+    {
+        stream.insert(stream.end(), frame3d->raw(), frame3d->raw() + frame3d->rawSize());
+    }
+    return stream;
+}
+
+} // namespace
+
+TEST(IoReactorTest, DataDispatchedToHandler)
+{
+    using namespace std::chrono_literals;
+    int fds[2];
+    ASSERT_EQ(::pipe2(fds, O_NONBLOCK), 0);
+
+    dev::IoReactor reactor{};
+    std::vector<uint8_t> received;
+    reactor.add(fds[0], [&received](std::span<const uint8_t> data)
+    {
+        received.insert(received.end(), data.begin(), data.end());
+    });
+    ASSERT_EQ(reactor.devices(), 1u);
+    ASSERT_EQ(reactor.poll(0ms), 0u);
+
+    const std::vector<uint8_t> sent{0x01u, 0x02u, 0x03u};
+    ASSERT_EQ(::write(fds[1], sent.data(), sent.size()), static_cast<ssize_t>(sent.size()));
+    ASSERT_EQ(reactor.poll(100ms), 1u);
+    ASSERT_EQ(received, sent);
+
+    reactor.remove(fds[0]);
+    ASSERT_EQ(reactor.devices(), 0u);
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
+
+TEST(IoReactorTest, HungUpDeviceDropped)
+{
+    using namespace std::chrono_literals;
+    int fds[2];
+    ASSERT_EQ(::pipe2(fds, O_NONBLOCK), 0);
+
+    dev::IoReactor reactor{};
+    reactor.add(fds[0], [](std::span<const uint8_t>) { });
+    ::close(fds[1]);
+    ASSERT_EQ(reactor.poll(100ms), 0u);
+    ASSERT_EQ(reactor.devices(), 0u);
+    ASSERT_EQ(reactor.statistics().devicesClosed, 1u);
+    ::close(fds[0]);
+}
+
+TEST(IoReactorTest, SerialPortBufferedDataFedToSink)
+{
+    using namespace std::chrono_literals;
+    // any type parsing data it is fed
+    struct Sink
+    {
+        void feed(std::span<const uint8_t> data)
+        {
+            received.insert(received.end(), data.begin(), data.end());
+        }
+
+        std::vector<uint8_t> received;
+    };
+
+    PseudoTerminal terminal{};
+    dev::SerialPort port{terminal.slaveName(), B3000000};
+    const std::vector<uint8_t> sent{0x01u, 0x02u, 0x03u, 0x04u, 0x05u, 0x06u, 0x07u, 0x08u, 0x09u, 0x0au};
+    ASSERT_TRUE(terminal.write(sent.data(), 6u));
+    std::this_thread::sleep_for(50ms);
+    // the port buffers everything received, a part of it is read
+    std::array<uint8_t, 2u> head{};
+    ASSERT_EQ(port.read(head.data(), static_cast<unsigned int>(head.size()), 100ms), head.size());
+
+    dev::IoReactor reactor{};
+    Sink sink{};
+    reactor.add(port, sink);
+    ASSERT_TRUE(terminal.write(sent.data() + 6u, sent.size() - 6u));
+    for(auto i = 0u; i < 20u && sink.received.size() < sent.size() - head.size(); ++i)
+    {
+        reactor.poll(100ms);
+    }
+    EXPECT_EQ(sink.received, std::vector<uint8_t>(sent.begin() + 2, sent.end()));
+}
+
+TEST(IoReactorTest, SlowHandlerDoesNotBlockRegistration)
+{
+    using namespace std::chrono_literals;
+    int fds[2];
+    int otherFds[2];
+    ASSERT_EQ(::pipe2(fds, O_NONBLOCK), 0);
+    ASSERT_EQ(::pipe2(otherFds, O_NONBLOCK), 0);
+
+    dev::IoReactor reactor{};
+    std::atomic<bool> handling{false};
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    reactor.add(fds[0], [&handling, released](std::span<const uint8_t>)
+    {
+        handling.store(true);
+        released.wait();
+    });
+    reactor.start();
+    const uint8_t byte{0x01u};
+    ASSERT_EQ(::write(fds[1], &byte, 1u), 1);
+    for(auto i = 0u; i < 1000u && !handling.load(); ++i)
+    {
+        std::this_thread::sleep_for(1ms);
+    }
+    ASSERT_TRUE(handling.load());
+
+    auto registration = std::async(std::launch::async, [&reactor, &otherFds]()
+    {
+        reactor.add(otherFds[0], [](std::span<const uint8_t>) { });
+        return std::pair{reactor.devices(), reactor.statistics().bytesRead};
+    });
+    const auto registered = registration.wait_for(1s) == std::future_status::ready;
+    release.set_value();
+    ASSERT_TRUE(registered);
+    EXPECT_EQ(registration.get(), (std::pair<std::size_t, uint64_t>{2u, 1u}));
+
+    reactor.stop();
+    for(const auto fd : {fds[0], fds[1], otherFds[0], otherFds[1]})
+    {
+        ::close(fd);
+    }
+}
+
+TEST(IoReactorTest, ManyDevicesOnSingleThread)
+{
+    using namespace std::chrono_literals;
+    constexpr auto deviceCount = 8u;
+    constexpr auto framesPerDevice = 100u;
+
+    std::vector<std::unique_ptr<SimulatedDevice>> devices;
+    for(auto i = 0u; i < deviceCount; ++i)
+    {
+        devices.emplace_back(std::make_unique<SimulatedDevice>());
+    }
+
+    dev::IoReactor reactor{};
+    for(const auto& device : devices)
+    {
+        reactor.add(*device->port, *device->lidar);
+    }
+    ASSERT_EQ(reactor.devices(), deviceCount);
+
+    const auto stream = make3dFrames(framesPerDevice);
+    reactor.start();
+    std::vector<std::future<bool>> writers;
+    for(const auto& device : devices)
+    {
+        writers.emplace_back(std::async(std::launch::async, [&stream, &terminal = device->terminal]()
+        {
+            return terminal.write(stream.data(), stream.size());
+        }));
+    }
+    for(auto& writer : writers)
+    {
+        ASSERT_TRUE(writer.get());
+    }
+
+    const auto allParsed = [&devices]()
+    {
+        return std::all_of(devices.begin(), devices.end(), [](const auto& device)
+        {
+            return device->lidar->parserStatistics().framesParsed == framesPerDevice;
+        });
+    };
+    const auto deadline = std::chrono::steady_clock::now() + 10s;
+    while(!allParsed() && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(1ms);
+    }
+    reactor.stop();
+
+    for(const auto& device : devices)
+    {
+        const auto statistics = device->lidar->parserStatistics();
+        EXPECT_EQ(statistics.framesParsed, framesPerDevice);
+        EXPECT_EQ(statistics.bytesSkipped, 0u);
+        device->lidar->use3dPointCloud([](const auto& pointCloud)
+        {
+            EXPECT_EQ(pointCloud[0u], 0x123u);
+            EXPECT_EQ(pointCloud[1u], 0x456u);
+        });
+    }
+    const auto statistics = reactor.statistics();
+    EXPECT_EQ(statistics.bytesRead, deviceCount * stream.size());
+    EXPECT_EQ(statistics.devicesClosed, 0u);
+}
+
+} // namespace lidar_viewer::tests::units
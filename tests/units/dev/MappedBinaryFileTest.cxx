@@ -0,0 +1,129 @@
+#include "lidar_viewer/dev/MappedBinaryFile.h"
+#include "lidar_viewer/dev/BinaryFile.h"
+#include "lidar_viewer/dev/CygLidarFrame.h"
+
+#include <gtest/gtest.h>
+
+namespace lidar_viewer::tests::units
+{
+
+using namespace std::string_literals;
+
+TEST(MappedBinaryFileTest, TestMappedBinaryFileOpenFailCase)
+{
+    ASSERT_THROW(lidar_viewer::dev::MappedBinaryFile{"NonExistingFile"},
+                 std::runtime_error);
+}
+
+TEST(MappedBinaryFileTest, TestMappedBinaryFileReadEmptyFile)
+{
+    const auto dummyBinaryFile = "dummy_mapped.bin"s;
+    ::system(("touch " + dummyBinaryFile).c_str());
+    {
+        std::array<uint8_t, 2> dummyArray{};
+        lidar_viewer::dev::MappedBinaryFile mappedFile{dummyBinaryFile};
+        ASSERT_EQ(mappedFile.size(), 0u);
+        ASSERT_THROW(mappedFile.read(&dummyArray, sizeof(dummyArray), {}), std::runtime_error);
+    }
+    ::system(("rm " + dummyBinaryFile).c_str());
+}
+
+TEST(MappedBinaryFileTest, TestMappedBinaryFileReadAndEof)
+{
+    const auto dummyBinaryFile = "dummy_mapped.bin"s;
+    constexpr auto expectedValue = 2137;
+    ::system(("touch " + dummyBinaryFile).c_str());
+    {
+        lidar_viewer::dev::BinaryFile binaryFile{dummyBinaryFile};
+        binaryFile.write(&expectedValue, sizeof(expectedValue), false);
+    }
+    {
+        std::remove_const_t<decltype(expectedValue)> returnedValue{};
+        lidar_viewer::dev::MappedBinaryFile mappedFile{dummyBinaryFile};
+        ASSERT_EQ(mappedFile.size(), sizeof(expectedValue));
+        ASSERT_EQ(sizeof(returnedValue), mappedFile.read(&returnedValue, sizeof(returnedValue), {}));
+        ASSERT_EQ(expectedValue, returnedValue);
+        ASSERT_EQ(mappedFile.position(), sizeof(expectedValue));
+        ASSERT_THROW(mappedFile.read(&returnedValue, sizeof(returnedValue), {}), std::runtime_error);
+
+        // short read at the end of file
+        mappedFile.seek(2u);
+        ASSERT_EQ(2u, mappedFile.read(&returnedValue, sizeof(returnedValue), {}));
+    }
+    ::system(("rm " + dummyBinaryFile).c_str());
+}
+
+TEST(MappedBinaryFileTest, TestMappedBinaryFileAdvisedRanges)
+{
+    using lidar_viewer::dev::MappedBinaryFile;
+    const auto dummyBinaryFile = "dummy_mapped.bin"s;
+    std::array<uint8_t, 10000u> expectedData{};
+    for(std::size_t i = 0u; i < expectedData.size(); ++i)
+    {
+        expectedData[i] = static_cast<uint8_t>(i * 7u);
+    }
+    ::system(("touch " + dummyBinaryFile).c_str());
+    {
+        lidar_viewer::dev::BinaryFile binaryFile{dummyBinaryFile};
+        binaryFile.write(expectedData.data(), expectedData.size(), false);
+    }
+    {
+        MappedBinaryFile mappedFile{dummyBinaryFile};
+        // ranges need not be page aligned and are clamped to the file
+        ASSERT_TRUE(mappedFile.advise(5000u, 100000u, MappedBinaryFile::Access::WillNeed));
+        ASSERT_TRUE(mappedFile.advise(123u, 4000u, MappedBinaryFile::Access::Sequential));
+        ASSERT_FALSE(mappedFile.advise(expectedData.size(), 1u, MappedBinaryFile::Access::WillNeed));
+
+        // advice does not change what is read
+        std::array<uint8_t, 10000u> returnedData{};
+        ASSERT_EQ(mappedFile.read(returnedData.data(), returnedData.size(), {}), returnedData.size());
+        ASSERT_EQ(returnedData, expectedData);
+    }
+    ::system(("rm " + dummyBinaryFile).c_str());
+}
+
+TEST(MappedBinaryFileTest, TestMappedBinaryFileFrameViews)
+{
+    using namespace lidar_viewer::dev;
+    const auto dummyBinaryFile = "dummy_mapped.bin"s;
+    Frame<4u> firstFrame{{0x02, 0x01, 0x03, 0x07}};
+    Frame<2u> secondFrame{{0x10, 0x00}};
+    ::system(("touch " + dummyBinaryFile).c_str());
+    {
+        IoStream output{};
+        output.createAndOpen<BinaryFile>(dummyBinaryFile);
+        write(firstFrame, output);
+        write(secondFrame, output);
+    }
+    {
+        MappedBinaryFile mappedFile{dummyBinaryFile};
+
+        const auto firstView = mappedFile.nextFrame();
+        ASSERT_EQ(firstView.size(), firstFrame.rawSize());
+        ASSERT_TRUE(std::equal(firstView.begin(), firstView.end(), firstFrame.raw()));
+        // view points straight into the mapping
+        ASSERT_EQ(firstView.data(), mappedFile.data().data());
+
+        const auto secondView = mappedFile.nextFrame();
+        ASSERT_EQ(secondView.size(), secondFrame.rawSize());
+        ASSERT_TRUE(std::equal(secondView.begin(), secondView.end(), secondFrame.raw()));
+
+        ASSERT_THROW((void)mappedFile.nextFrame(), std::runtime_error);
+
+        // no frame header at this position
+        mappedFile.seek(1u);
+        ASSERT_TRUE(mappedFile.nextFrame().empty());
+        ASSERT_EQ(mappedFile.position(), 1u);
+    }
+    {
+        // regular frame parsing works on top of the mapping as well
+        IoStream input{};
+        input.createAndOpen<MappedBinaryFile>(dummyBinaryFile);
+        Frame<4u> returnedFrame;
+        ASSERT_EQ(read(input, returnedFrame), Status::OK);
+        ASSERT_EQ(*returnedFrame.payload(), *firstFrame.payload());
+    }
+    ::system(("rm " + dummyBinaryFile).c_str());
+}
+
+} // namespace lidar_viewer::tests::units
@@ -3,12 +3,26 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+#include <chrono>
+#include <thread>
+
 namespace lidar_viewer::tests::units
 {
+
+namespace
+{
+
+/// stands for a stream read blocking until data arrives
+void blockLikeStreamRead()
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+}
+
+} // namespace
 // Mock class for PointCloudProvider
 class MockPointCloudProvider {
 public:
-    enum class Mode { Mode2D, Mode3D };
+    enum class Mode { Mode2D, Mode3D, Dual };
 
     MOCK_METHOD(void, readAndParse3dFrame, (), ());
     MOCK_METHOD(void, readAndParse2dFrame, (), ());
@@ -20,7 +34,10 @@ struct PointCloudReaderTest
     PointCloudReaderTest()
     : mockLidar{}
     , reader{mockLidar}
-    {}
+    {
+        ON_CALL(mockLidar, readAndParse3dFrame()).WillByDefault(blockLikeStreamRead);
+        ON_CALL(mockLidar, readAndParse2dFrame()).WillByDefault(blockLikeStreamRead);
+    }
 
     ~PointCloudReaderTest()
     {
@@ -54,14 +71,30 @@ TEST_F(PointCloudReaderTest, StartsAndCalls2DFrameParsing)
     reader.stop();
 }
 
+// Test: Ensures PointCloudReader rejects frames of both modes from a provider reading one mode at a time
+TEST_F(PointCloudReaderTest, RejectsDualModeWithoutStreamParsing)
+{
+    EXPECT_CALL(mockLidar, readAndParse3dFrame()).Times(0);
+    EXPECT_CALL(mockLidar, readAndParse2dFrame()).Times(0);
+
+    ASSERT_THROW(reader.start(MockPointCloudProvider::Mode::Dual), std::runtime_error);
+    reader.stop();
+}
+
 // Test: Ensures calling stop() multiple times does not cause issues
 TEST_F(PointCloudReaderTest, StopIsIdempotent)
 {
-    EXPECT_CALL(mockLidar, readAndParse3dFrame()).Times(3);
+    // every read blocks for 2ms, so 6ms leave room for 4 reads at most
+    EXPECT_CALL(mockLidar, readAndParse3dFrame()).Times(testing::Between(1, 4));
     reader.start(MockPointCloudProvider::Mode::Mode3D);
     std::this_thread::sleep_for(std::chrono::milliseconds(6));
     reader.stop();
+    testing::Mock::VerifyAndClearExpectations(&mockLidar);
+
+    // no read happens once stopped
+    EXPECT_CALL(mockLidar, readAndParse3dFrame()).Times(0);
     EXPECT_NO_THROW(reader.stop());  // Calling stop again should not cause issues
+    std::this_thread::sleep_for(std::chrono::milliseconds(6));
 }
 
 // Test: Handles exceptions in thread gracefully
@@ -74,4 +107,5 @@ TEST_F(PointCloudReaderTest, HandlesExceptionsGracefully)
     std::this_thread::sleep_for(std::chrono::milliseconds(10));
     reader.stop();
 }
+
 } // namespace lidar_viewer::tests::units
\ No newline at end of file
@@ -0,0 +1,380 @@
+#include "lidar_viewer/dev/RecordingReader.h"
+#include "lidar_viewer/dev/RecordingWriter.h"
+#include "lidar_viewer/dev/BinaryFile.h"
+#include "lidar_viewer/dev/CygLidarFrame.h"
+#include "lidar_viewer/dev/DepthPacking.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <memory>
+
+namespace lidar_viewer::tests::units
+{
+
+using namespace std::string_literals;
+using namespace std::chrono_literals;
+
+TEST(RecordingTest, WriterIsWriteOnly)
+{
+    const auto dummyRecording = "dummy_recording.bin"s;
+    {
+        int dummyValue{};
+        dev::RecordingWriter writer{dummyRecording};
+        ASSERT_THROW(writer.read(&dummyValue, sizeof(dummyValue), {}), std::runtime_error);
+    }
+    ::system(("rm " + dummyRecording).c_str());
+}
+
+TEST(RecordingTest, TimestampedFramesReadBack)
+{
+    using namespace lidar_viewer::dev;
+    const auto dummyRecording = "dummy_recording.bin"s;
+    Frame<4u> firstFrame{{0x02, 0x01, 0x03, 0x07}};
+    Frame<4u> secondFrame{{0x04, 0x05, 0x06, 0x08}};
+    {
+        RecordingWriter writer{dummyRecording};
+        writer.writeRecord(firstFrame.raw(), firstFrame.rawSize(), 100ms);
+        writer.writeRecord(secondFrame.raw(), secondFrame.rawSize(), 150ms);
+        // discarded, just like with BinaryFile
+        writer.write(secondFrame.raw(), secondFrame.rawSize(), true);
+    }
+    {
+        IoStream input{};
+        input.createAndOpen<RecordingReader>(dummyRecording, ReplayClock::unthrottled());
+
+        Frame<4u> returnedFrame;
+        ASSERT_EQ(read(input, returnedFrame), Status::OK);
+        ASSERT_EQ(*returnedFrame.payload(), *firstFrame.payload());
+        ASSERT_EQ(read(input, returnedFrame), Status::OK);
+        ASSERT_EQ(*returnedFrame.payload(), *secondFrame.payload());
+        ASSERT_THROW(read(input, returnedFrame), std::runtime_error);
+    }
+    {
+        RecordingReader reader{dummyRecording, ReplayClock::unthrottled()};
+        ASSERT_TRUE(reader.timestamped());
+        std::vector<uint8_t> rawFrames(firstFrame.rawSize() + 2u);
+        // read crossing records boundary
+        ASSERT_EQ(reader.read(rawFrames.data(), rawFrames.size(), {}), rawFrames.size());
+        ASSERT_EQ(reader.recordsRead(), 2u);
+        ASSERT_EQ(reader.captureTime(), 150ms);
+        ASSERT_TRUE(std::equal(firstFrame.raw(), firstFrame.raw() + firstFrame.rawSize(), rawFrames.begin()));
+    }
+    ::system(("rm " + dummyRecording).c_str());
+}
+
+TEST(RecordingTest, RealTimeReplayKeepsCadence)
+{
+    using namespace lidar_viewer::dev;
+    const auto dummyRecording = "dummy_recording.bin"s;
+    Frame<4u> frame{{0x02, 0x01, 0x03, 0x07}};
+    {
+        RecordingWriter writer{dummyRecording};
+        for(auto i = 0u; i < 4u; ++i)
+        {
+            writer.writeRecord(frame.raw(), frame.rawSize(), 10ms * i);
+        }
+    }
+    {
+        IoStream input{};
+        input.createAndOpen<RecordingReader>(dummyRecording, ReplayClock::realTime());
+        Frame<4u> returnedFrame;
+        const auto start = std::chrono::steady_clock::now();
+        for(auto i = 0u; i < 4u; ++i)
+        {
+            ASSERT_EQ(read(input, returnedFrame), Status::OK);
+        }
+        ASSERT_GE(std::chrono::steady_clock::now() - start, 30ms);
+    }
+    ::system(("rm " + dummyRecording).c_str());
+}
+
+TEST(RecordingTest, LegacyRecordingReadBack)
+{
+    using namespace lidar_viewer::dev;
+    const auto dummyRecording = "dummy_recording.bin"s;
+    Frame<4u> firstFrame{{0x02, 0x01, 0x03, 0x07}};
+    Frame<4u> secondFrame{{0x04, 0x05, 0x06, 0x08}};
+    constexpr std::array<uint8_t, 3> garbage{0x01u, 0x5au, 0x02u};
+    ::system(("touch " + dummyRecording).c_str());
+    {
+        IoStream output{};
+        output.createAndOpen<BinaryFile>(dummyRecording);
+        write(firstFrame, output);
+        output.write(garbage.data(), garbage.size());
+        write(secondFrame, output);
+    }
+    {
+        RecordingReader reader{dummyRecording, ReplayClock::unthrottled()};
+        ASSERT_FALSE(reader.timestamped());
+
+        IoStream input{};
+        input.createAndOpen<RecordingReader>(dummyRecording, ReplayClock::unthrottled());
+        Frame<4u> returnedFrame;
+        ASSERT_EQ(read(input, returnedFrame), Status::OK);
+        ASSERT_EQ(*returnedFrame.payload(), *firstFrame.payload());
+        std::array<uint8_t, 3> returnedGarbage{};
+        ASSERT_EQ(input.read(returnedGarbage.data(), returnedGarbage.size(), {}), garbage.size());
+        ASSERT_EQ(returnedGarbage, garbage);
+        ASSERT_EQ(read(input, returnedFrame), Status::OK);
+        ASSERT_EQ(*returnedFrame.payload(), *secondFrame.payload());
+    }
+    ::system(("rm " + dummyRecording).c_str());
+}
+
+TEST(RecordingTest, IndexedRandomAccess)
+{
+    using namespace lidar_viewer::dev;
+    const auto dummyRecording = "dummy_recording.bin"s;
+    constexpr auto frames = 10u;
+    {
+        RecordingWriter writer{dummyRecording};
+        for(auto i = 0u; i < frames; ++i)
+        {
+            Frame<4u> frame{{static_cast<uint8_t>(i), 0x01, 0x02, 0x03}};
+            writer.writeRecord(frame.raw(), frame.rawSize(), 10ms * i);
+        }
+        ASSERT_EQ(writer.recordsWritten(), frames);
+    }
+    RecordingReader reader{dummyRecording, ReplayClock::unthrottled()};
+    ASSERT_EQ(reader.frameCount(), frames);
+    const auto lastFrame = reader.frame(frames - 1u);
+    ASSERT_EQ(lastFrame.index, frames - 1u);
+    ASSERT_EQ(lastFrame.captureTime, 10ms * (frames - 1u));
+    ASSERT_EQ(lastFrame.data.size(), Frame<4u>{}.rawSize());
+    ASSERT_EQ(lastFrame.data[5u], frames - 1u);
+    ASSERT_THROW((void)reader.frame(frames), std::out_of_range);
+
+    // index is not replayed as a record
+    Frame<4u> returnedFrame;
+    reader.seek(frames - 1u);
+    ASSERT_EQ(reader.read(const_cast<uint8_t*>(returnedFrame.raw()), returnedFrame.rawSize(), {}), returnedFrame.rawSize());
+    ASSERT_EQ(returnedFrame.payload()->front(), frames - 1u);
+    ASSERT_THROW(reader.read(const_cast<uint8_t*>(returnedFrame.raw()), returnedFrame.rawSize(), {}), std::runtime_error);
+
+    // stepping forward and backward
+    reader.seek(4u);
+    ASSERT_EQ(reader.next().value().index, 4u);
+    ASSERT_EQ(reader.next().value().index, 5u);
+    ASSERT_EQ(reader.previous().value().index, 4u);
+    ASSERT_EQ(reader.previous().value().index, 3u);
+    ASSERT_EQ(reader.captureTime(), 30ms);
+    ASSERT_EQ(reader.read(const_cast<uint8_t*>(returnedFrame.raw()), returnedFrame.rawSize(), {}), returnedFrame.rawSize());
+    ASSERT_EQ(returnedFrame.payload()->front(), 4u);
+    reader.seek(0u);
+    ASSERT_FALSE(reader.previous().ok());
+    reader.seek(frames);
+    ASSERT_FALSE(reader.next().ok());
+    ::system(("rm " + dummyRecording).c_str());
+}
+
+TEST(RecordingTest, ChunksProcessedInParallel)
+{
+    using namespace lidar_viewer::dev;
+    const auto dummyRecording = "dummy_recording.bin"s;
+    constexpr auto frames = 25u;
+    {
+        RecordingWriter writer{dummyRecording};
+        for(auto i = 0u; i < frames; ++i)
+        {
+            Frame<4u> frame{{static_cast<uint8_t>(i), 0x01, 0x02, 0x03}};
+            writer.writeRecord(frame.raw(), frame.rawSize(), 10ms * i);
+        }
+    }
+    RecordingReader reader{dummyRecording, ReplayClock::unthrottled()};
+    std::array<std::atomic<unsigned int>, frames> visits{};
+    reader.forEachChunk(4u, [&visits](const RecordedFrame& frame)
+    {
+        ASSERT_EQ(frame.data[5u], frame.index);
+        ++visits[frame.index];
+    });
+    ASSERT_TRUE(std::all_of(visits.begin(), visits.end(), [](const auto& v){ return v == 1u; }));
+    ::system(("rm " + dummyRecording).c_str());
+}
+
+TEST(RecordingTest, IndexRebuiltForUnclosedRecording)
+{
+    using namespace lidar_viewer::dev;
+    const auto dummyRecording = "dummy_recording.bin"s;
+    Frame<4u> frame{{0x02, 0x01, 0x03, 0x07}};
+    {
+        RecordingWriter writer{dummyRecording};
+        for(auto i = 0u; i < 3u; ++i)
+        {
+            writer.writeRecord(frame.raw(), frame.rawSize(), 10ms * i);
+        }
+    }
+    // drop the index and a part of the last record, as if recorder was killed
+    ::system(("truncate -s -" + std::to_string(3u * sizeof(dev::recording::IndexEntry) + sizeof(dev::recording::IndexFooter) + 2u)
+              + " " + dummyRecording).c_str());
+    {
+        RecordingReader reader{dummyRecording, ReplayClock::unthrottled()};
+        ASSERT_EQ(reader.frameCount(), 2u);
+        ASSERT_EQ(reader.frame(1u).captureTime, 10ms);
+
+        IoStream input{};
+        input.createAndOpen<RecordingReader>(dummyRecording, ReplayClock::unthrottled());
+        Frame<4u> returnedFrame;
+        ASSERT_EQ(read(input, returnedFrame), Status::OK);
+        ASSERT_EQ(read(input, returnedFrame), Status::OK);
+        ASSERT_THROW(read(input, returnedFrame), std::runtime_error);
+    }
+    ::system(("rm " + dummyRecording).c_str());
+}
+
+TEST(RecordingTest, HeaderDescribesDevice)
+{
+    using namespace lidar_viewer::dev;
+    const auto dummyRecording = "dummy_recording.bin"s;
+    CygLidarD1::Config cfg{};
+    cfg.frequencyCh = 3u;
+    cfg.sensitivity = 42u;
+    {
+        RecordingWriter writer{dummyRecording, recording::makeRecordingInfo(cfg, CygLidarD1::Mode::Mode2D)};
+    }
+    RecordingReader reader{dummyRecording, ReplayClock::unthrottled()};
+    ASSERT_EQ(reader.frameCount(), 0u);
+    ASSERT_EQ(reader.info().mode, static_cast<uint8_t>(CygLidarD1::Mode::Mode2D));
+    ASSERT_EQ(reader.info().frequencyChannel, 3u);
+    ASSERT_EQ(reader.info().sensitivity, 42u);
+    ASSERT_EQ(reader.info().height, 1u);
+    ASSERT_EQ(reader.info().frameSize, CygLidarD1::FRAME_SIZE_2D);
+    ::system(("rm " + dummyRecording).c_str());
+}
+
+TEST(RecordingTest, LegacyRecordingRandomAccess)
+{
+    using namespace lidar_viewer::dev;
+    const auto dummyRecording = "dummy_recording.bin"s;
+    Frame<4u> firstFrame{{0x02, 0x01, 0x03, 0x07}};
+    Frame<4u> secondFrame{{0x04, 0x05, 0x06, 0x08}};
+    constexpr std::array<uint8_t, 3> garbage{0x01u, 0x5au, 0x02u};
+    ::system(("touch " + dummyRecording).c_str());
+    {
+        IoStream output{};
+        output.createAndOpen<BinaryFile>(dummyRecording);
+        write(firstFrame, output);
+        output.write(garbage.data(), garbage.size());
+        write(secondFrame, output);
+    }
+    {
+        RecordingReader reader{dummyRecording, ReplayClock::unthrottled()};
+        ASSERT_EQ(reader.frameCount(), 2u);
+        const auto recordedFrame = reader.frame(1u);
+        ASSERT_EQ(recordedFrame.captureTime, recording::legacyFramePeriod);
+        ASSERT_TRUE(std::equal(recordedFrame.data.begin(), recordedFrame.data.end(), secondFrame.raw()));
+
+        Frame<4u> returnedFrame;
+        reader.seek(1u);
+        ASSERT_EQ(reader.read(const_cast<uint8_t*>(returnedFrame.raw()), returnedFrame.rawSize(), {}), returnedFrame.rawSize());
+        ASSERT_EQ(*returnedFrame.payload(), *secondFrame.payload());
+    }
+    ::system(("rm " + dummyRecording).c_str());
+}
+
+TEST(RecordingTest, CompressedRecordingIsLossless)
+{
+    using namespace lidar_viewer::dev;
+    const auto dummyRecording = "dummy_recording.bin"s;
+    constexpr auto frames = 40u;
+    auto makeFrame = [](unsigned int i)
+    {
+        CygLidarD1::Frame3D::Payload payload{};
+        payload[0u] = 0x08u;
+        CygLidarD1::PointCloud3D depths{};
+        for(auto p = 0u; p < depths.size(); ++p)
+        {
+            depths[p] = static_cast<uint16_t>(1000u + p / 160u + ((p + i) % 50u == 0u ? i : 0u));
+        }
+        pack12(depths, std::span{payload}.subspan(1u));
+        return std::make_unique<CygLidarD1::Frame3D>(payload);
+    };
+    Frame<4u> frame2d{{0x02, 0x01, 0x03, 0x07}};
+    {
+        RecordingWriter writer{dummyRecording, {}, codec::CodecId::TemporalRvl};
+        for(auto i = 0u; i < frames; ++i)
+        {
+            const auto frame3d = makeFrame(i);
+            writer.writeRecord(frame3d->raw(), frame3d->rawSize(), 10ms * i);
+            if(i == 5u)
+            {
+                // records other than 3D frames are stored as they are
+                writer.writeRecord(frame2d.raw(), frame2d.rawSize(), 10ms * i + 1ms);
+            }
+        }
+    }
+    ASSERT_LT(std::filesystem::file_size(dummyRecording), frames * makeFrame(0u)->rawSize() / 4u);
+
+    RecordingReader reader{dummyRecording, ReplayClock::unthrottled()};
+    ASSERT_EQ(reader.frameCodec(), codec::CodecId::TemporalRvl);
+    ASSERT_EQ(reader.frameCount(), frames + 1u);
+
+    IoStream input{};
+    input.createAndOpen<RecordingReader>(dummyRecording, ReplayClock::unthrottled());
+    for(auto i = 0u; i < frames; ++i)
+    {
+        auto returnedFrame = std::make_unique<CygLidarD1::Frame3D>();
+        ASSERT_EQ(read(input, *returnedFrame), Status::OK);
+        ASSERT_EQ(*returnedFrame->payload(), *makeFrame(i)->payload());
+        if(i == 5u)
+        {
+            Frame<4u> returnedFrame2d;
+            ASSERT_EQ(read(input, returnedFrame2d), Status::OK);
+            ASSERT_EQ(*returnedFrame2d.payload(), *frame2d.payload());
+        }
+    }
+
+    // random access in between keyframes
+    const auto recordedFrame = reader.frame(37u);
+    const auto expectedFrame = makeFrame(36u);
+    ASSERT_TRUE(std::equal(recordedFrame.data.begin(), recordedFrame.data.end(), expectedFrame->raw()));
+    reader.seek(33u);
+    auto returnedFrame = std::make_unique<CygLidarD1::Frame3D>();
+    ASSERT_EQ(reader.read(const_cast<uint8_t*>(returnedFrame->raw()), returnedFrame->rawSize(), {}), returnedFrame->rawSize());
+    ASSERT_EQ(*returnedFrame->payload(), *makeFrame(32u)->payload());
+    ASSERT_EQ(reader.previous().value().data[5u], 0x08u);
+
+    std::atomic<unsigned int> matching{0u};
+    reader.forEachChunk(3u, [&matching, &makeFrame](const RecordedFrame& recorded)
+    {
+        if(recorded.index == 6u)
+        {
+            return ;
+        }
+        const auto expected = makeFrame(recorded.index < 6u ? recorded.index : recorded.index - 1u);
+        if(std::equal(recorded.data.begin(), recorded.data.end(), expected->raw()))
+        {
+            ++matching;
+        }
+    });
+    ASSERT_EQ(matching, frames);
+
+    // stepping through keyframes and the frames in between them
+    const auto expectedAt = [&makeFrame](std::size_t index)
+    {
+        return makeFrame(index < 6u ? index : index - 1u);
+    };
+    reader.seek(0u);
+    for(auto i = 0u; i <= frames; ++i)
+    {
+        const auto stepped = reader.next();
+        ASSERT_TRUE(stepped.ok());
+        ASSERT_EQ(stepped.value().index, i);
+        if(i != 6u)
+        {
+            ASSERT_TRUE(std::equal(stepped.value().data.begin(), stepped.value().data.end(), expectedAt(i)->raw())) << i;
+        }
+    }
+    ASSERT_FALSE(reader.next().ok());
+    reader.seek(40u);
+    reader.seek(41u);
+    ASSERT_EQ(reader.previous().value().index, 39u);
+    const auto stepped = reader.next();
+    ASSERT_EQ(stepped.value().index, 40u);
+    ASSERT_TRUE(std::equal(stepped.value().data.begin(), stepped.value().data.end(), expectedAt(40u)->raw()));
+    ::system(("rm " + dummyRecording).c_str());
+}
+
+} // namespace lidar_viewer::tests::units
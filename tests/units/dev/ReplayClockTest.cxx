@@ -0,0 +1,60 @@
+#include "lidar_viewer/dev/ReplayClock.h"
+
+#include <gtest/gtest.h>
+
+namespace lidar_viewer::tests::units
+{
+
+using namespace std::chrono_literals;
+
+namespace
+{
+
+std::chrono::steady_clock::duration replay(dev::ReplayClock& clock, std::chrono::nanoseconds period, unsigned int frames)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for(auto i = 0u; i < frames; ++i)
+    {
+        clock.waitFor(1h + period * i);
+    }
+    return std::chrono::steady_clock::now() - start;
+}
+
+}
+
+TEST(ReplayClockTest, RealTimeKeepsOriginalCadence)
+{
+    auto clock = dev::ReplayClock::realTime();
+    ASSERT_TRUE(clock.throttled());
+    ASSERT_GE(replay(clock, 10ms, 4), 30ms);
+}
+
+TEST(ReplayClockTest, ScaledReplayIsFaster)
+{
+    dev::ReplayClock clock{4.};
+    ASSERT_DOUBLE_EQ(clock.speed(), 4.);
+    const auto elapsed = replay(clock, 40ms, 3);
+    ASSERT_GE(elapsed, 20ms);
+    ASSERT_LT(elapsed, 80ms);
+}
+
+TEST(ReplayClockTest, UnthrottledNeverWaits)
+{
+    auto clock = dev::ReplayClock::unthrottled();
+    ASSERT_FALSE(clock.throttled());
+    ASSERT_LT(replay(clock, 1s, 5), 500ms);
+    ASSERT_FALSE(dev::ReplayClock{-1.}.throttled());
+}
+
+TEST(ReplayClockTest, ResetStartsNewTimeline)
+{
+    auto clock = dev::ReplayClock::realTime();
+    clock.waitFor(0ns);
+    clock.reset();
+    const auto start = std::chrono::steady_clock::now();
+    // would wait for an hour without reset
+    clock.waitFor(1h);
+    ASSERT_LT(std::chrono::steady_clock::now() - start, 500ms);
+}
+
+} // namespace lidar_viewer::tests::units
@@ -0,0 +1,65 @@
+#include "lidar_viewer/dev/RingBuffer.h"
+
+#include <gtest/gtest.h>
+
+#include <numeric>
+
+namespace lidar_viewer::tests::units
+{
+
+TEST(RingBufferTest, CapacityRoundedToPowerOfTwo)
+{
+    dev::RingBuffer ringBuffer{100u};
+    ASSERT_EQ(ringBuffer.capacity(), 128u);
+    ASSERT_TRUE(ringBuffer.empty());
+    ASSERT_EQ(ringBuffer.freeSpace(), 128u);
+}
+
+TEST(RingBufferTest, WrapsAround)
+{
+    dev::RingBuffer ringBuffer{8u};
+    std::array<uint8_t, 6u> in{};
+    std::iota(in.begin(), in.end(), 1u);
+    std::array<uint8_t, 6u> out{};
+
+    ASSERT_EQ(ringBuffer.write(in.data(), in.size()), in.size());
+    ASSERT_EQ(ringBuffer.read(out.data(), 4u), 4u);
+    ASSERT_EQ(ringBuffer.size(), 2u);
+
+    // second write wraps, only free space is taken
+    ASSERT_EQ(ringBuffer.write(in.data(), in.size()), in.size());
+    ASSERT_EQ(ringBuffer.write(in.data(), in.size()), 0u);
+    const auto readable = ringBuffer.readableRegions();
+    ASSERT_EQ(readable[0u].size() + readable[1u].size(), 8u);
+    ASSERT_FALSE(readable[1u].empty());
+
+    std::array<uint8_t, 8u> all{};
+    ASSERT_EQ(ringBuffer.read(all.data(), all.size()), all.size());
+    ASSERT_EQ(all, (std::array<uint8_t, 8u>{5u, 6u, 1u, 2u, 3u, 4u, 5u, 6u}));
+    ASSERT_TRUE(ringBuffer.empty());
+}
+
+TEST(RingBufferTest, FilledThroughWritableRegions)
+{
+    dev::RingBuffer ringBuffer{8u};
+    std::array<uint8_t, 6u> scratch{};
+    ringBuffer.write(scratch.data(), scratch.size());
+    ringBuffer.consume(5u);
+
+    auto regions = ringBuffer.writableRegions();
+    ASSERT_EQ(regions[0u].size(), 2u);
+    ASSERT_EQ(regions[1u].size(), 5u);
+    regions[0u][0u] = 0xaau;
+    regions[0u][1u] = 0xbbu;
+    regions[1u][0u] = 0xccu;
+    ringBuffer.commit(3u);
+
+    std::array<uint8_t, 4u> out{};
+    ASSERT_EQ(ringBuffer.read(out.data(), out.size()), 4u);
+    ASSERT_EQ(out, (std::array<uint8_t, 4u>{0u, 0xaau, 0xbbu, 0xccu}));
+    ringBuffer.write(scratch.data(), scratch.size());
+    ringBuffer.clear();
+    ASSERT_TRUE(ringBuffer.empty());
+}
+
+} // namespace lidar_viewer::tests::units
@@ -0,0 +1,95 @@
+#include "lidar_viewer/dev/SensorDescriptor.h"
+#include "lidar_viewer/dev/CygLidarD1.h"
+#include "lidar_viewer/dev/DepthPacking.h"
+#include "lidar_viewer/dev/IoStreamBase.h"
+#include "lidar_viewer/geometry/functions/GetDepthImageToPointCloudProcessor.h"
+#include "lidar_viewer/geometry/types/ScreenRanges.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+namespace lidar_viewer::tests::units
+{
+
+namespace
+{
+
+/// sensor of 4 times the pixels of CygLidar D1
+using Sensor4x = dev::SensorDescriptor<320u, 120u, 320u, 12u, 120u, 65u>;
+
+struct NullStream
+        : dev::IoStreamBase
+{
+    void open() override {}
+    unsigned int read(void*, unsigned int, const std::chrono::milliseconds) const override { return 0u; }
+    void write(const void*, unsigned int, bool) const override {}
+    void close() const override {}
+};
+
+/// depths of a slanted wall
+template <typename Sensor>
+std::vector<uint16_t> wall()
+{
+    std::vector<uint16_t> depths(Sensor::DEPTHS_3D);
+    for(std::size_t i = 0u; i < depths.size(); ++i)
+    {
+        depths[i] = static_cast<uint16_t>(40u + (i % Sensor::WIDTH_3D) * 7u % 3100u + i / Sensor::WIDTH_3D);
+    }
+    return depths;
+}
+
+template <typename Lidar>
+std::vector<uint8_t> raw3dFrame(const std::vector<uint16_t>& depths)
+{
+    auto payload = std::make_unique<typename Lidar::Frame3D::Payload>();
+    (*payload)[0u] = static_cast<uint8_t>(Lidar::Mode::Mode3D);
+    dev::pack12(depths, std::span{*payload}.subspan(1u));
+    const auto frame = std::make_unique<typename Lidar::Frame3D>(*payload);
+    return {frame->raw(), frame->raw() + frame->rawSize()};
+}
+
+} // namespace
+
+TEST(SensorDescriptorTest, CygLidarD1Sizes)
+{
+    using Sensor = dev::CygLidarD1Sensor;
+    static_assert(Sensor::FRAME_SIZE_3D == 14401u);
+    static_assert(Sensor::FRAME_SIZE_2D == 323u);
+    static_assert(Sensor::DEPTHS_3D == 9600u);
+    static_assert(std::tuple_size_v<dev::CygLidarD1::PointCloud3D> == Sensor::DEPTHS_3D);
+    static_assert(std::tuple_size_v<dev::CygLidarD1::PointCloud2D> == Sensor::DEPTHS_2D);
+
+    constexpr auto attributes = geometry::types::sensorDepthFrameAttributes<Sensor>({51u, 3000u});
+    ASSERT_EQ(attributes.frameResolution, (geometry::types::UintRange{160u, 60u}));
+    ASSERT_FLOAT_EQ(attributes.rotationX, 60.f);
+    ASSERT_FLOAT_EQ(attributes.rotationY, 32.5f);
+}
+
+TEST(SensorDescriptorTest, HigherResolutionLidarParsesFrames)
+{
+    using Lidar = dev::BasicCygLidar<Sensor4x>;
+    static_assert(Lidar::FRAME_SIZE_3D == 57601u);
+    dev::IoStream ioStream{std::make_unique<NullStream>()};
+    Lidar lidar{ioStream};
+
+    const auto depths = wall<Sensor4x>();
+    lidar.feed(raw3dFrame<Lidar>(depths));
+
+    const auto pointCloud = lidar.latest3dPointCloud();
+    ASSERT_EQ(pointCloud->stamp.sequence, 1u);
+    ASSERT_TRUE(std::equal(depths.begin(), depths.end(), pointCloud->begin()));
+    uint32_t valid{0u};
+    for(std::size_t i = 0u; i < depths.size(); ++i)
+    {
+        const auto inRange = depths[i] >= Lidar::DEPTH_RANGE_3D.first && depths[i] <= Lidar::DEPTH_RANGE_3D.second;
+        ASSERT_EQ(pointCloud->validity.valid(i), inRange) << i;
+        valid += inRange;
+    }
+    ASSERT_EQ(pointCloud->validity.counts.valid, valid);
+}
+
+} // namespace lidar_viewer::tests::units
@@ -0,0 +1,102 @@
+#include "lidar_viewer/dev/SerialPort.h"
+#include "lidar_viewer/dev/CygLidarFrame.h"
+
+#include <gtest/gtest.h>
+
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <vector>
+
+namespace lidar_viewer::tests::units
+{
+
+namespace
+{
+
+/// pseudo terminal standing in for the lidar
+class PseudoTerminal
+{
+public:
+    PseudoTerminal()
+    : master{::posix_openpt(O_RDWR | O_NOCTTY)}
+    {
+        if(master < 0 || ::grantpt(master) != 0 || ::unlockpt(master) != 0)
+        {
+            throw std::runtime_error{"Unable to open a pseudo terminal"};
+        }
+    }
+
+    ~PseudoTerminal() noexcept
+    {
+        ::close(master);
+    }
+
+    [[nodiscard]] std::string slaveName() const
+    {
+        return ::ptsname(master);
+    }
+
+    void write(const void* ptr, std::size_t size) const
+    {
+        ASSERT_EQ(::write(master, ptr, size), static_cast<ssize_t>(size));
+    }
+
+private:
+    int master;
+};
+
+} // namespace
+
+TEST(SerialPortTest, FramesServedFromBuffer)
+{
+    using namespace std::chrono_literals;
+    constexpr auto frames = 10u;
+    PseudoTerminal terminal{};
+    auto serialPort = std::make_unique<dev::SerialPort>(terminal.slaveName(), B3000000);
+    const auto& port = *serialPort;
+    dev::IoStream ioStream{std::move(serialPort)};
+
+    std::vector<uint8_t> burst;
+    for(auto i = 0u; i < frames; ++i)
+    {
+        dev::Frame<4u> frame{{static_cast<uint8_t>(i), 0x01, 0x02, 0x03}};
+        burst.insert(burst.end(), frame.raw(), frame.raw() + frame.rawSize());
+    }
+    terminal.write(burst.data(), burst.size());
+
+    for(auto i = 0u; i < frames; ++i)
+    {
+        dev::Frame<4u> returnedFrame;
+        ASSERT_EQ(read(ioStream, returnedFrame), dev::Status::OK);
+        ASSERT_EQ(returnedFrame.payload()->front(), i);
+    }
+    // three reads per frame are served by a handful of syscalls
+    const auto statistics = port.statistics();
+    ASSERT_EQ(statistics.bytesRead, burst.size());
+    ASSERT_LE(statistics.reads, 3u);
+    ASSERT_EQ(statistics.polls, statistics.reads);
+
+    // nothing left, read times out
+    std::array<uint8_t, 3u> header{};
+    ASSERT_EQ(ioStream.read(header.data(), header.size(), 1ms), 0u);
+}
+
+TEST(SerialPortTest, PartialDataCompletedByNextPoll)
+{
+    using namespace std::chrono_literals;
+    PseudoTerminal terminal{};
+    dev::SerialPort serialPort{terminal.slaveName(), B3000000};
+
+    const std::array<uint8_t, 6u> data{1u, 2u, 3u, 4u, 5u, 6u};
+    terminal.write(data.data(), 2u);
+    std::array<uint8_t, 6u> returned{};
+    ASSERT_EQ(serialPort.read(returned.data(), returned.size(), 10ms), 2u);
+    terminal.write(data.data() + 2u, 4u);
+    ASSERT_EQ(serialPort.read(returned.data() + 2u, 4u, 10ms), 4u);
+    ASSERT_EQ(returned, data);
+}
+
+} // namespace lidar_viewer::tests::units
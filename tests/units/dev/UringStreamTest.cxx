@@ -0,0 +1,144 @@
+#include "lidar_viewer/dev/UringStream.h"
+#include "lidar_viewer/dev/CygLidarFrame.h"
+#include "lidar_viewer/dev/IoStream.h"
+
+#include <gtest/gtest.h>
+
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <vector>
+
+namespace lidar_viewer::tests::units
+{
+
+namespace
+{
+
+/// pseudo terminal standing in for the lidar
+class PseudoTerminal
+{
+public:
+    PseudoTerminal()
+    : master{::posix_openpt(O_RDWR | O_NOCTTY)}
+    {
+        if(master < 0 || ::grantpt(master) != 0 || ::unlockpt(master) != 0)
+        {
+            throw std::runtime_error{"Unable to open a pseudo terminal"};
+        }
+    }
+
+    ~PseudoTerminal() noexcept
+    {
+        ::close(master);
+    }
+
+    [[nodiscard]] std::string slaveName() const
+    {
+        return ::ptsname(master);
+    }
+
+    void write(const void* ptr, std::size_t size) const
+    {
+        ASSERT_EQ(::write(master, ptr, size), static_cast<ssize_t>(size));
+    }
+
+private:
+    int master;
+};
+
+} // namespace
+
+TEST(UringStreamTest, FramesReadFromSerialPort)
+{
+    using namespace std::chrono_literals;
+    constexpr auto frames = 10u;
+    PseudoTerminal terminal{};
+    auto uringStream = std::make_unique<dev::UringStream>(terminal.slaveName(), B3000000);
+    const auto& stream = *uringStream;
+    ASSERT_EQ(stream.usingUring(), dev::UringStream::available());
+    dev::IoStream ioStream{std::move(uringStream)};
+
+    std::vector<uint8_t> burst;
+    for(auto i = 0u; i < frames; ++i)
+    {
+        dev::Frame<4u> frame{{static_cast<uint8_t>(i), 0x01, 0x02, 0x03}};
+        burst.insert(burst.end(), frame.raw(), frame.raw() + frame.rawSize());
+    }
+    terminal.write(burst.data(), burst.size());
+
+    for(auto i = 0u; i < frames; ++i)
+    {
+        dev::Frame<4u> returnedFrame;
+        ASSERT_EQ(read(ioStream, returnedFrame), dev::Status::OK);
+        ASSERT_EQ(returnedFrame.payload()->front(), i);
+    }
+    if(!stream.usingUring())
+    {
+        GTEST_SKIP() << "io_uring not available";
+    }
+    const auto statistics = stream.statistics();
+    ASSERT_EQ(statistics.bytesRead, burst.size());
+    // the burst is picked up by the queued read, thirty reads of the frames cost a few syscalls
+    ASSERT_LE(statistics.enters, 4u);
+    ASSERT_GE(statistics.submissions, statistics.completions);
+}
+
+TEST(UringStreamTest, ReadSomeTimesOut)
+{
+    using namespace std::chrono_literals;
+    PseudoTerminal terminal{};
+    dev::UringStream stream{terminal.slaveName(), B3000000};
+    std::array<uint8_t, 16u> data{};
+
+    ASSERT_EQ(stream.readSome(data.data(), data.size(), 10ms), 0u);
+
+    const std::array<uint8_t, 3u> sent{0x01u, 0x02u, 0x03u};
+    terminal.write(sent.data(), sent.size());
+    ASSERT_EQ(stream.readSome(data.data(), data.size(), 100ms), sent.size());
+    ASSERT_TRUE(std::equal(sent.begin(), sent.end(), data.begin()));
+}
+
+TEST(UringStreamTest, FileReadUntilEof)
+{
+    using namespace std::chrono_literals;
+    const std::string fileName{"uring_stream_test.bin"};
+    std::vector<uint8_t> content(3u * dev::UringStream::BUFFER_SIZE + 1234u);
+    for(auto i = 0u; i < content.size(); ++i)
+    {
+        content[i] = static_cast<uint8_t>(i * 7u);
+    }
+    {
+        std::ofstream file{fileName, std::ios::binary};
+        file.write(reinterpret_cast<const char*>(content.data()), static_cast<std::streamsize>(content.size()));
+    }
+
+    {
+        dev::UringStream stream{fileName};
+        std::vector<uint8_t> returned(content.size());
+        constexpr auto chunk = 1000u;
+        for(std::size_t position = 0u; position < returned.size(); )
+        {
+            const auto size = static_cast<unsigned int>(std::min<std::size_t>(chunk, returned.size() - position));
+            const auto readBytes = stream.read(returned.data() + position, size, 100ms);
+            ASSERT_EQ(readBytes, size);
+            position += readBytes;
+        }
+        ASSERT_EQ(returned, content);
+        ASSERT_THROW(stream.read(returned.data(), chunk, 100ms), std::runtime_error);
+
+        if(stream.usingUring())
+        {
+            const auto statistics = stream.statistics();
+            ASSERT_EQ(statistics.bytesRead, content.size());
+            ASSERT_LT(statistics.enters, content.size() / chunk);
+        }
+    }
+    std::remove(fileName.c_str());
+}
+
+} // namespace lidar_viewer::tests::units
@@ -0,0 +1,247 @@
+#include "lidar_viewer/geometry/functions/GetDepthImageToPointCloudProcessor.h"
+#include "lidar_viewer/geometry/types/Point.h"
+#include "lidar_viewer/geometry/types/PointCloud.h"
+#include "lidar_viewer/geometry/types/PointCloudSoA.h"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+namespace
+{
+
+/// allocations made by the current thread while counting
+thread_local bool countAllocations{false};
+thread_local std::size_t allocations{0u};
+
+void* allocate(std::size_t size, std::size_t alignment)
+{
+    if(countAllocations)
+    {
+        ++allocations;
+    }
+    size = size == 0u ? 1u : size;
+    void* ptr = alignment <= alignof(std::max_align_t)
+            ? std::malloc(size)
+            : std::aligned_alloc(alignment, (size + alignment - 1u) / alignment * alignment);
+    if(!ptr)
+    {
+        throw std::bad_alloc{};
+    }
+    return ptr;
+}
+
+/// counts the allocations made by the code under test
+class AllocationCounter
+{
+public:
+    AllocationCounter() noexcept
+    {
+        allocations = 0u;
+        countAllocations = true;
+    }
+
+    ~AllocationCounter() noexcept
+    {
+        countAllocations = false;
+    }
+
+    [[nodiscard]] std::size_t count() const noexcept
+    {
+        return allocations;
+    }
+};
+
+} // namespace
+
+void* operator new(std::size_t size)
+{
+    return allocate(size, alignof(std::max_align_t));
+}
+
+void* operator new[](std::size_t size)
+{
+    return allocate(size, alignof(std::max_align_t));
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    return allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept
+{
+    std::free(ptr);
+}
+
+namespace lidar_viewer::tests::units
+{
+
+using namespace geometry::types;
+using namespace geometry::functions;
+
+namespace
+{
+
+/// depth image of the resolution of the sensor, carrying a validity mask the way classified lidar point clouds do
+struct MaskedFrame
+    : std::array<uint16_t, 160u * 60u>
+{
+    struct
+    {
+        std::array<uint64_t, 160u * 60u / 64u> mask{};
+    } validity;
+};
+
+constexpr DepthFrameAttributes depthAttributes{{160u, 60u}, {51u, 3000u}, 60.0f, 32.5f};
+
+MaskedFrame makeFrame(uint16_t shift)
+{
+    MaskedFrame frame{};
+    for(std::size_t i = 0u; i < frame.size(); ++i)
+    {
+        frame[i] = static_cast<uint16_t>((i * 7u + shift) % 3100u);
+        if(i % 5u != 0u)
+        {
+            frame.validity.mask[i / 64u] |= uint64_t{1u} << (i % 64u);
+        }
+    }
+    return frame;
+}
+
+} // namespace
+
+TEST(DepthImageConversionAllocationTest, ReusedPointCloudNotReallocated)
+{
+    ScreenRangeGl screenRange;
+    const auto processor = getDepthImageToPointCloudProcessor<MaskedFrame>(depthAttributes, screenRange);
+    const std::array frames{makeFrame(0u), makeFrame(1000u), makeFrame(2000u)};
+
+    PointCloud3D<float> pointCloud;
+    processor(frames[0u], pointCloud);
+
+    AllocationCounter counter;
+    for(auto i = 0u; i < 30u; ++i)
+    {
+        pointCloud.clear();
+        processor(frames[i % frames.size()], pointCloud);
+    }
+    EXPECT_EQ(counter.count(), 0u);
+    EXPECT_FALSE(pointCloud.empty());
+}
+
+TEST(DepthImageConversionAllocationTest, ReusedPointCloudSoANotReallocated)
+{
+    ScreenRangeGl screenRange;
+    const auto processor = getDepthImageToPointCloudProcessor<MaskedFrame, PointCloud3DSoA<float>>(
+            depthAttributes, screenRange);
+    const std::array frames{makeFrame(0u), makeFrame(1000u), makeFrame(2000u)};
+
+    PointCloud3DSoA<float> pointCloud;
+    processor(frames[0u], pointCloud);
+
+    AllocationCounter counter;
+    for(auto i = 0u; i < 30u; ++i)
+    {
+        pointCloud.clear();
+        processor(frames[i % frames.size()], pointCloud);
+    }
+    EXPECT_EQ(counter.count(), 0u);
+    EXPECT_FALSE(pointCloud.empty());
+}
+
+TEST(DepthImageConversionAllocationTest, FirstFrameReservedOnce)
+{
+    ScreenRangeGl screenRange;
+    const auto rays = depthRays(depthAttributes, screenRange);
+    const auto frame = makeFrame(0u);
+
+    PointCloud3D<float> pointCloud;
+    AllocationCounter counter;
+    depthImageToPointCloud(frame, *rays, pointCloud);
+    EXPECT_EQ(counter.count(), 1u);
+}
+
+TEST(DepthImageConversionAllocationTest, BufferFilledWithoutAllocating)
+{
+    ScreenRangeGl screenRange;
+    const auto rays = depthRays(depthAttributes, screenRange);
+    const auto frame = makeFrame(500u);
+    std::vector<Point3D<float>> buffer(frame.size());
+
+    std::size_t count{0u};
+    {
+        AllocationCounter counter;
+        count = depthImageToPointCloud(frame, *rays, std::span{buffer});
+        EXPECT_EQ(counter.count(), 0u);
+    }
+
+    PointCloud3D<float> expected;
+    depthImageToPointCloud(frame, *rays, expected);
+    ASSERT_EQ(count, expected.size());
+    for(std::size_t i = 0u; i < count; ++i)
+    {
+        for(auto axis = 0u; axis < 3u; ++axis)
+        {
+            EXPECT_FLOAT_EQ(buffer[i][axis], expected[i][axis]);
+        }
+    }
+}
+
+TEST(DepthImageConversionAllocationTest, BufferTooSmallRejected)
+{
+    ScreenRangeGl screenRange;
+    const auto rays = depthRays(depthAttributes, screenRange);
+    std::vector<Point3D<float>> buffer(100u);
+
+    EXPECT_THROW(std::ignore = depthImageToPointCloud(makeFrame(0u), *rays, std::span{buffer}), std::runtime_error);
+}
+
+} // namespace lidar_viewer::tests::units
@@ -1,7 +1,10 @@
 #include "lidar_viewer/geometry/functions/GetDepthImageToPointCloudProcessor.h"
+#include "lidar_viewer/geometry/functions/GetParallelDepthImageToPointCloudProcessor.h"
 #include "lidar_viewer/geometry/types/Box.h"
 #include "lidar_viewer/geometry/types/Point.h"
 #include "lidar_viewer/geometry/types/PointCloud.h"
+#include "lidar_viewer/geometry/types/PointCloudSoA.h"
+#include "lidar_viewer/geometry/types/WorkerPool.h"
 
 #include <gtest/gtest.h>
 
@@ -131,4 +134,201 @@ TEST(GetDepthImageToPointCloudProcessorTest, LargeDepthFrameTest)
     EXPECT_EQ(pointCloud.size(), 1000000);
 }
 
-} // namespace lidar_viewer::tests::units
\ No newline at end of file
+TEST(GetDepthImageToPointCloudProcessorTest, MaskedFrameVisitsValidDepthsOnly)
+{
+    // frame carrying a validity mask the way classified lidar point clouds do
+    struct MaskedFrame
+        : std::vector<float>
+    {
+        struct
+        {
+            std::array<uint64_t, 1u> mask{};
+        } validity;
+    };
+
+    DepthFrameAttributes depthAttributes{{5, 5},
+                                         {0.0f, 25.0f},
+                                         45.0f,
+                                         45.0f};
+    ScreenRangeDummy screenRange;
+
+    MaskedFrame frame3d{};
+    std::vector<float> expectedFrame(25u, 30.0f);
+    frame3d.assign(25u, 20.0f);
+    for(const auto index : {0u, 7u, 13u, 24u})
+    {
+        frame3d.validity.mask[0u] |= uint64_t{1u} << index;
+        expectedFrame[index] = frame3d[index];
+    }
+    // masked out depth within range stays omitted, bits past the frame are ignored
+    frame3d.validity.mask[0u] |= uint64_t{1u} << 40u;
+
+    PointCloud3D<float> pointCloud;
+    getDepthImageToPointCloudProcessor<MaskedFrame>(depthAttributes, screenRange)(frame3d, pointCloud);
+    PointCloud3D<float> expected;
+    getDepthImageToPointCloudProcessor<std::vector<float>>(depthAttributes, screenRange)(expectedFrame, expected);
+
+    ASSERT_EQ(pointCloud.size(), 4u);
+    ASSERT_EQ(pointCloud.size(), expected.size());
+    for(auto i = 0u; i < pointCloud.size(); ++i)
+    {
+        for(auto axis = 0u; axis < 3u; ++axis)
+        {
+            EXPECT_FLOAT_EQ(pointCloud[i][axis], expected[i][axis]);
+        }
+    }
+}
+
+TEST(GetDepthImageToPointCloudProcessorTest, RaysMatchTrigonometricConversion)
+{
+    DepthFrameAttributes depthAttributes{{8, 6},
+                                         {10u, 300u},
+                                         60.0f,
+                                         20.0f};
+    ScreenRangeGl screenRange;
+
+    std::vector<float> frame3d(48u);
+    for(auto i = 0u; i < frame3d.size(); ++i)
+    {
+        frame3d[i] = 10.0f + static_cast<float>(i) * 6.0f;
+    }
+
+    PointCloud3D<float> pointCloud;
+    getDepthImageToPointCloudProcessor<std::vector<float>>(depthAttributes, screenRange)(frame3d, pointCloud);
+
+    ASSERT_EQ(pointCloud.size(), frame3d.size());
+    const auto scalarX = 2.0f / 8.0f;
+    const auto scalarY = -2.0f / 6.0f;
+    const auto scalarZ = -1.0f / 290.0f;
+    for(auto y = 0u; y < 6u; ++y)
+    {
+        for(auto x = 0u; x < 8u; ++x)
+        {
+            const auto index = y * 8u + x;
+            const auto depth = mapValue(10.0f, 1.0f, scalarZ, frame3d[index]);
+            const auto rotationX = mapValue(.0f, 1.0f, scalarY, static_cast<float>(y)) * 20.0f * M_PIf / 180.f;
+            const auto rotationY = mapValue(.0f, -1.0f, scalarX, static_cast<float>(x)) * 60.0f * M_PIf / 180.f;
+            const auto expected = sphericalToEuclidean(depth, rotationX, rotationY);
+            for(auto axis = 0u; axis < 3u; ++axis)
+            {
+                EXPECT_NEAR(pointCloud[index][axis], expected[axis], 1e-6f);
+            }
+        }
+    }
+}
+
+TEST(GetDepthImageToPointCloudProcessorTest, RaysSharedAcrossProcessors)
+{
+    DepthFrameAttributes depthAttributes{{7, 3},
+                                         {0u, 25u},
+                                         45.0f,
+                                         45.0f};
+    ScreenRangeDummy screenRange;
+    ScreenRangeGl screenRangeGl;
+
+    const auto rays = depthRays(depthAttributes, screenRange);
+    EXPECT_EQ(rays, depthRays(depthAttributes, screenRange));
+    EXPECT_EQ(rays->x.size(), 21u);
+
+    // other screen ranges or attributes get rays of their own
+    EXPECT_NE(rays, depthRays(depthAttributes, screenRangeGl));
+    DepthFrameAttributes rotated{{7, 3},
+                                 {0u, 25u},
+                                 30.0f,
+                                 45.0f};
+    EXPECT_NE(rays, depthRays(rotated, screenRange));
+}
+
+TEST(GetDepthImageToPointCloudProcessorTest, ParallelConversionMatchesSequential)
+{
+    // frame carrying a validity mask the way classified lidar point clouds do
+    struct MaskedFrame
+        : std::vector<uint16_t>
+    {
+        struct
+        {
+            std::array<uint64_t, 160u * 61u / 64u + 1u> mask{};
+        } validity;
+    };
+
+    // rows not split evenly between the tiles
+    DepthFrameAttributes depthAttributes{{160u, 61u},
+                                         {51u, 3000u},
+                                         60.0f,
+                                         32.5f};
+    ScreenRangeGl screenRange;
+    WorkerPool pool{4u};
+
+    MaskedFrame frame3d{};
+    for(auto i = 0u; i < 160u * 61u; ++i)
+    {
+        frame3d.push_back(static_cast<uint16_t>((i * 13u) % 3200u));
+        if(i % 3u != 0u)
+        {
+            frame3d.validity.mask[i / 64u] |= uint64_t{1u} << (i % 64u);
+        }
+    }
+    const std::vector<uint16_t> plainFrame{frame3d.begin(), frame3d.end()};
+
+    const auto expectEqual = [](const auto& pointCloud, const auto& expected)
+    {
+        ASSERT_EQ(pointCloud.size(), expected.size());
+        for(auto i = 0u; i < pointCloud.size(); ++i)
+        {
+            for(auto axis = 0u; axis < 3u; ++axis)
+            {
+                ASSERT_EQ(pointCloud[i][axis], expected[i][axis]);
+            }
+        }
+    };
+
+    for(const auto tiles : {1u, 3u, 4u, 7u, 61u, 100u})
+    {
+        PointCloud3D<float> expected;
+        getDepthImageToPointCloudProcessor<MaskedFrame>(depthAttributes, screenRange)(frame3d, expected);
+        PointCloud3D<float> pointCloud;
+        getParallelDepthImageToPointCloudProcessor<MaskedFrame>(depthAttributes, screenRange, pool, tiles)(
+                frame3d, pointCloud);
+        expectEqual(pointCloud, expected);
+
+        PointCloud3D<float> expectedPlain;
+        getDepthImageToPointCloudProcessor<std::vector<uint16_t>>(depthAttributes, screenRange)(
+                plainFrame, expectedPlain);
+        PointCloud3D<float> pointCloudPlain;
+        getParallelDepthImageToPointCloudProcessor<std::vector<uint16_t>>(depthAttributes, screenRange, pool, tiles)(
+                plainFrame, pointCloudPlain);
+        expectEqual(pointCloudPlain, expectedPlain);
+
+        PointCloud3DSoA<float> pointCloudSoA;
+        getParallelDepthImageToPointCloudProcessor<MaskedFrame, PointCloud3DSoA<float>>(
+                depthAttributes, screenRange, pool, tiles)(frame3d, pointCloudSoA);
+        expectEqual(pointCloudSoA, expected);
+    }
+}
+
+TEST(GetDepthImageToPointCloudProcessorTest, ParallelConversionAppends)
+{
+    DepthFrameAttributes depthAttributes{{5, 5},
+                                         {0.0f, 10.0f},
+                                         45.0f,
+                                         45.0f};
+    ScreenRangeDummy screenRange;
+    WorkerPool pool{2u};
+    const std::vector<float> frame3d(25u, 5.0f);
+    const auto processor = getParallelDepthImageToPointCloudProcessor<std::vector<float>>(
+            depthAttributes, screenRange, pool);
+
+    PointCloud3D<float> pointCloud;
+    processor(frame3d, pointCloud);
+    processor(frame3d, pointCloud);
+    ASSERT_EQ(pointCloud.size(), 50u);
+    for(auto axis = 0u; axis < 3u; ++axis)
+    {
+        EXPECT_EQ(pointCloud[7u][axis], pointCloud[32u][axis]);
+    }
+
+    processor({}, pointCloud);
+    EXPECT_EQ(pointCloud.size(), 50u);
+}
+
+} // namespace lidar_viewer::tests::units
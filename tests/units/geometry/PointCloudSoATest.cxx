@@ -0,0 +1,175 @@
+#include "lidar_viewer/geometry/types/PointCloudSoA.h"
+#include "lidar_viewer/geometry/types/OctreeFromPointCloud.h"
+#include "lidar_viewer/geometry/functions/DownSample.h"
+#include "lidar_viewer/geometry/functions/GetDepthImageToPointCloudProcessor.h"
+#include "lidar_viewer/geometry/functions/Utilities.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace lidar_viewer::tests::units
+{
+
+using namespace geometry::types;
+using namespace geometry::functions;
+
+namespace
+{
+
+PointCloud3D<float> randomPointCloud(std::size_t size)
+{
+    std::mt19937 generator{42u};
+    std::uniform_real_distribution<float> distribution{-1.f, 1.f};
+    PointCloud3D<float> pointCloud;
+    for(std::size_t i = 0u; i < size; ++i)
+    {
+        pointCloud.emplace_back(Point3D<float>{{distribution(generator), distribution(generator),
+                                                distribution(generator)}});
+    }
+    return pointCloud;
+}
+
+void expectEqual(const Point3D<float>& point, const Point3D<float>& expected)
+{
+    for(std::size_t i = 0u; i < 3u; ++i)
+    {
+        EXPECT_FLOAT_EQ(point[i], expected[i]);
+    }
+}
+
+} // namespace
+
+TEST(PointCloudSoATest, ConvertsBothWays)
+{
+    const auto pointCloud = randomPointCloud(13u);
+    const PointCloud3DSoA<float> soa{pointCloud};
+    ASSERT_EQ(soa.size(), pointCloud.size());
+    for(std::size_t i = 0u; i < pointCloud.size(); ++i)
+    {
+        ASSERT_FLOAT_EQ(soa.channel(0u)[i], pointCloud[i][0]);
+        ASSERT_FLOAT_EQ(soa.channel(2u)[i], pointCloud[i][2]);
+        expectEqual(soa[i], pointCloud[i]);
+    }
+    const auto converted = soa.toPointCloud();
+    ASSERT_EQ(converted.size(), pointCloud.size());
+    for(std::size_t i = 0u; i < pointCloud.size(); ++i)
+    {
+        expectEqual(converted[i], pointCloud[i]);
+    }
+}
+
+TEST(PointCloudSoATest, ChannelsAligned)
+{
+    PointCloud3DSoA<float> soa{randomPointCloud(5u)};
+    for(std::size_t i = 0u; i < 3u; ++i)
+    {
+        ASSERT_EQ(reinterpret_cast<std::uintptr_t>(soa.channel(i).data()) % 64u, 0u);
+    }
+}
+
+TEST(PointCloudSoATest, AttributesFollowPoints)
+{
+    PointCloud3DSoA<float> soa{randomPointCloud(3u)};
+    const auto intensity = soa.addAttribute();
+    ASSERT_EQ(soa.attributeCount(), 1u);
+    ASSERT_EQ(soa.attribute(intensity).size(), 3u);
+    soa.attribute(intensity)[1u] = 7.f;
+    soa.emplace_back(Point3D<float>{{1.f, 2.f, 3.f}});
+    ASSERT_EQ(soa.attribute(intensity).size(), 4u);
+    ASSERT_FLOAT_EQ(soa.attribute(intensity)[1u], 7.f);
+    ASSERT_FLOAT_EQ(soa.attribute(intensity)[3u], 0.f);
+    soa.clear();
+    ASSERT_TRUE(soa.empty());
+    ASSERT_EQ(soa.attributeCount(), 1u);
+    ASSERT_TRUE(soa.attribute(intensity).empty());
+}
+
+TEST(PointCloudSoATest, SubviewSharesChannels)
+{
+    const PointCloud3DSoA<float> soa{randomPointCloud(10u)};
+    const auto view = soa.view().subview(4u, 3u);
+    ASSERT_EQ(view.size(), 3u);
+    ASSERT_EQ(view.channel(1u).data(), soa.channel(1u).data() + 4u);
+    expectEqual(view[2u], soa[6u]);
+}
+
+TEST(PointCloudSoATest, BoundingBoxMatchesPoints)
+{
+    for(const auto size : {1u, 7u, 8u, 1001u})
+    {
+        SCOPED_TRACE(size);
+        const auto pointCloud = randomPointCloud(size);
+        const auto expected = calculateBoundingBoxFromPointCloud(pointCloud);
+        const auto result = calculateBoundingBoxFromPointCloud(PointCloud3DSoA<float>{pointCloud});
+        expectEqual(result.hi, expected.hi);
+        expectEqual(result.lo, expected.lo);
+    }
+    const auto empty = calculateBoundingBoxFromPointCloud(PointCloud3DSoA<float>{});
+    expectEqual(empty.hi, Point3D<float>{{0.f, 0.f, 0.f}});
+}
+
+TEST(PointCloudSoATest, DownSampleMatchesPoints)
+{
+    const auto pointCloud = randomPointCloud(2000u);
+    const auto expected = downSample(pointCloud, 0.25f);
+    const auto result = downSample(PointCloud3DSoA<float>{pointCloud}, 0.25f);
+    ASSERT_EQ(result.size(), expected.size());
+    for(std::size_t i = 0u; i < expected.size(); ++i)
+    {
+        expectEqual(result[i], expected[i]);
+    }
+    ASSERT_TRUE(downSample(PointCloud3DSoA<float>{randomPointCloud(6u)}, 0.25f).empty());
+}
+
+TEST(PointCloudSoATest, OctreeMatchesPoints)
+{
+    const auto pointCloud = randomPointCloud(300u);
+    const PointCloud3DSoA<float> soa{pointCloud};
+    OctreeFromPointCloud<Point3D<float>> expected{pointCloud, 4u};
+    OctreeFromPointCloud<Point3D<float>, PointCloud3DSoA<float>> octree{soa, 4u};
+
+    std::vector<Indices> expectedLeaves;
+    for(const auto node : expected)
+    {
+        if(!node)
+        {
+            break ;
+        }
+        expectedLeaves.push_back(node->getContainer());
+    }
+    std::vector<Indices> leaves;
+    for(const auto node : octree)
+    {
+        if(!node)
+        {
+            break ;
+        }
+        leaves.push_back(node->getContainer());
+    }
+    ASSERT_EQ(leaves, expectedLeaves);
+}
+
+TEST(PointCloudSoATest, DepthImageConvertedIntoChannels)
+{
+    std::vector<uint16_t> depthImage(160u * 60u);
+    for(std::size_t i = 0u; i < depthImage.size(); ++i)
+    {
+        depthImage[i] = static_cast<uint16_t>(i % 3100u);
+    }
+    const DepthFrameAttributes attributes{{160u, 60u}, {51u, 3000u}, 60.f, 32.5f};
+    ScreenRangeGl screenRange{};
+    PointCloud3D<float> expected;
+    depthImageToPointCloud(depthImage, attributes, screenRange, expected);
+    PointCloud3DSoA<float> result;
+    depthImageToPointCloud(depthImage, attributes, screenRange, result);
+    ASSERT_EQ(result.size(), expected.size());
+    for(std::size_t i = 0u; i < expected.size(); ++i)
+    {
+        expectEqual(result[i], expected[i]);
+    }
+}
+
+} // namespace lidar_viewer::tests::units
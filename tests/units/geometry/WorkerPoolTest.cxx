@@ -0,0 +1,130 @@
+#include "lidar_viewer/geometry/types/WorkerPool.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace lidar_viewer::tests::units
+{
+
+using geometry::types::WorkerPool;
+
+TEST(WorkerPoolTest, EveryTaskRunOnce)
+{
+    WorkerPool pool{4u};
+    EXPECT_EQ(pool.size(), 4u);
+
+    std::vector<std::atomic<uint32_t>> runs(1000u);
+    pool.run(runs.size(), [&runs](std::size_t index)
+    {
+        runs[index].fetch_add(1u);
+    });
+    for(const auto& run : runs)
+    {
+        EXPECT_EQ(run.load(), 1u);
+    }
+}
+
+TEST(WorkerPoolTest, SingleThreadRunsOnCaller)
+{
+    WorkerPool pool{0u};
+    EXPECT_EQ(pool.size(), 1u);
+
+    std::set<std::thread::id> threads;
+    pool.run(16u, [&threads](std::size_t)
+    {
+        threads.insert(std::this_thread::get_id());
+    });
+    ASSERT_EQ(threads.size(), 1u);
+    EXPECT_EQ(*threads.begin(), std::this_thread::get_id());
+}
+
+TEST(WorkerPoolTest, TasksSpreadOverThreads)
+{
+    WorkerPool pool{3u};
+
+    std::mutex mutex;
+    std::set<std::thread::id> threads;
+    std::atomic<uint32_t> waiting{0u};
+    // every task waits for the others, so each of them runs on a thread of its own
+    pool.run(3u, [&](std::size_t)
+    {
+        {
+            std::lock_guard lGuard{mutex};
+            threads.insert(std::this_thread::get_id());
+        }
+        waiting.fetch_add(1u);
+        while(waiting.load() < 3u)
+        {
+            std::this_thread::yield();
+        }
+    });
+    EXPECT_EQ(threads.size(), 3u);
+}
+
+TEST(WorkerPoolTest, FailureRethrownAfterRemainingTasks)
+{
+    WorkerPool pool{2u};
+
+    std::atomic<uint32_t> runs{0u};
+    EXPECT_THROW(pool.run(10u, [&runs](std::size_t index)
+    {
+        runs.fetch_add(1u);
+        if(index == 3u)
+        {
+            throw std::runtime_error{"task failed"};
+        }
+    }), std::runtime_error);
+    EXPECT_EQ(runs.load(), 10u);
+
+    // the pool keeps running jobs
+    runs.store(0u);
+    pool.run(10u, [&runs](std::size_t)
+    {
+        runs.fetch_add(1u);
+    });
+    EXPECT_EQ(runs.load(), 10u);
+}
+
+TEST(WorkerPoolTest, ConsecutiveJobsDoNotOverlap)
+{
+    WorkerPool pool{4u};
+
+    for(auto job = 0u; job < 2000u; ++job)
+    {
+        std::atomic<uint32_t> runs{0u};
+        pool.run(job % 7u, [&runs](std::size_t)
+        {
+            runs.fetch_add(1u);
+        });
+        ASSERT_EQ(runs.load(), job % 7u);
+    }
+}
+
+TEST(WorkerPoolTest, JobsStartedAtOnceRunInTurn)
+{
+    WorkerPool pool{3u};
+
+    std::atomic<uint32_t> runs{0u};
+    const auto startJobs = [&pool, &runs]()
+    {
+        for(auto job = 0u; job < 200u; ++job)
+        {
+            pool.run(5u, [&runs](std::size_t)
+            {
+                runs.fetch_add(1u);
+            });
+        }
+    };
+    std::thread other{startJobs};
+    startJobs();
+    other.join();
+    EXPECT_EQ(runs.load(), 2u * 200u * 5u);
+}
+
+} // namespace lidar_viewer::tests::units
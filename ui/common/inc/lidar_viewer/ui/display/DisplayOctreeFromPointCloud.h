@@ -1,15 +1,9 @@
 #ifndef LIDAR_VIEWER_DISPLAYOCTREEFROMPOINTCLOUD_H
 #define LIDAR_VIEWER_DISPLAYOCTREEFROMPOINTCLOUD_H
 
+#include "lidar_viewer/dev/CygLidarD1Fwd.h"
 #include "lidar_viewer/ui/drawing/DrawingFunctions.h"
 
-namespace lidar_viewer::dev
-{
-
-class CygLidarD1;
-
-}
-
 namespace lidar_viewer::ui::display
 {
 
@@ -7,6 +7,8 @@
 #include "lidar_viewer/geometry/types/ScreenRanges.h"
 #include "lidar_viewer/geometry/functions/Utilities.h"
 
+#include <bit>
+
 namespace lidar_viewer::ui
 {
 using MapGlFloat3 = std::array<float, 3>;
@@ -26,10 +28,10 @@ bool displayFlatDepthImage(const dev::CygLidarD1* lidar, const lidar_viewer::ui:
         return false;
     }
 
-    constexpr geometry::types::UintRange depthRange        = {51u, 3000u};
+    constexpr geometry::types::UintRange depthRange        = {dev::CygLidarD1::DEPTH_RANGE_3D.first,
+                                                              dev::CygLidarD1::DEPTH_RANGE_3D.second};
 
-    constexpr geometry::types::DepthFrameAttributes depthFrameAttributes{dev::CygLidarD1::get3dFrameWindow(),
-                                                                         depthRange, 60.f, 32.5f};
+    constexpr auto depthFrameAttributes = geometry::types::sensorDepthFrameAttributes<dev::CygLidarD1::Sensor>(depthRange);
 
     constexpr std::pair<float, float> glFullScreenRangeX    {-1.f, 1.f};
     constexpr auto bUpperNormGlFullScreenRangeX = glFullScreenRangeX.second - glFullScreenRangeX.first;
@@ -54,17 +56,17 @@ bool displayFlatDepthImage(const dev::CygLidarD1* lidar, const lidar_viewer::ui:
     constexpr auto rScalar = ( ( depthRange.second / 2u ) - 1u ) * 255u;
     constexpr auto bScalar = ( ( depthRange.first ) - 1u ) * 255u;
 
-    lidar->use3dPointCloud([&](const auto& pointCloud)
-    {
-    for ( auto y = 0u; y < depthFrameAttributes.frameResolution.second; ++y )
+    const auto pointCloud = lidar->latest3dPointCloud();
+    const auto& mask = pointCloud->validity.mask;
+    // depths were classified on arrival, only the valid ones are visited
+    for ( std::size_t word = 0u; word < mask.size(); ++word )
     {
-        for ( auto x = 0u; x < depthFrameAttributes.frameResolution.first; ++x )
+        for ( auto bits = mask[word]; bits != 0u; bits &= bits - 1u )
         {
-            const auto elementOfFrame = pointCloud[y*depthFrameAttributes.frameResolution.first + x];
-            // omit every point not fitting in range, even error frames
-            if((elementOfFrame > depthRange.second)
-               | (elementOfFrame < depthRange.first))
-                continue ;
+            const auto index = word * 64u + static_cast<std::size_t>(std::countr_zero(bits));
+            const auto x = index % depthFrameAttributes.frameResolution.first;
+            const auto y = index / depthFrameAttributes.frameResolution.first;
+            const auto elementOfFrame = (*pointCloud)[index];
 
             MapGlUByte3 rgbValues{
                     valueToRGBByte<uint8_t>(gScalar, elementOfFrame),
@@ -83,7 +85,6 @@ bool displayFlatDepthImage(const dev::CygLidarD1* lidar, const lidar_viewer::ui:
             drawPoint(point, rgbValues);
         }
     }
-    });
     return true;
 }
 
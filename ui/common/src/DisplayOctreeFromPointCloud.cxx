@@ -4,6 +4,7 @@
 #include "lidar_viewer/geometry/types/Point.h"
 #include "lidar_viewer/geometry/types/Box.h"
 #include "lidar_viewer/geometry/types/PointCloud.h"
+#include "lidar_viewer/geometry/types/PointCloudSoA.h"
 #include "lidar_viewer/geometry/types/OctreeFromPointCloud.h"
 #include "lidar_viewer/geometry/functions/Utilities.h"
 #include "lidar_viewer/geometry/functions/DownSample.h"
@@ -20,12 +21,13 @@ using Box3D = lidar_viewer::geometry::types::Box<lidar_viewer::geometry::types::
 bool displayOctreeFromPointCloud(const dev::CygLidarD1* lidar, lidar_viewer::ui::drawing::DrawCubeColorFloatArr drawCube
                                                                 , lidar_viewer::ui::drawing::DrawPointColorFloatArr drawPoint)
 {
-    using geometry::types::PointCloud3D;
+    using geometry::types::Point3D;
+    using geometry::types::PointCloud3DSoA;
     using geometry::types::OctreeFromPointCloud;
     using geometry::functions::downSample;
     using geometry::functions::calculateBoundingBoxFromPointCloud;
     using geometry::functions::getDepthImageToPointCloudProcessor;
-    using DepthImage3D = dev::CygLidarD1::PointCloud3D;
+    using DepthImage3D = dev::CygLidarD1::ClassifiedPointCloud3D;
     if(!lidar)
     {
         return false;
@@ -37,19 +39,29 @@ bool displayOctreeFromPointCloud(const dev::CygLidarD1* lidar, lidar_viewer::ui:
 
     constexpr geometry::types::UintRange depthRange        = {0u, 3000u};
 
-    constexpr geometry::types::DepthFrameAttributes depthFrameAttributes{dev::CygLidarD1::get3dFrameWindow(),
-                                                        depthRange, 60.f, 32.5f};
+    constexpr auto depthFrameAttributes = geometry::types::sensorDepthFrameAttributes<dev::CygLidarD1::Sensor>(depthRange);
 
     geometry::types::ScreenRangeGl glScreenRange{};
 
-    auto conversionFunction = getDepthImageToPointCloudProcessor<DepthImage3D>(depthFrameAttributes, glScreenRange);
-    PointCloud3D<float> pointCloudV;
-    lidar->use3dPointCloudWithArgs(conversionFunction, pointCloudV);
+    // rays of the pixels computed once, every frame is converted into the same buffer without allocating
+    static const auto conversionFunction = getDepthImageToPointCloudProcessor<DepthImage3D, PointCloud3DSoA<float>>(
+            depthFrameAttributes, glScreenRange);
+    // converted once per received point cloud, drawn on every call, bounds and voxels are computed channel by channel
+    thread_local std::pair<const dev::CygLidarD1*, uint64_t> converted{nullptr, 0u};
+    thread_local PointCloud3DSoA<float> pointCloudV;
+    if(const auto depthImage = lidar->latest3dPointCloud();
+            converted != std::pair{lidar, depthImage->stamp.sequence})
+    {
+        pointCloudV.clear();
+        conversionFunction(*depthImage, pointCloudV);
+        converted = {lidar, depthImage->stamp.sequence};
+    }
 
     const auto pcDownSampled = downSample(pointCloudV, 0.13);
 
-    for(auto point : pointCloudV)
+    for(std::size_t i = 0u; i < pointCloudV.size(); ++i)
     {
+        const auto point = pointCloudV[i];
 //        MapGlUByte3 pointColor{255, 255, 255};
 //        glColor3ubv( pointColor.data() );
         drawPoint(point, {1.f, 1.f, 1.f});
@@ -58,7 +70,7 @@ bool displayOctreeFromPointCloud(const dev::CygLidarD1* lidar, lidar_viewer::ui:
     {
         return true;
     }
-    OctreeFromPointCloud octree{pointCloudV, 32};
+    OctreeFromPointCloud<Point3D<float>, PointCloud3DSoA<float>> octree{pointCloudV, 32};
 
     for(const auto node : octree)
     {
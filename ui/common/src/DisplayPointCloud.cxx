@@ -18,7 +18,7 @@ bool displayPointCloud3D(const dev::CygLidarD1* lidar, lidar_viewer::ui::drawing
     using geometry::types::PointCloud3D;
     using geometry::functions::calculateBoundingBoxFromPointCloud;
     using geometry::functions::getDepthImageToPointCloudProcessor;
-    using DepthImage3D = dev::CygLidarD1::PointCloud3D;
+    using DepthImage3D = dev::CygLidarD1::ClassifiedPointCloud3D;
     if(!lidar)
     {
         return false;
@@ -30,14 +30,23 @@ bool displayPointCloud3D(const dev::CygLidarD1* lidar, lidar_viewer::ui::drawing
 
     constexpr geometry::types::UintRange depthRange        = {51u, 3000u};
 
-    constexpr geometry::types::DepthFrameAttributes depthFrameAttributes{dev::CygLidarD1::get3dFrameWindow(),
-                                                                         depthRange, 60.f, 32.5f};
+    constexpr auto depthFrameAttributes = geometry::types::sensorDepthFrameAttributes<dev::CygLidarD1::Sensor>(depthRange);
 
     geometry::types::ScreenRangeGl glScreenRange{};
 
-    auto conversionFunction = getDepthImageToPointCloudProcessor<DepthImage3D>(depthFrameAttributes, glScreenRange);
-    PointCloud3D<float> pointCloudV;
-    lidar->use3dPointCloudWithArgs(conversionFunction, pointCloudV);
+    // rays of the pixels computed once, every frame is converted into the same buffer without allocating
+    static const auto conversionFunction = getDepthImageToPointCloudProcessor<DepthImage3D>(depthFrameAttributes,
+                                                                                           glScreenRange);
+    // converted once per received point cloud, drawn on every call
+    thread_local std::pair<const dev::CygLidarD1*, uint64_t> converted{nullptr, 0u};
+    thread_local PointCloud3D<float> pointCloudV;
+    if(const auto depthImage = lidar->latest3dPointCloud();
+            converted != std::pair{lidar, depthImage->stamp.sequence})
+    {
+        pointCloudV.clear();
+        conversionFunction(*depthImage, pointCloudV);
+        converted = {lidar, depthImage->stamp.sequence};
+    }
 
     for(auto point : pointCloudV)
     {
@@ -1,4 +1,5 @@
 #include "lidar_viewer/dev/SerialPort.h"
+#include "lidar_viewer/dev/UringStream.h"
 #include "lidar_viewer/dev/CygLidarD1.h"
 #include "lidar_viewer/dev/FrameWriter.h"
 #include "lidar_viewer/dev/PointCloudReader.h"
@@ -9,7 +10,8 @@
 #include "lidar_viewer/ui/drawing/gl2/DrawPoint.h"
 #include "lidar_viewer/ui/drawing/gl2/DrawString.h"
 #include "lidar_viewer/ui/display/DisplayPointCloud.h"
-#include "lidar_viewer/dev/BinaryFile.h"
+#include "lidar_viewer/dev/RecordingReader.h"
+#include "lidar_viewer/dev/RecordingWriter.h"
 #include "lidar_viewer/ui/display/DisplayOctreeFromPointCloud.h"
 #include "lidar_viewer/ui/display/DisplayFlatDepthImage.h"
 #include "lidar_viewer/ui/display/DisplayStatistics.h"
@@ -48,7 +50,9 @@ std::string usageString()
             "\n\t\t-c frequencyChannel {0-15} "
             "\n\t\t-p pulseDuration (for 3D) { 0-10000 } [in ms] "
             "\n\t\t-s sensitivity {0-255}"
-            "\n\t\t-o outputFileName file to write frames to"s;
+            "\n\t\t-o outputFileName file to write frames to"
+            "\n\t\t-e codec for outputFileName { raw, rvl, delta } "
+            "\n\t\t-r replaySpeed for inputFileName { 1 - original cadence, N - N times faster, 0 - as fast as possible }"s;
     return usageStr;
 }
 
@@ -73,6 +77,8 @@ int main(int argc, char** argv)
     std::string deviceName {};
     std::string inputFileName {};
     std::string outputFileName {};
+    double replaySpeed {1.};
+    auto outputCodec {codec::CodecId::TemporalRvl};
     IoStream input{};
     IoStream output{};
     ViewManagerGl viewer{{
@@ -82,7 +88,7 @@ int main(int argc, char** argv)
                           .h = 600u
                   }};
 
-    while( ( opt = ::getopt(argc, argv, "d:f:b:l:m:c:p:s:o:h")) != -1 )
+    while( ( opt = ::getopt(argc, argv, "d:f:b:l:m:c:p:s:o:e:r:h")) != -1 )
     {
         switch ( opt )
         {
@@ -172,6 +178,31 @@ int main(int argc, char** argv)
                 outputFileName = std::string { optarg };
                 break;
             }
+            case 'e':
+            {
+                try
+                {
+                    outputCodec = codec::codecIdFromName(optarg);
+                }
+                catch(const std::exception& e)
+                {
+                    std::cerr << e.what() << "\n" << usageString() << "\n";
+                    return EXIT_FAILURE;
+                }
+                break;
+            }
+            case 'r':
+            {
+                char* endptr = nullptr;
+                replaySpeed = ::strtod(optarg, &endptr);
+                if(endptr == optarg || replaySpeed < 0.)
+                {
+                    std::cerr << "Failed to parse the option for replay speed\n"
+                                                    << usageString() << "\n";
+                    return EXIT_FAILURE;
+                }
+                break;
+            }
             case 'h':
                 std::cout << usageString() << "\n";
                 return 0;
@@ -192,12 +223,12 @@ int main(int argc, char** argv)
         if(!deviceName.empty())
         {
             std::cout << "Opening device: " << deviceName << "\n";
-            input.createAndOpen<SerialPort>(deviceName, speedForSerial);
+            input.createAndOpen<UringStream>(deviceName, speedForSerial);
         }
         else if(!inputFileName.empty())
         {
             std::cout << "Opening file: " << inputFileName << "\n";
-            input.createAndOpen<BinaryFile>(inputFileName);
+            input.createAndOpen<RecordingReader>(inputFileName, ReplayClock{replaySpeed});
         }
         else
         {
@@ -209,8 +240,9 @@ int main(int argc, char** argv)
         CygLidarD1 lidar{input};
         if(!deviceName.empty())
         {
-            lidar.configure(lidarCfg);
+            // device info is read right away, before replies to the configuration arrive
             lidar.printDeviceInfo();
+            lidar.configure(lidarCfg);
             lidar.run(mode);
         }
 
@@ -220,7 +252,7 @@ int main(int argc, char** argv)
 
         if(!outputFileName.empty())
         {
-            output.createAndOpen<BinaryFile>(outputFileName);
+            output.createAndOpen<RecordingWriter>(outputFileName, recording::makeRecordingInfo(lidarCfg, mode), outputCodec);
         }
         FrameWriter frameWriter{lidar, output};
         if(!outputFileName.empty())